@@ -45,11 +45,45 @@ from PySAGA import saga_api
 # numpy...
 #________________________________________________________________________________
 
+#################################################################################
+#________________________________________________________________________________
+def Vector_To_NumPy(Vector):
+    '''
+    Returns a numpy array sharing the memory of a saga_api.CSG_Vector object.
+    The array is only valid as long as the vector exists and is not resized.
+    '''
+    try:
+        import numpy
+    except:
+        return None
+
+    if Vector.Get_Size() < 1:
+        return numpy.empty(0, float)
+
+    return numpy.asarray(Vector)
+
+
+#################################################################################
+#________________________________________________________________________________
+def NumPy_To_Vector(Array):
+    '''
+    Creates a saga_api.CSG_Vector object from a one dimensional numpy array.
+    '''
+    Vector = saga_api.CSG_Vector(len(Array))
+
+    if len(Array) > 0:
+        Vector_To_NumPy(Vector)[:] = Array
+
+    return Vector
+
+
 #################################################################################
 #________________________________________________________________________________
 def Table_To_NumPy(Table, yFields=[], xField=None):
     '''
-    Converts a saga_api.CSG_Grid object into a list of numpy arrays.
+    Converts fields of a saga_api.CSG_Table object (or of a point cloud)
+    into a list of numpy arrays. The first array holds the values of xField
+    or, if not specified, the record numbers.
     '''
     try:
         import numpy
@@ -69,25 +103,57 @@ def Table_To_NumPy(Table, yFields=[], xField=None):
     else:
         xField = -1
 
-    Fields = []; Data = [numpy.empty(Table.Get_Count(), float)]
+    def Get_Field(Field):
+        Values = saga_api.CSG_Vector()
+        if Table.Get_Field_Values(Field, Values):
+            return numpy.array(Vector_To_NumPy(Values))
+        return numpy.empty(0, float)
+
+    Data = [numpy.arange(Table.Get_Count(), dtype=float) if xField < 0 else Get_Field(xField)]
 
     for i in range(0, len(yFields)):
         try:
             yFields[i] = int(yFields[i])
             if yFields[i] >= 0 and yFields[i] < Table.Get_Field_Count():
-                Fields.append(yFields[i]); Data.append(numpy.empty(Table.Get_Count()))
+                Data.append(Get_Field(yFields[i]))
         except:
             yFields[i] = -1
 
-    for i in range(0, Table.Get_Count()):
-        Record = Table.Get_Record(i)
-        Data[0][i] = i if xField < 0 else Record.asDouble(xField)
-        for j in range(1, len(Data)):
-            Data[j][i] = Record.asDouble(Fields[j - 1])
-
     return Data
 
 
+#################################################################################
+#________________________________________________________________________________
+def NumPy_To_Table(Array, Table, Field):
+    '''
+    Writes the values of a one dimensional numpy array to the field of a
+    saga_api.CSG_Table object (or of a point cloud). The array needs to
+    have one value for each record.
+    '''
+    return Table.Set_Field_Values(Field, NumPy_To_Vector(Array))
+
+
+#################################################################################
+#________________________________________________________________________________
+def Grid_As_NumPy(Grid):
+    '''
+    Returns a numpy array sharing the memory of a saga_api.CSG_Grid object
+    or None, if the grid is cached or a bit grid. The array has the grid's
+    data type, holds unscaled values and its first row is the northern one.
+    Changes are written directly to the grid, so call Grid.Set_Modified()
+    afterwards. The array is only valid as long as the grid exists.
+    '''
+    try:
+        import numpy
+    except:
+        return None
+
+    if not Grid.Get_Data():
+        return None
+
+    return numpy.flipud(numpy.asarray(Grid))
+
+
 #################################################################################
 #________________________________________________________________________________
 def Grid_To_NumPy(Grid):
@@ -104,16 +170,43 @@ def Grid_To_NumPy(Grid):
         numpy.linspace(Grid.Get_YMin(), Grid.Get_YMax(), Grid.Get_NY())
     )
 
-    Z = X + Y
+    Z = Grid_As_NumPy(Grid)
 
-    for y in range(0, Grid.Get_NY()):
-        yy = Grid.Get_NY() - 1 - y
-        for x in range(0, Grid.Get_NX()):
-            Z[y, x] = Grid.asDouble(x, yy)
+    if Z is not None and not Grid.is_Scaled():
+        Z = numpy.array(Z, float)
+    else:
+        Values = saga_api.CSG_Vector()
+        Grid.Get_Values(Values)
+        Z = numpy.flipud(Vector_To_NumPy(Values).reshape(Grid.Get_NY(), Grid.Get_NX())).copy()
 
     return X, Y, Z
 
 
+#################################################################################
+#________________________________________________________________________________
+def NumPy_To_Grid(Array, Grid):
+    '''
+    Writes a two dimensional numpy array, with its first row being the
+    northern one, to a saga_api.CSG_Grid object of the same dimension.
+    '''
+    try:
+        import numpy
+    except:
+        return False
+
+    if Array.shape != (Grid.Get_NY(), Grid.Get_NX()):
+        return False
+
+    Z = Grid_As_NumPy(Grid)
+
+    if Z is not None and not Grid.is_Scaled():
+        numpy.copyto(Z, Array, casting='unsafe')
+        Grid.Set_Modified()
+        return True
+
+    return Grid.Set_Values(NumPy_To_Vector(numpy.flipud(Array).ravel()))
+
+
 #################################################################################
 #
 #________________________________________________________________________________
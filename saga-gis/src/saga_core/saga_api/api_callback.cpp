@@ -53,6 +53,8 @@
 #include <wx/stdpaths.h>
 #include <wx/app.h>
 
+#include <chrono>
+
 #include "api_core.h"
 #include "grid.h"
 #include "parameters.h"
@@ -204,14 +206,43 @@ int			SG_UI_Progress_Reset(void)
 	return( Locked );
 }
 
+//---------------------------------------------------------
+// The user interface must only be accessed by the main thread.
+// Worker threads of a parallel region get the state last
+// reported to the main thread instead, so that progress and
+// cancellation can be queried from within parallel loops.
+//---------------------------------------------------------
+std::atomic<bool>	gSG_UI_Process_bOkay(true);
+
+#define SG_UI_PROGRESS_INTERVAL	std::chrono::milliseconds(40)	// minimum time between two progress callbacks
+
+//---------------------------------------------------------
+inline bool	SG_UI_Process_is_Worker(void)
+{
+	return( SG_OMP_Get_Thread_Num() > 0 );
+}
+
+//---------------------------------------------------------
+inline bool	SG_UI_Process_Set_State(bool bOkay)
+{
+	gSG_UI_Process_bOkay = bOkay;
+
+	return( bOkay );
+}
+
 //---------------------------------------------------------
 bool		SG_UI_Process_Get_Okay(bool bBlink)
 {
+	if( SG_UI_Process_is_Worker() )
+	{
+		return( gSG_UI_Process_bOkay );
+	}
+
 	if( gSG_UI_Callback )
 	{
 		CSG_UI_Parameter p1(gSG_UI_Progress_Lock == 0 && bBlink), p2;
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_GET_OKAY, p1, p2) != 0 );
+		return( SG_UI_Process_Set_State(gSG_UI_Callback(CALLBACK_PROCESS_GET_OKAY, p1, p2) != 0) );
 	}
 
 	if( gSG_UI_Progress_Lock == 0 && bBlink )
@@ -229,8 +260,15 @@ bool		SG_UI_Process_Get_Okay(bool bBlink)
 //---------------------------------------------------------
 bool		SG_UI_Process_Set_Okay(bool bOkay)
 {
+	if( SG_UI_Process_is_Worker() )
+	{
+		return( true );
+	}
+
 	if( gSG_UI_Progress_Lock == 0 && gSG_UI_Callback )
 	{
+		SG_UI_Process_Set_State(bOkay);
+
 		CSG_UI_Parameter p1(bOkay), p2;
 
 		return( gSG_UI_Callback(CALLBACK_PROCESS_SET_OKAY, p1, p2) != 0 );
@@ -242,6 +280,11 @@ bool		SG_UI_Process_Set_Okay(bool bOkay)
 //---------------------------------------------------------
 bool		SG_UI_Process_Set_Busy(bool bOn, const CSG_String &Message)
 {
+	if( SG_UI_Process_is_Worker() )
+	{
+		return( true );
+	}
+
 	if( gSG_UI_Callback )
 	{
 		CSG_UI_Parameter p1(bOn), p2(Message);
@@ -267,16 +310,38 @@ bool		SG_UI_Process_Set_Progress(sLong Position, sLong Range)
 //---------------------------------------------------------
 bool		SG_UI_Process_Set_Progress(double Position, double Range)
 {
+	if( SG_UI_Process_is_Worker() )
+	{
+		return( gSG_UI_Process_bOkay );
+	}
+
+	//-----------------------------------------------------
+	if( Position > 0. && Position < Range )	// always report start and end, throttle anything in between
+	{
+		static std::chrono::steady_clock::time_point Last;
+
+		std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+
+		if( Now - Last < SG_UI_PROGRESS_INTERVAL )
+		{
+			return( gSG_UI_Process_bOkay );
+		}
+
+		Last = Now;
+	}
+
+	//-----------------------------------------------------
 	if( gSG_UI_Progress_Lock > 0 )
 	{
 		return( SG_UI_Process_Get_Okay() );
 	}
 
+	//-----------------------------------------------------
 	if( gSG_UI_Callback )
 	{
 		CSG_UI_Parameter p1(Position), p2(Range);
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_SET_PROGRESS, p1, p2) != 0 );
+		return( SG_UI_Process_Set_State(gSG_UI_Callback(CALLBACK_PROCESS_SET_PROGRESS, p1, p2) != 0) );
 	}
 
 	//-----------------------------------------------------
@@ -339,6 +404,58 @@ void		SG_UI_Process_Set_Text(const CSG_String &Text)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Progress::CSG_Progress(void)
+	: m_bOkay(true), m_Position(0)
+{
+	Create(0);
+}
+
+//---------------------------------------------------------
+CSG_Progress::CSG_Progress(sLong Range, bool bShow)
+	: m_bOkay(true), m_Position(0)
+{
+	Create(Range, bShow);
+}
+
+//---------------------------------------------------------
+bool CSG_Progress::Create(sLong Range, bool bShow)
+{
+	m_bShow    = bShow;
+	m_Range    = Range;
+	m_Position = 0;
+	m_bOkay    = SG_UI_Process_Get_Okay();
+
+	return( m_bOkay );
+}
+
+//---------------------------------------------------------
+/**
+  * Adds the number of finished steps. Can be called by any
+  * thread. Returns false, if execution has been stopped.
+*/
+//---------------------------------------------------------
+bool CSG_Progress::Step(sLong Steps)
+{
+	sLong Position = (m_Position += Steps);
+
+	if( m_bOkay && !SG_UI_Process_is_Worker() )
+	{
+		m_bOkay = m_bShow
+			? SG_UI_Process_Set_Progress((double)Position, (double)m_Range)
+			: SG_UI_Process_Get_Okay();
+	}
+
+	return( m_bOkay && gSG_UI_Process_bOkay );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
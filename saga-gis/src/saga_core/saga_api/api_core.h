@@ -111,6 +111,7 @@
 #include <string.h>
 #include <wchar.h>
 #include <string>
+#include <atomic>
 
 #endif	// #ifdef SWIG
 
@@ -1648,6 +1649,52 @@ SAGA_API_DLL_EXPORT void					SG_UI_Process_Set_Text		(const CSG_String &Text);
 
 SAGA_API_DLL_EXPORT bool					SG_UI_Stop_Execution		(bool bDialog);
 
+//---------------------------------------------------------
+#ifndef SWIG
+
+/**
+  * CSG_Progress is a thread-safe progress counter for parallel
+  * loops. Any thread may add finished steps, only the main thread
+  * reports to the user interface, and cancellation can be checked
+  * by all threads:
+  * \code
+  * CSG_Progress Progress(Get_NY());
+  *
+  * #pragma omp parallel for schedule(dynamic)
+  * for(int y=0; y<Get_NY(); y++) { if( Progress.Step() ) { ... } }
+  * \endcode
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Progress
+{
+public:
+	CSG_Progress(void);
+	CSG_Progress(sLong Range, bool bShow = true);
+
+	bool						Create			(sLong Range, bool bShow = true);
+
+	bool						Step			(sLong Steps = 1);
+
+	bool						is_Okay			(void)	const	{	return( m_bOkay );		}
+
+	sLong						Get_Range		(void)	const	{	return( m_Range );		}
+	sLong						Get_Position	(void)	const	{	return( m_Position );	}
+
+
+private:
+
+	bool						m_bShow;
+
+	sLong						m_Range;
+
+	std::atomic<bool>			m_bOkay;
+
+	std::atomic<sLong>			m_Position;
+
+};
+
+#endif // #ifndef SWIG
+
 SAGA_API_DLL_EXPORT void					SG_UI_Dlg_Message			(const CSG_String &Message, const CSG_String &Caption);
 SAGA_API_DLL_EXPORT bool					SG_UI_Dlg_Continue			(const CSG_String &Message, const CSG_String &Caption);
 SAGA_API_DLL_EXPORT int						SG_UI_Dlg_Error				(const CSG_String &Message, const CSG_String &Caption);
@@ -1694,6 +1741,52 @@ SAGA_API_DLL_EXPORT CSG_String				SG_UI_Get_Application_Path	(bool bPathOnly = f
 SAGA_API_DLL_EXPORT CSG_String				SG_UI_Get_Application_Name	(void);
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Profiler						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Profiler_Region records wall and CPU time, the growth of
+  * the process' peak memory and the bytes read and written by
+  * the process between its construction and destruction, as
+  * well as the process' peak memory at its end, if profiling
+  * has been enabled with SG_Profiler_Set_Enabled(). Regions
+  * might be nested and are used for tool execution, data
+  * loading and saving, but can also mark any named section
+  * inside a tool:
+  * \code
+  * CSG_Profiler_Region Region("region", "Flow Accumulation");
+  * \endcode
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Profiler_Region
+{
+public:
+	CSG_Profiler_Region(const CSG_String &Category, const CSG_String &Name, const CSG_String &Info = "");
+	virtual ~CSG_Profiler_Region(void);
+
+
+private:
+
+	bool						m_bActive;
+
+	double						m_Wall, m_CPU, m_Memory;
+
+	sLong						m_Read, m_Written;
+
+	CSG_String					m_Category, m_Name, m_Info;
+
+};
+
+//---------------------------------------------------------
+SAGA_API_DLL_EXPORT bool					SG_Profiler_Set_Enabled		(bool bOn);
+SAGA_API_DLL_EXPORT bool					SG_Profiler_is_Enabled		(void);
+SAGA_API_DLL_EXPORT bool					SG_Profiler_Save			(const CSG_String &File);
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //                     Environment                       //
@@ -0,0 +1,365 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    api_profiler.cpp                   //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#ifdef _SAGA_MSW
+	#define PSAPI_VERSION 2
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+#include "api_core.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+struct SSG_Profiler_Event
+{
+	CSG_String	Category, Name, Info;
+
+	int			Thread;
+
+	double		Start, Duration, CPU, Memory, Memory_Growth;
+
+	sLong		Read, Written;
+};
+
+//---------------------------------------------------------
+static bool								gSG_Profiler_bEnabled	= false;
+
+static std::mutex						gSG_Profiler_Mutex;
+
+static std::vector<SSG_Profiler_Event>	gSG_Profiler_Events;
+
+static const std::chrono::steady_clock::time_point	gSG_Profiler_Start	= std::chrono::steady_clock::now();
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** Wall time since library initialisation in microseconds. */
+//---------------------------------------------------------
+static double	SG_Profiler_Get_Wall	(void)
+{
+	return( (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - gSG_Profiler_Start).count() );
+}
+
+//---------------------------------------------------------
+/** User and system time consumed by all threads of the process in milliseconds. */
+//---------------------------------------------------------
+static double	SG_Profiler_Get_CPU		(void)
+{
+#ifdef _SAGA_MSW
+	FILETIME Creation, Exit, Kernel, User;
+
+	if( GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User) )
+	{
+		ULARGE_INTEGER k, u;
+
+		k.LowPart = Kernel.dwLowDateTime; k.HighPart = Kernel.dwHighDateTime;
+		u.LowPart = User  .dwLowDateTime; u.HighPart = User  .dwHighDateTime;
+
+		return( (k.QuadPart + u.QuadPart) / 10000. );	// 100 nanosecond intervals
+	}
+#else
+	struct rusage Usage;
+
+	if( getrusage(RUSAGE_SELF, &Usage) == 0 )
+	{
+		return( 1000. * (Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec) + (Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) / 1000. );
+	}
+#endif
+
+	return( 0. );
+}
+
+//---------------------------------------------------------
+/** Peak resident memory of the process since its start in megabytes. */
+//---------------------------------------------------------
+static double	SG_Profiler_Get_Memory	(void)
+{
+#ifdef _SAGA_MSW
+	PROCESS_MEMORY_COUNTERS Counters;
+
+	if( GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)) )
+	{
+		return( Counters.PeakWorkingSetSize / (1024. * 1024.) );
+	}
+#else
+	struct rusage Usage;
+
+	if( getrusage(RUSAGE_SELF, &Usage) == 0 )
+	{
+	#ifdef __APPLE__
+		return( Usage.ru_maxrss / (1024. * 1024.) );	// bytes
+	#else
+		return( Usage.ru_maxrss / 1024. );	// kilobytes
+	#endif
+	}
+#endif
+
+	return( 0. );
+}
+
+//---------------------------------------------------------
+/** Bytes read and written by the process so far. */
+//---------------------------------------------------------
+static void		SG_Profiler_Get_IO		(sLong &Read, sLong &Written)
+{
+	Read = Written = 0;
+
+#ifdef _SAGA_MSW
+	IO_COUNTERS Counters;
+
+	if( GetProcessIoCounters(GetCurrentProcess(), &Counters) )
+	{
+		Read    = (sLong)Counters.ReadTransferCount ;
+		Written = (sLong)Counters.WriteTransferCount;
+	}
+#else
+	FILE *Stream = fopen("/proc/self/io", "r");	// not available on all systems
+
+	if( Stream )
+	{
+		char Key[64]; long long Value;
+
+		while( fscanf(Stream, "%63s %lld", Key, &Value) == 2 )
+		{
+			if( !strcmp(Key, "rchar:") ) { Read    = (sLong)Value; }
+			if( !strcmp(Key, "wchar:") ) { Written = (sLong)Value; }
+		}
+
+		fclose(Stream);
+	}
+#endif
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool	SG_Profiler_Set_Enabled	(bool bOn)
+{
+	gSG_Profiler_bEnabled = bOn;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool	SG_Profiler_is_Enabled	(void)
+{
+	return( gSG_Profiler_bEnabled );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Profiler_Region::CSG_Profiler_Region(const CSG_String &Category, const CSG_String &Name, const CSG_String &Info)
+{
+	if( (m_bActive = gSG_Profiler_bEnabled) == true )
+	{
+		m_Category = Category;
+		m_Name     = Name;
+		m_Info     = Info;
+
+		SG_Profiler_Get_IO(m_Read, m_Written);
+
+		m_Memory   = SG_Profiler_Get_Memory();
+		m_CPU      = SG_Profiler_Get_CPU ();
+		m_Wall     = SG_Profiler_Get_Wall();
+	}
+}
+
+//---------------------------------------------------------
+CSG_Profiler_Region::~CSG_Profiler_Region(void)
+{
+	if( m_bActive )
+	{
+		SSG_Profiler_Event Event;
+
+		Event.Duration = SG_Profiler_Get_Wall() - m_Wall;
+		Event.CPU      = SG_Profiler_Get_CPU () - m_CPU;
+		Event.Memory   = SG_Profiler_Get_Memory();
+		Event.Memory_Growth = Event.Memory - m_Memory;	// operating systems only report the process' peak, not that of a time span
+
+		SG_Profiler_Get_IO(Event.Read, Event.Written);
+
+		Event.Read    -= m_Read;
+		Event.Written -= m_Written;
+		Event.Start    = m_Wall;
+		Event.Thread   = SG_OMP_Get_Thread_Num();
+		Event.Category = m_Category;
+		Event.Name     = m_Name;
+		Event.Info     = m_Info;
+
+		std::lock_guard<std::mutex> Lock(gSG_Profiler_Mutex);
+
+		gSG_Profiler_Events.push_back(Event);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static CSG_String	SG_Profiler_JSON_String	(const CSG_String &String)
+{
+	CSG_String JSON("\"");
+
+	for(size_t i=0; i<String.Length(); i++)
+	{
+		SG_Char c = String[i];
+
+		switch( c )
+		{
+		case '\"': JSON += "\\\""; break;
+		case '\\': JSON += "\\\\"; break;
+		case '\n': JSON += "\\n" ; break;
+		case '\r': JSON += "\\r" ; break;
+		case '\t': JSON += "\\t" ; break;
+		default  : if( c >= 0x20 ) { JSON += c; } break;
+		}
+	}
+
+	return( JSON + "\"" );
+}
+
+//---------------------------------------------------------
+/**
+  * Writes all recorded regions in the Chrome trace event format
+  * (to be viewed with chrome://tracing or Perfetto), followed by
+  * a per region summary of call counts, times and transfers.
+*/
+//---------------------------------------------------------
+bool	SG_Profiler_Save	(const CSG_String &File)
+{
+	CSG_File Stream;
+
+	if( !Stream.Open(File, SG_FILE_W, false, SG_FILE_ENCODING_UTF8) )
+	{
+		return( false );
+	}
+
+	std::lock_guard<std::mutex> Lock(gSG_Profiler_Mutex);
+
+	//-----------------------------------------------------
+	Stream.Write(CSG_String("{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": ["));
+
+	for(size_t i=0; i<gSG_Profiler_Events.size(); i++)
+	{
+		const SSG_Profiler_Event &e = gSG_Profiler_Events[i];
+
+		Stream.Write(CSG_String::Format("%s\n{\"name\": %s, \"cat\": %s, \"ph\": \"X\", \"ts\": %.0f, \"dur\": %.0f, \"pid\": 1, \"tid\": %d, \"args\": "
+			"{\"cpu_ms\": %.3f, \"process_peak_memory_mb\": %.1f, \"peak_memory_growth_mb\": %.1f, \"bytes_read\": %lld, \"bytes_written\": %lld, \"info\": %s}}",
+			i > 0 ? SG_T(",") : SG_T(""), SG_Profiler_JSON_String(e.Name).c_str(), SG_Profiler_JSON_String(e.Category).c_str(),
+			e.Start, e.Duration, e.Thread, e.CPU, e.Memory, e.Memory_Growth, (long long)e.Read, (long long)e.Written, SG_Profiler_JSON_String(e.Info).c_str()
+		));
+	}
+
+	//-----------------------------------------------------
+	Stream.Write(CSG_String("\n],\n\"summary\": ["));
+
+	std::vector<bool> bDone(gSG_Profiler_Events.size(), false);
+
+	for(size_t i=0, n=0; i<gSG_Profiler_Events.size(); i++)
+	{
+		if( !bDone[i] )
+		{
+			const SSG_Profiler_Event &e = gSG_Profiler_Events[i];
+
+			int Count = 0; double Wall = 0., CPU = 0., Memory = 0., Growth = 0.; sLong Read = 0, Written = 0;
+
+			for(size_t j=i; j<gSG_Profiler_Events.size(); j++)
+			{
+				const SSG_Profiler_Event &f = gSG_Profiler_Events[j];
+
+				if( !bDone[j] && !f.Category.Cmp(e.Category) && !f.Name.Cmp(e.Name) )
+				{
+					bDone[j] = true; Count++; Wall += f.Duration; CPU += f.CPU; Read += f.Read; Written += f.Written;
+
+					if( Memory < f.Memory        ) { Memory = f.Memory       ; }
+					if( Growth < f.Memory_Growth ) { Growth = f.Memory_Growth; }
+				}
+			}
+
+			Stream.Write(CSG_String::Format("%s\n{\"name\": %s, \"cat\": %s, \"count\": %d, \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"process_peak_memory_mb\": %.1f, \"peak_memory_growth_mb\": %.1f, \"bytes_read\": %lld, \"bytes_written\": %lld}",
+				n++ > 0 ? SG_T(",") : SG_T(""), SG_Profiler_JSON_String(e.Name).c_str(), SG_Profiler_JSON_String(e.Category).c_str(),
+				Count, Wall / 1000., CPU, Memory, Growth, (long long)Read, (long long)Written
+			));
+		}
+	}
+
+	Stream.Write(CSG_String("\n]\n}\n"));
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
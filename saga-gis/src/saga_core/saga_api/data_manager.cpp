@@ -359,6 +359,7 @@ CSG_Data_Object * CSG_Data_Manager::Add(const CSG_String &File, TSG_Data_Object_
 		}
 
 		if(	SG_File_Cmp_Extension(File, "sg-grd-z")
+		||	SG_File_Cmp_Extension(File, "sg-grd-t")
 		||	SG_File_Cmp_Extension(File, "sg-grd"  )
 		||	SG_File_Cmp_Extension(File, "sgrd"    )
 		||	SG_File_Cmp_Extension(File, "dgm"     )
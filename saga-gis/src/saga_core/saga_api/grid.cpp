@@ -207,7 +207,10 @@ void CSG_Grid::_On_Construction(void)
 	m_Values       = NULL;
 
 	m_Cache_Stream = NULL;
+	m_Cache_Map    = NULL;
+	m_Cache_Source = NULL;
 	m_Cache_Offset = 0;
+	m_Cache_Budget = -1;
 	m_Cache_bSwap  = false;
 	m_Cache_bFlip  = false;
 
@@ -215,6 +218,7 @@ void CSG_Grid::_On_Construction(void)
 	m_zOffset      = 0.;
 
 	m_Index        = NULL;
+	m_bIndex32     = false;
 
 	m_pOwner       = NULL;
 
@@ -310,6 +314,8 @@ bool CSG_Grid::Create(const char       *File, TSG_Data_Type Type, bool bCached,
 bool CSG_Grid::Create(const wchar_t    *File, TSG_Data_Type Type, bool bCached, bool bLoadData) { return( Create(CSG_String(File), Type, bCached, bLoadData) ); }
 bool CSG_Grid::Create(const CSG_String &File, TSG_Data_Type Type, bool bCached, bool bLoadData)
 {
+	CSG_Profiler_Region Profile("load", File, "grid");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s: %s...", _TL("Loading grid"), File.c_str()), true);
@@ -317,6 +323,7 @@ bool CSG_Grid::Create(const CSG_String &File, TSG_Data_Type Type, bool bCached,
 	m_Type = Type;
 
 	if( _Load_PGSQL     (File, bCached, bLoadData)
+	||  _Load_Tiled     (File, bCached, bLoadData)
 	||  _Load_Native    (File, bCached, bLoadData)
 	||  _Load_Compressed(File, bCached, bLoadData)
 	||  _Load_Surfer    (File, bCached, bLoadData)
@@ -513,6 +520,62 @@ bool CSG_Grid::Set_Row(int y, const CSG_Vector &Values)
 	return( false );
 }
 
+//---------------------------------------------------------
+/**
+  * Copies all cell values row by row, starting with the lower
+  * row (y = 0), into the vector Values of size Get_NCells().
+*/
+bool CSG_Grid::Get_Values(CSG_Vector &Values, bool bScaled)	const
+{
+	if( !is_Valid() || !Values.Create(Get_NCells()) )
+	{
+		return( false );
+	}
+
+	double	*pValues	= Values.Get_Data();
+
+	#pragma omp parallel for if(!is_Cached())	// cached grids are read serially
+	for(int y=0; y<Get_NY(); y++)
+	{
+		double	*pRow	= pValues + (sLong)y * Get_NX();
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			pRow[x]	= asDouble(x, y, bScaled);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Sets all cell values from the vector Values, which is expected
+  * to be ordered like the output of Get_Values().
+*/
+bool CSG_Grid::Set_Values(const CSG_Vector &Values, bool bScaled)
+{
+	if( !is_Valid() || Values.Get_Size() != Get_NCells() )
+	{
+		return( false );
+	}
+
+	const double	*pValues	= Values.Get_Data();
+
+	#pragma omp parallel for if(!is_Cached())
+	for(int y=0; y<Get_NY(); y++)
+	{
+		const double	*pRow	= pValues + (sLong)y * Get_NX();
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			Set_Value(x, y, pRow[x], bScaled);
+		}
+	}
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1247,164 +1310,276 @@ bool CSG_Grid::Get_Histogram(const CSG_Rect &rWorld, CSG_Histogram &Histogram, s
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_Grid::_Set_Index(void)
+// The index is built with a parallel, stable LSD radix sort
+// (8 bits per pass) on (key, cell) pairs. Keys are the order
+// preserving bit patterns of the unscaled cell values, no-data
+// cells get the largest possible key and so end up behind all
+// valid cells without an extra partitioning pass. Passes, in
+// which all keys share the same digit, are skipped.
+//---------------------------------------------------------
+static inline void	SG_Grid_Index_Key	(DWORD &Key, double Value, bool bNoData, bool bReverse)
 {
-	//-----------------------------------------------------
-	if( m_Index == NULL && (m_Index = (sLong *)SG_Malloc((size_t)Get_NCells() * sizeof(sLong))) == NULL )
+	if( bNoData )
 	{
-		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
+		Key	= ~(DWORD)0; return;
+	}
 
-		return( false );
+	float	f	= (float)Value;	memcpy(&Key, &f, sizeof(Key));
+
+	Key	= Key & ((DWORD)1 << 31) ? ~Key : Key | ((DWORD)1 << 31);
+
+	if( bReverse ) { Key = ~Key; }
+}
+
+//---------------------------------------------------------
+static inline void	SG_Grid_Index_Key	(uLong &Key, double Value, bool bNoData, bool bReverse)
+{
+	if( bNoData )
+	{
+		Key	= ~(uLong)0; return;
 	}
 
-	//-----------------------------------------------------
-	const sLong	M	= 7;
+	memcpy(&Key, &Value, sizeof(Key));
 
-	sLong	i, j, k, l, ir, n, *istack, jstack, nstack, indxt, itemp, nData;
-	double	a;
+	Key	= Key & ((uLong)1 << 63) ? ~Key : Key | ((uLong)1 << 63);
 
-	//-----------------------------------------------------
-	SG_UI_Process_Set_Text(CSG_String::Format("%s: %s", _TL("Create index"), Get_Name()));
+	if( bReverse ) { Key = ~Key; }
+}
 
-	for(i=0, j=0, nData=Get_NCells(); i<Get_NCells(); i++)
+//---------------------------------------------------------
+static inline double	SG_Grid_Index_Value	(const void *pRow, TSG_Data_Type Type, int x)
+{
+	switch( Type )
 	{
-		if( is_NoData(i) )
-		{
-			m_Index[--nData]	= i;
-		}
-		else // if( !is_NoData(i) )
-		{
-			m_Index[j++]	= i;
-		}
+	case SG_DATATYPE_Byte  : return( (double)((const BYTE   *)pRow)[x] );
+	case SG_DATATYPE_Char  : return( (double)((const char   *)pRow)[x] );
+	case SG_DATATYPE_Word  : return( (double)((const WORD   *)pRow)[x] );
+	case SG_DATATYPE_Short : return( (double)((const short  *)pRow)[x] );
+	case SG_DATATYPE_DWord : return( (double)((const DWORD  *)pRow)[x] );
+	case SG_DATATYPE_Int   : return( (double)((const int    *)pRow)[x] );
+	case SG_DATATYPE_Long  : return( (double)((const sLong  *)pRow)[x] );
+	case SG_DATATYPE_ULong : return( (double)((const uLong  *)pRow)[x] );
+	case SG_DATATYPE_Float : return( (double)((const float  *)pRow)[x] );
+	case SG_DATATYPE_Double: return( (double)((const double *)pRow)[x] );
+	default                : return( 0. );
 	}
+}
 
-	if( nData <= 0 )
+//---------------------------------------------------------
+template <typename K, typename I>
+static bool	SG_Grid_Index_Sort	(K *Keys, I *Index, sLong nCells)
+{
+	K	*Keys_Tmp	= (K *)SG_Malloc((size_t)nCells * sizeof(K));
+	I	*Index_Tmp	= (I *)SG_Malloc((size_t)nCells * sizeof(I));
+
+	if( !Keys_Tmp || !Index_Tmp )
 	{
-	//	SG_FREE_SAFE(m_Index);
+		SG_FREE_SAFE(Keys_Tmp); SG_FREE_SAFE(Index_Tmp);
+
+		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
 
-		return( false );	// nothing to do
+		return( false );
 	}
 
 	//-----------------------------------------------------
-	l		= 0;
-	n		= 0;
-	ir		= nData - 1;
+	int	nChunks	= SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Array_sLong	Counts(nChunks * 256);	sLong	*Count	= Counts.Get_Array();
+
+	K	*pKeys	= Keys, *pKeys_Tmp	= Keys_Tmp;
+	I	*pIndex	= Index, *pIndex_Tmp = Index_Tmp;
 
-	nstack	= 64;
-	istack	= (sLong *)SG_Malloc((size_t)nstack * sizeof(sLong));
-	jstack	= 0;
+	bool	bResult	= true;
 
-	for(;;)
+	for(int Pass=0, nPasses=(int)sizeof(K); bResult && Pass<nPasses; Pass++)
 	{
-		if( ir - l < M )
+		if( !SG_UI_Process_Set_Progress(Pass, nPasses) )
 		{
-			if( !SG_UI_Process_Set_Progress((double)(n += M - 1), (double)nData) )
-			{
-				SG_FREE_SAFE(istack);
-				SG_FREE_SAFE(m_Index);
+			SG_UI_Msg_Add_Error(_TL("index creation stopped by user"));
 
-				SG_UI_Msg_Add_Error(_TL("index creation stopped by user"));
-				SG_UI_Process_Set_Ready();
+			bResult	= false; break;
+		}
 
-				return( false );
-			}
+		int	Shift	= 8 * Pass;
+
+		memset(Count, 0, nChunks * 256 * sizeof(sLong));
+
+		#pragma omp parallel for schedule(static, 1)
+		for(int iChunk=0; iChunk<nChunks; iChunk++)
+		{
+			sLong	*c	= Count + 256 * iChunk;
 
-			for(j=l+1; j<=ir; j++)
+			for(sLong i=nCells*iChunk/nChunks, n=nCells*(iChunk+1)/nChunks; i<n; i++)
 			{
-				indxt	= m_Index[j];
-				a		= asDouble(indxt);
+				c[(pKeys[i] >> Shift) & 0xFF]++;
+			}
+		}
 
-				for(i=j-1; i>=0; i--)
-				{
-					if( asDouble(m_Index[i]) <= a )
-					{
-						break;
-					}
+		//-------------------------------------------------
+		bool	bSkip	= false;	sLong	Offset	= 0;
 
-					m_Index[i + 1]	= m_Index[i];
-				}
+		for(int Digit=0; Digit<256; Digit++)
+		{
+			sLong	nDigit	= 0;
+
+			for(int iChunk=0; iChunk<nChunks; iChunk++)
+			{
+				sLong	n	= Count[256 * iChunk + Digit];
 
-				m_Index[i + 1]	= indxt;
+				Count[256 * iChunk + Digit]	= Offset + nDigit;	nDigit	+= n;
 			}
 
-			if( jstack == 0 )
+			if( nDigit == nCells )
 			{
-				break;
+				bSkip	= true;	break;	// all keys share this digit
 			}
 
-			ir		= istack[jstack--];
-			l		= istack[jstack--];
+			Offset	+= nDigit;
+		}
+
+		if( bSkip )
+		{
+			continue;
 		}
 
 		//-------------------------------------------------
-		else
+		#pragma omp parallel for schedule(static, 1)
+		for(int iChunk=0; iChunk<nChunks; iChunk++)
 		{
-			#define SORT_SWAP(a,b)	{itemp=(a);(a)=(b);(b)=itemp;}
+			sLong	*c	= Count + 256 * iChunk;
 
-			k		= (l + ir) >> 1;
+			for(sLong i=nCells*iChunk/nChunks, n=nCells*(iChunk+1)/nChunks; i<n; i++)
+			{
+				sLong	j	= c[(pKeys[i] >> Shift) & 0xFF]++;
 
-			SORT_SWAP(m_Index[k], m_Index[l + 1]);
+				pKeys_Tmp [j]	= pKeys [i];
+				pIndex_Tmp[j]	= pIndex[i];
+			}
+		}
 
-			if( asDouble( m_Index[l + 1]) > asDouble(m_Index[ir]) )
-				SORT_SWAP(m_Index[l + 1],            m_Index[ir]);
+		K	*k	= pKeys ; pKeys  = pKeys_Tmp ; pKeys_Tmp  = k;
+		I	*p	= pIndex; pIndex = pIndex_Tmp; pIndex_Tmp = p;
+	}
 
-			if( asDouble( m_Index[l    ]) > asDouble(m_Index[ir]) )
-				SORT_SWAP(m_Index[l    ],            m_Index[ir]);
+	//-----------------------------------------------------
+	if( bResult && pIndex != Index )
+	{
+		memcpy(Index, pIndex, (size_t)nCells * sizeof(I));
+	}
 
-			if( asDouble( m_Index[l + 1]) > asDouble(m_Index[l ]) )
-				SORT_SWAP(m_Index[l + 1],            m_Index[l ]);
+	SG_Free(Keys_Tmp);
+	SG_Free(Index_Tmp);
 
-			i		= l + 1;
-			j		= ir;
-			indxt	= m_Index[l];
-			a		= asDouble(indxt);
+	return( bResult );
+}
 
-			for(;;)
-			{
-				do	i++;	while(asDouble(m_Index[i]) < a);
-				do	j--;	while(asDouble(m_Index[j]) > a);
+//---------------------------------------------------------
+template <typename K, typename I>
+static bool	SG_Grid_Index_Create	(const CSG_Grid &Grid, I *Index, sLong &nData)
+{
+	sLong	nCells	= Grid.Get_NCells();
 
-				if( j < i )
-				{
-					break;
-				}
+	K	*Keys	= (K *)SG_Malloc((size_t)nCells * sizeof(K));
 
-				SORT_SWAP(m_Index[i], m_Index[j]);
-			}
+	if( !Keys )
+	{
+		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
 
-			#undef SORT_SWAP
+		return( false );
+	}
 
-			m_Index[l]	= m_Index[j];
-			m_Index[j]	= indxt;
-			jstack		+= 2;
+	bool	bReverse	= Grid.Get_Scaling() < 0.;	// a negative scaling factor reverses the order of unscaled values
 
-			if( jstack >= nstack )
-			{
-				nstack	+= 64;
-				istack	= (sLong *)SG_Realloc(istack, (size_t)nstack * sizeof(int));
-			}
+	sLong	n	= 0;
 
-			if( ir - i + 1 >= j - l )
-			{
-				istack[jstack]		= ir;
-				istack[jstack - 1]	= i;
-				ir					= j - 1;
-			}
-			else
+	#pragma omp parallel for reduction(+:n) if(!Grid.is_Cached())	// no concurrent reads from a file cache
+	for(int y=0; y<Grid.Get_NY(); y++)
+	{
+		const void	*pRow	= Grid.Get_Row_Data(y);
+
+		for(int x=0; x<Grid.Get_NX(); x++)
+		{
+			sLong	i		= x + (sLong)y * Grid.Get_NX();
+			double	Value	= pRow ? SG_Grid_Index_Value(pRow, Grid.Get_Type(), x) : Grid.asDouble(x, y, false);
+			bool	bNoData	= Grid.is_NoData_Value(Value);
+
+			SG_Grid_Index_Key(Keys[i], Value, bNoData, bReverse);
+
+			Index[i]	= (I)i;
+
+			if( !bNoData )
 			{
-				istack[jstack]		= j - 1;
-				istack[jstack - 1]	= l;
-				l					= i;
+				n++;
 			}
 		}
 	}
 
+	bool	bResult	= (nData = n) > 0 && SG_Grid_Index_Sort(Keys, Index, nCells);
+
+	SG_Free(Keys);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Set_Index(void)
+{
+	bool	bIndex32	= Get_NCells() <= (sLong)0xFFFFFFFF;	// 32 bit indices halve the memory footprint
+
+	if( m_Index && bIndex32 != m_bIndex32 )
+	{
+		SG_FREE_SAFE(m_Index);
+	}
+
+	m_bIndex32	= bIndex32;
+
+	//-----------------------------------------------------
+	if( m_Index == NULL && (m_Index = SG_Malloc((size_t)Get_NCells() * (m_bIndex32 ? sizeof(DWORD) : sizeof(sLong)))) == NULL )
+	{
+		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
-	SG_Free(istack);
+	SG_UI_Process_Set_Text(CSG_String::Format("%s: %s", _TL("Create index"), Get_Name()));
+
+	bool	bKey32;	// values of these types are represented exactly by single precision floating point keys
+
+	switch( m_Type )
+	{
+	case SG_DATATYPE_Bit  :
+	case SG_DATATYPE_Byte :
+	case SG_DATATYPE_Char :
+	case SG_DATATYPE_Word :
+	case SG_DATATYPE_Short:
+	case SG_DATATYPE_Float:	bKey32	= true ; break;
+	default               :	bKey32	= false; break;
+	}
+
+	sLong	nData	= -1;	bool	bResult;
+
+	if( m_bIndex32 )
+	{
+		bResult	= bKey32
+			? SG_Grid_Index_Create<DWORD, DWORD>(*this, (DWORD *)m_Index, nData)
+			: SG_Grid_Index_Create<uLong, DWORD>(*this, (DWORD *)m_Index, nData);
+	}
+	else
+	{
+		bResult	= bKey32
+			? SG_Grid_Index_Create<DWORD, sLong>(*this, (sLong *)m_Index, nData)
+			: SG_Grid_Index_Create<uLong, sLong>(*this, (sLong *)m_Index, nData);
+	}
 
 	SG_UI_Process_Set_Ready();
 
-	return( true );
+	if( !bResult && nData != 0 )	// cancelled or memory allocation failed, but keep the index of a no-data only grid
+	{
+		SG_FREE_SAFE(m_Index);
+	}
+
+	return( bResult );
 }
 
 
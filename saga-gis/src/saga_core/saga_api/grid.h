@@ -92,7 +92,8 @@ typedef enum
 	GRID_FILE_FORMAT_Binary,
 	GRID_FILE_FORMAT_ASCII,
 	GRID_FILE_FORMAT_Compressed,
-	GRID_FILE_FORMAT_GeoTIFF
+	GRID_FILE_FORMAT_GeoTIFF,
+	GRID_FILE_FORMAT_Tiled
 }
 TSG_Grid_File_Format;
 
@@ -458,6 +459,69 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					CSG_Grid_File_Tiled					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_File_Tiled gives access to SAGA's tiled grid file
+  * format (*.sg-grd-t). The cell values are stored in square
+  * tiles, each of which is compressed independently and can be
+  * located through an offset table in the file header. Tiles are
+  * decompressed on demand and in parallel, so that windowed reads
+  * and file cached grids only touch the tiles they need.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_File_Tiled
+{
+public:
+	CSG_Grid_File_Tiled(void);
+	virtual ~CSG_Grid_File_Tiled(void);
+
+								CSG_Grid_File_Tiled		(const CSG_String &File);
+	bool						Open					(const CSG_String &File);
+	bool						Close					(void);
+
+	bool						is_Okay					(void)	const	{	return( m_pStream != NULL );	}
+
+	const CSG_Grid_File_Info &	Get_Info				(void)	const	{	return( m_Info );		}
+
+	int							Get_Tile_Size			(void)	const	{	return( m_Tile_Size );	}
+	int							Get_NX_Tiles			(void)	const	{	return( m_nx );			}
+	int							Get_NY_Tiles			(void)	const	{	return( m_ny );			}
+
+	sLong						Get_MetaData_Offset		(void)	const	{	return( m_Offsets.Get_Size() > 0 ? m_Offsets[m_Offsets.Get_Size() - 1] : -1 );	}
+
+	bool						Read_Tile				(int xTile, int yTile, CSG_Array &Values)	const;
+	bool						Read_Lines				(int yFirst, int nLines, void *Lines)		const;
+	bool						Read					(CSG_Grid &Grid, int xOffset = 0, int yOffset = 0)	const;
+
+	static bool					Save					(const CSG_Grid &Grid, CSG_File &Stream, int Tile_Size = 256);
+
+
+private:
+
+	bool						m_bSwap;
+
+	int							m_Tile_Size, m_nx, m_ny, m_nValueBytes;
+
+	CSG_Array_sLong				m_Offsets;
+
+	CSG_File					*m_pStream;
+
+	CSG_Grid_File_Info			m_Info;
+
+
+	void						_On_Construction		(void);
+
+	bool						_Get_Tile_Rect			(int xTile, int yTile, int &xa, int &ya, int &nx, int &ny)	const;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						CSG_Grid						 //
@@ -601,9 +665,12 @@ public:		///////////////////////////////////////////////
 	sLong							Get_Memory_Size			(void)		const	{	return( Get_NCells() * Get_nValueBytes() );	}
 	double							Get_Memory_Size_MB		(void)		const	{	return( (double)Get_Memory_Size() / N_MEGABYTE_BYTES );	}
 
-	bool							Set_Cache				(bool bOn);
+	bool							Set_Cache				(bool bOn, sLong Budget = -1);
 	bool							is_Cached				(void)		const	{	return( m_Cache_Stream != NULL );	}
 
+	bool							Set_Cache_Budget		(sLong nBytes);
+	sLong							Get_Cache_Budget		(void)		const;
+
 
 	//-----------------------------------------------------
 	// Operations...
@@ -663,7 +730,8 @@ public:		///////////////////////////////////////////////
 	{
 		if( Position >= 0 && Position < Get_NCells() && _Get_Index() )
 		{
-			Position	= m_Index[bDown ? Get_NCells() - Position - 1 : Position];
+			Position	= bDown ? Get_NCells() - Position - 1 : Position;
+			Position	= m_bIndex32 ? (sLong)((DWORD *)m_Index)[Position] : ((sLong *)m_Index)[Position];
 
 			if( !bCheckNoData || !is_NoData(Position) )
 			{
@@ -856,6 +924,13 @@ public:		///////////////////////////////////////////////
 	CSG_Vector					Get_Row					(int y)	const;
 	bool						Set_Row					(int y, const CSG_Vector &Values);
 
+	bool						Get_Values				(CSG_Vector &Values, bool bScaled = true)	const;
+	bool						Set_Values				(const CSG_Vector &Values, bool bScaled = true);
+
+	const void *				Get_Row_Data			(int y)	const;
+	void *						Get_Row_Data			(int y);
+	void *						Get_Data				(void)	const;
+
 
 //---------------------------------------------------------
 protected:	///////////////////////////////////////////////
@@ -868,18 +943,20 @@ protected:	///////////////////////////////////////////////
 //---------------------------------------------------------
 private:	///////////////////////////////////////////////
 
-	void						**m_Values;
+	void						**m_Values, *m_Index;
 
-	bool						m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip;
+	bool						m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip, m_bIndex32;
 
 	size_t						m_nBytes_Value, m_nBytes_Line;
 
-	sLong						*m_Index, m_Cache_Offset;
+	sLong						m_Cache_Offset, m_Cache_Budget;
 
 	double						m_zOffset, m_zScale;
 
 	FILE						*m_Cache_Stream;
 
+	void						*m_Cache_Map, *m_Cache_Source;
+
 	TSG_Data_Type				m_Type;
 
 	CSG_String					m_Unit, m_Cache_File;
@@ -923,8 +1000,16 @@ private:	///////////////////////////////////////////////
 	bool						_Cache_Create			(const CSG_String &File, TSG_Data_Type Data_Type, sLong Offset, bool bSwap, bool bFlip);
 	bool						_Cache_Create			(void);
 	bool						_Cache_Destroy			(bool bMemory_Restore);
+	bool						_Cache_Map_Create		(void);
+	void						_Cache_Map_Destroy		(void);
+	void						_Cache_Map_Set_Budget	(void);
+	char *						_Cache_Map_Get_Line		(int y)	const;
 	void						_Cache_Set_Value		(int x, int y, double Value);
 	double						_Cache_Get_Value		(int x, int y)	const;
+	bool						_Cache_Source_Create	(const CSG_String &File);
+	void						_Cache_Source_Destroy	(void);
+	bool						_Cache_Source_Detach	(void);
+	bool						_Cache_Source_Fill		(int y)	const;
 
 
 	//-----------------------------------------------------
@@ -941,6 +1026,9 @@ private:	///////////////////////////////////////////////
 	bool						_Load_Compressed		(const CSG_String &File, bool bCached, bool bLoadData);
 	bool						_Save_Compressed		(const CSG_String &File);
 
+	bool						_Load_Tiled				(const CSG_String &File, bool bCached, bool bLoadData);
+	bool						_Save_Tiled				(const CSG_String &File);
+
 	bool						_Load_Binary			(CSG_File &Stream, TSG_Data_Type File_Type, bool bFlip, bool bSwapBytes);
 	bool						_Save_Binary			(CSG_File &Stream, TSG_Data_Type File_Type, bool bFlip, bool bSwapBytes);
 	bool						_Load_ASCII				(CSG_File &Stream, bool bCached, bool bFlip = false);
@@ -976,6 +1064,242 @@ private:	///////////////////////////////////////////////
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					CSG_Grid_View						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_View provides row wise access to the values of a grid
+  * as contiguous arrays of type T. If the grid's data type equals T,
+  * no scaling needs to be applied and the row is held in memory
+  * (or is memory mapped) the returned pointer refers directly to the
+  * grid's row memory. Otherwise values are converted to and from an
+  * internal row buffer. The view keeps up to nRows buffered rows,
+  * so that e.g. a 3x3 neighbourhood can be accessed by requesting
+  * rows y - 1, y and y + 1. A view is not thread safe, create one
+  * view per thread or request rows outside of parallel regions.
+  * Rows returned for writing have to be committed with Set_Row().
+  * @see CSG_Grid
+*/
+//---------------------------------------------------------
+template <typename T> class CSG_Grid_View
+{
+public:
+
+	CSG_Grid_View(void)
+	{
+		m_pGrid = NULL; m_Buffer = NULL; m_Rows = NULL; m_nRows = 0;
+	}
+
+	CSG_Grid_View(CSG_Grid *pGrid, int nRows = 1, bool bScaled = true)
+	{
+		m_pGrid = NULL; m_Buffer = NULL; m_Rows = NULL; m_nRows = 0;
+
+		Create(pGrid, nRows, bScaled);
+	}
+
+	virtual ~CSG_Grid_View(void)	{	Destroy();	}
+
+	//-----------------------------------------------------
+	bool						Create			(CSG_Grid *pGrid, int nRows = 1, bool bScaled = true)
+	{
+		Destroy();
+
+		if( !pGrid || !pGrid->is_Valid() || nRows < 1 )
+		{
+			return( false );
+		}
+
+		m_pGrid		= pGrid;
+		m_nRows		= nRows;
+		m_bScaled	= bScaled && pGrid->is_Scaled();
+		m_bDirect	= pGrid->Get_Type() == _Get_Type((T *)NULL) && !m_bScaled;
+		m_Rows		= (int *)SG_Malloc(m_nRows * sizeof(int));
+		m_Buffer	= (T   *)SG_Malloc(m_nRows * pGrid->Get_NX() * sizeof(T));
+
+		for(int i=0; i<m_nRows; i++)
+		{
+			m_Rows[i]	= -1;
+		}
+
+		double	a	= m_bScaled ? pGrid->Get_Offset() + pGrid->Get_Scaling() * pGrid->Get_NoData_Value(false) : pGrid->Get_NoData_Value(false);
+		double	b	= m_bScaled ? pGrid->Get_Offset() + pGrid->Get_Scaling() * pGrid->Get_NoData_Value(true ) : pGrid->Get_NoData_Value(true );
+
+		m_NoData[0]	= a < b ? a : b;
+		m_NoData[1]	= a < b ? b : a;
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	void						Destroy			(void)
+	{
+		SG_FREE_SAFE(m_Buffer);
+		SG_FREE_SAFE(m_Rows  );
+
+		m_pGrid	= NULL; m_nRows = 0;
+	}
+
+	//-----------------------------------------------------
+	bool						is_Valid		(void)	const	{	return( m_pGrid != NULL );	}
+
+	/** Returns true if rows of a memory resident grid are accessed without copying. */
+	bool						is_Direct		(void)	const	{	return( m_bDirect && !m_pGrid->is_Cached() );	}
+
+	CSG_Grid *					Get_Grid		(void)	const	{	return( m_pGrid );			}
+	int							Get_NX			(void)	const	{	return( m_pGrid ? m_pGrid->Get_NX() : 0 );	}
+	int							Get_NY			(void)	const	{	return( m_pGrid ? m_pGrid->Get_NY() : 0 );	}
+
+	/** No-data value in the units of this view (scaled if the view is scaled). */
+	double						Get_NoData_Value(bool bUpper = false)	const	{	return( m_NoData[bUpper ? 1 : 0] );	}
+
+	bool						is_NoData		(double Value)	const
+	{
+		return( SG_is_NaN(Value) || (m_NoData[0] < m_NoData[1] ? m_NoData[0] <= Value && Value <= m_NoData[1] : Value == m_NoData[0]) );
+	}
+
+	//-----------------------------------------------------
+	/** Returns the values of row y for reading or NULL if y is not a valid row. */
+	const T *					Get_Row			(int y)	const
+	{
+		return( ((CSG_Grid_View<T> *)this)->_Get_Row(y, true, false) );
+	}
+
+	/** Returns the values of row y for writing. If bLoad is false the current values of a buffered row are not loaded. */
+	T *							Get_Row			(int y, bool bLoad)
+	{
+		return( _Get_Row(y, bLoad, true) );
+	}
+
+	/** Commits changes of row y, which has been requested before with Get_Row(y, bLoad). */
+	bool						Set_Row			(int y)
+	{
+		if( !m_pGrid || y < 0 || y >= m_pGrid->Get_NY() )
+		{
+			return( false );
+		}
+
+		if( !m_bDirect || m_pGrid->Get_Row_Data(y) == NULL )
+		{
+			int	i	= y % m_nRows;
+
+			if( m_Rows[i] != y )
+			{
+				return( false );
+			}
+
+			const T	*pRow	= m_Buffer + (size_t)i * m_pGrid->Get_NX();
+
+			for(int x=0; x<m_pGrid->Get_NX(); x++)
+			{
+				m_pGrid->Set_Value(x, y, (double)pRow[x], m_bScaled);
+			}
+		}
+
+		m_pGrid->Set_Modified();
+
+		return( true );
+	}
+
+
+private:
+
+	bool						m_bScaled, m_bDirect;
+
+	int							m_nRows, *m_Rows;
+
+	double						m_NoData[2];
+
+	T							*m_Buffer;
+
+	CSG_Grid					*m_pGrid;
+
+
+	//-----------------------------------------------------
+	static TSG_Data_Type		_Get_Type		(BYTE   *)	{	return( SG_DATATYPE_Byte   );	}
+	static TSG_Data_Type		_Get_Type		(char   *)	{	return( SG_DATATYPE_Char   );	}
+	static TSG_Data_Type		_Get_Type		(WORD   *)	{	return( SG_DATATYPE_Word   );	}
+	static TSG_Data_Type		_Get_Type		(short  *)	{	return( SG_DATATYPE_Short  );	}
+	static TSG_Data_Type		_Get_Type		(DWORD  *)	{	return( SG_DATATYPE_DWord  );	}
+	static TSG_Data_Type		_Get_Type		(int    *)	{	return( SG_DATATYPE_Int    );	}
+	static TSG_Data_Type		_Get_Type		(sLong  *)	{	return( SG_DATATYPE_Long   );	}
+	static TSG_Data_Type		_Get_Type		(uLong  *)	{	return( SG_DATATYPE_ULong  );	}
+	static TSG_Data_Type		_Get_Type		(float  *)	{	return( SG_DATATYPE_Float  );	}
+	static TSG_Data_Type		_Get_Type		(double *)	{	return( SG_DATATYPE_Double );	}
+
+	//-----------------------------------------------------
+	T *							_Get_Row		(int y, bool bLoad, bool bWrite)
+	{
+		if( !m_pGrid || y < 0 || y >= m_pGrid->Get_NY() )
+		{
+			return( NULL );
+		}
+
+		T	*pRow	= !m_bDirect ? NULL : bWrite ? (T *)m_pGrid->Get_Row_Data(y) : (T *)((const CSG_Grid *)m_pGrid)->Get_Row_Data(y);
+
+		if( pRow )
+		{
+			return( pRow );
+		}
+
+		int	i	= y % m_nRows;	pRow	= m_Buffer + (size_t)i * m_pGrid->Get_NX();
+
+		if( m_Rows[i] != y || !bLoad )
+		{
+			if( bLoad )
+			{
+				_Load(y, pRow);
+			}
+
+			m_Rows[i]	= y;
+		}
+
+		return( pRow );
+	}
+
+	//-----------------------------------------------------
+	template <typename S> void	_Convert		(const S *pData, T *pRow)	const
+	{
+		double	Scale	= m_pGrid->Get_Scaling(), Offset = m_pGrid->Get_Offset();
+
+		for(int x=0; x<m_pGrid->Get_NX(); x++)
+		{
+			pRow[x]	= (T)(m_bScaled ? Offset + Scale * (double)pData[x] : (double)pData[x]);
+		}
+	}
+
+	//-----------------------------------------------------
+	void						_Load			(int y, T *pRow)	const
+	{
+		const void	*pData	= ((const CSG_Grid *)m_pGrid)->Get_Row_Data(y);
+
+		if( pData ) switch( m_pGrid->Get_Type() )
+		{
+		case SG_DATATYPE_Byte  : _Convert((const BYTE   *)pData, pRow); return;
+		case SG_DATATYPE_Char  : _Convert((const char   *)pData, pRow); return;
+		case SG_DATATYPE_Word  : _Convert((const WORD   *)pData, pRow); return;
+		case SG_DATATYPE_Short : _Convert((const short  *)pData, pRow); return;
+		case SG_DATATYPE_DWord : _Convert((const DWORD  *)pData, pRow); return;
+		case SG_DATATYPE_Int   : _Convert((const int    *)pData, pRow); return;
+		case SG_DATATYPE_Long  : _Convert((const sLong  *)pData, pRow); return;
+		case SG_DATATYPE_ULong : _Convert((const uLong  *)pData, pRow); return;
+		case SG_DATATYPE_Float : _Convert((const float  *)pData, pRow); return;
+		case SG_DATATYPE_Double: _Convert((const double *)pData, pRow); return;
+		default: break;	// bit grids
+		}
+
+		for(int x=0; x<m_pGrid->Get_NX(); x++)	// converting fallback
+		{
+			pRow[x]	= (T)m_pGrid->asDouble(x, y, m_bScaled);
+		}
+	}
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						Functions						 //
@@ -1024,6 +1348,12 @@ SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Threshold_MB	(double nMegabytes);
 SAGA_API_DLL_EXPORT sLong			SG_Grid_Cache_Get_Threshold		(void);
 SAGA_API_DLL_EXPORT double			SG_Grid_Cache_Get_Threshold_MB	(void);
 
+/** Set the default amount of memory, which a file cached grid is allowed to keep resident. Zero means no limit. */
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Budget		(sLong nBytes);
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Budget_MB		(double nMegabytes);
+SAGA_API_DLL_EXPORT sLong			SG_Grid_Cache_Get_Budget		(void);
+SAGA_API_DLL_EXPORT double			SG_Grid_Cache_Get_Budget_MB		(void);
+
 //---------------------------------------------------------
 SAGA_API_DLL_EXPORT bool					SG_Grid_Set_File_Format_Default		(int Format);
 SAGA_API_DLL_EXPORT TSG_Grid_File_Format	SG_Grid_Get_File_Format_Default		(void);
@@ -1171,6 +1501,74 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Distance Transform					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Distance_Transform calculates for each cell of a grid
+  * system the exact euclidean distance to its nearest feature cell.
+  * It implements the separable, linear time algorithm of Meijster
+  * et al. (2000), which first scans all columns and then all rows,
+  * both in parallel. Besides the distance the position of the
+  * nearest feature cell is kept, which serves allocation and
+  * direction outputs. Memory needed is 8 bytes per cell.
+  *
+  * Meijster, A., Roerdink, J.B.T.M., Hesselink, W.H. (2000):
+  * A general algorithm for computing distance transforms in linear time.
+  * In: Mathematical Morphology and its Applications to Image and Signal
+  * Processing, Computational Imaging and Vision, 18, 331-340.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Distance_Transform
+{
+public:
+	CSG_Grid_Distance_Transform(void);
+	virtual ~CSG_Grid_Distance_Transform(void);
+
+								CSG_Grid_Distance_Transform	(const CSG_Grid_System &System);
+	bool						Create				(const CSG_Grid_System &System);
+
+	/** Uses all cells of pFeatures, that are not no-data, as features and executes the transform. */
+								CSG_Grid_Distance_Transform	(const CSG_Grid &Features);
+	bool						Create				(const CSG_Grid &Features);
+
+	bool						Destroy				(void);
+
+	const CSG_Grid_System &		Get_System			(void)	const	{	return( m_System );	}
+
+	/** Marks cell (x, y) as feature. Call Execute() after all features have been set. */
+	bool						Set_Feature			(int x, int y);
+	bool						is_Feature			(int x, int y)	const	{	return( Get_Nearest(x, y) == (sLong)y * m_System.Get_NX() + x );	}
+
+	bool						Execute				(void);
+	bool						is_Okay				(void)	const	{	return( m_bOkay );	}
+
+	/** Index (y * NX + x) of the nearest feature cell or -1, if there are no features. */
+	sLong						Get_Nearest			(int x, int y)	const;
+	bool						Get_Nearest			(int x, int y, int &xFeature, int &yFeature)	const;
+
+	/** Distance to the nearest feature cell in cells or -1, if there are no features. */
+	double						Get_Distance		(int x, int y)	const;
+
+	/** Distance to the nearest feature cell in map units or -1, if there are no features. */
+	double						Get_Map_Distance	(int x, int y)	const;
+
+
+private:
+
+	bool						m_bOkay;
+
+	CSG_Grid_System				m_System;
+
+	CSG_Array_Int				m_xNearest, m_yNearest;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
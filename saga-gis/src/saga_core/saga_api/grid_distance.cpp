@@ -0,0 +1,393 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   grid_distance.cpp                   //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define DT_COLUMN_BLOCK	64	// columns scanned together in the first phase, keeps row-wise memory access
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Distance_Transform::CSG_Grid_Distance_Transform(void)
+{
+	m_bOkay	= false;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Distance_Transform::CSG_Grid_Distance_Transform(const CSG_Grid_System &System)
+{
+	m_bOkay	= false;
+
+	Create(System);
+}
+
+bool CSG_Grid_Distance_Transform::Create(const CSG_Grid_System &System)
+{
+	Destroy();
+
+	if( !System.is_Valid() || !m_xNearest.Create(System.Get_NCells()) || !m_yNearest.Create(System.Get_NCells()) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	m_System	= System;
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_System.Get_NCells(); i++)
+	{
+		m_xNearest[i]	= -1;
+		m_yNearest[i]	= -1;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+CSG_Grid_Distance_Transform::CSG_Grid_Distance_Transform(const CSG_Grid &Features)
+{
+	m_bOkay	= false;
+
+	Create(Features);
+}
+
+bool CSG_Grid_Distance_Transform::Create(const CSG_Grid &Features)
+{
+	if( !Create(Features.Get_System()) )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<m_System.Get_NY(); y++)
+	{
+		for(int x=0; x<m_System.Get_NX(); x++)
+		{
+			if( !Features.is_NoData(x, y) )
+			{
+				m_yNearest[(sLong)y * m_System.Get_NX() + x]	= y;
+			}
+		}
+	}
+
+	return( Execute() );
+}
+
+//---------------------------------------------------------
+CSG_Grid_Distance_Transform::~CSG_Grid_Distance_Transform(void)
+{
+	Destroy();
+}
+
+bool CSG_Grid_Distance_Transform::Destroy(void)
+{
+	m_bOkay	= false;
+
+	m_System.Destroy();
+
+	m_xNearest.Destroy();
+	m_yNearest.Destroy();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Distance_Transform::Set_Feature(int x, int y)
+{
+	if( m_System.is_InGrid(x, y) )
+	{
+		m_yNearest[(sLong)y * m_System.Get_NX() + x]	= y;
+
+		m_bOkay	= false;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * First phase: for each cell the row of the nearest feature in
+  * the same column is found with one downward and one upward scan.
+  * Second phase: for each row the lower envelope of the parabolas
+  * (x - i)^2 + g(i)^2, with g(i) being the column distance found in
+  * the first phase, gives the column of the nearest feature cell.
+*/
+bool CSG_Grid_Distance_Transform::Execute(void)
+{
+	if( !m_System.is_Valid() )
+	{
+		return( false );
+	}
+
+	const int	NX	= m_System.Get_NX();
+	const int	NY	= m_System.Get_NY();
+
+	int	nBlocks	= 1 + (NX - 1) / DT_COLUMN_BLOCK;
+
+	CSG_Progress	Progress(nBlocks + NY);
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		if( !Progress.Step() )
+		{
+			continue;
+		}
+
+		int	xa	= iBlock * DT_COLUMN_BLOCK, xb = M_GET_MIN(xa + DT_COLUMN_BLOCK, NX);
+
+		int	Next[DT_COLUMN_BLOCK];
+
+		for(int x=xa; x<xb; x++)
+		{
+			Next[x - xa]	= -1;
+		}
+
+		for(int y=0; y<NY; y++)	// downward: nearest feature row below or at y
+		{
+			int	*R	= m_yNearest.Get_Array() + (sLong)y * NX;
+
+			for(int x=xa; x<xb; x++)
+			{
+				if( R[x] == y )
+				{
+					Next[x - xa]	= y;
+				}
+
+				R[x]	= Next[x - xa];
+			}
+		}
+
+		for(int x=xa; x<xb; x++)
+		{
+			Next[x - xa]	= -1;
+		}
+
+		for(int y=NY-1; y>=0; y--)	// upward: nearest feature row above, if closer
+		{
+			int	*R	= m_yNearest.Get_Array() + (sLong)y * NX;
+
+			for(int x=xa; x<xb; x++)
+			{
+				if( R[x] == y )
+				{
+					Next[x - xa]	= y;
+				}
+				else if( Next[x - xa] >= 0 && (R[x] < 0 || Next[x - xa] - y < y - R[x]) )
+				{
+					R[x]	= Next[x - xa];
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel
+	{
+		CSG_Array_Int	v(NX);	CSG_Array	z(sizeof(double), NX + 1);
+
+		int	*V	= v.Get_Array();	double	*Z	= (double *)z.Get_Array();
+
+		#pragma omp for
+		for(int y=0; y<NY; y++)
+		{
+			if( !Progress.Step() )
+			{
+				continue;
+			}
+
+			const int	*R	= m_yNearest.Get_Array() + (sLong)y * NX;
+
+			int	*X	= m_xNearest.Get_Array() + (sLong)y * NX;
+
+			//---------------------------------------------
+			int	k	= -1;	// index of the right-most parabola of the lower envelope
+
+			for(int i=0; i<NX; i++)
+			{
+				if( R[i] < 0 )	// no feature in this column
+				{
+					continue;
+				}
+
+				double	fi	= (double)(R[i] - y) * (R[i] - y) + (double)i * i;
+
+				while( k >= 0 )
+				{
+					int	j	= V[k];
+
+					double	s	= (fi - ((double)(R[j] - y) * (R[j] - y) + (double)j * j)) / (2. * (i - j));
+
+					if( s > Z[k] )
+					{
+						V[++k]	= i; Z[k] = s;
+
+						break;
+					}
+
+					k--;
+				}
+
+				if( k < 0 )
+				{
+					V[k = 0]	= i; Z[0] = -1.;	// the first parabola starts left of column zero
+				}
+			}
+
+			//---------------------------------------------
+			if( k < 0 )	// no features at all
+			{
+				continue;
+			}
+
+			for(int x=0, j=0; x<NX; x++)
+			{
+				while( j < k && Z[j + 1] <= x )
+				{
+					j++;
+				}
+
+				X[x]	= V[j];
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	m_bOkay	= Progress.Step(0);
+
+	return( m_bOkay );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+sLong CSG_Grid_Distance_Transform::Get_Nearest(int x, int y)	const
+{
+	if( m_bOkay && m_System.is_InGrid(x, y) )
+	{
+		int	xFeature	= m_xNearest[(sLong)y * m_System.Get_NX() + x];
+
+		if( xFeature >= 0 )
+		{
+			return( (sLong)m_yNearest[(sLong)y * m_System.Get_NX() + xFeature] * m_System.Get_NX() + xFeature );
+		}
+	}
+
+	return( -1 );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Distance_Transform::Get_Nearest(int x, int y, int &xFeature, int &yFeature)	const
+{
+	sLong	i	= Get_Nearest(x, y);
+
+	if( i >= 0 )
+	{
+		xFeature	= (int)(i % m_System.Get_NX());
+		yFeature	= (int)(i / m_System.Get_NX());
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+double CSG_Grid_Distance_Transform::Get_Distance(int x, int y)	const
+{
+	int	ix, iy;
+
+	if( Get_Nearest(x, y, ix, iy) )
+	{
+		return( sqrt((double)(ix - x) * (ix - x) + (double)(iy - y) * (iy - y)) );
+	}
+
+	return( -1. );
+}
+
+//---------------------------------------------------------
+double CSG_Grid_Distance_Transform::Get_Map_Distance(int x, int y)	const
+{
+	double	d	= Get_Distance(x, y);
+
+	return( d < 0. ? d : d * m_System.Get_Cellsize() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -82,6 +82,7 @@ bool CSG_Grid::On_Delete(void)
 	CSG_String	FileName	= Get_File_Name(true);
 
 	SG_File_Set_Extension(FileName, "sg-grd-z"); SG_File_Delete(FileName);
+	SG_File_Set_Extension(FileName, "sg-grd-t"); SG_File_Delete(FileName);
 	SG_File_Set_Extension(FileName, "sg-grd"  ); SG_File_Delete(FileName);
 	SG_File_Set_Extension(FileName, "sgrd"    ); SG_File_Delete(FileName);
 	SG_File_Set_Extension(FileName, "sdat"    ); SG_File_Delete(FileName); SG_File_Delete(FileName + ".aux.xml");
@@ -112,6 +113,7 @@ bool					SG_Grid_Set_File_Format_Default	(int Format)
 	case GRID_FILE_FORMAT_Compressed:
 	case GRID_FILE_FORMAT_ASCII     :
 	case GRID_FILE_FORMAT_GeoTIFF   :
+	case GRID_FILE_FORMAT_Tiled     :
 		gSG_Grid_File_Format_Default	= (TSG_Grid_File_Format)Format;
 		return( true );
 	}
@@ -135,6 +137,7 @@ CSG_String				SG_Grid_Get_File_Extension_Default	(void)
 	case GRID_FILE_FORMAT_Binary    :	return( "sg-grd"   );
 	case GRID_FILE_FORMAT_Binary_old:	return( "sgrd"     );
 	case GRID_FILE_FORMAT_GeoTIFF   :	return( "tif"      );
+	case GRID_FILE_FORMAT_Tiled     :	return( "sg-grd-t" );
 	}
 }
 
@@ -146,6 +149,8 @@ CSG_String				SG_Grid_Get_File_Extension_Default	(void)
 //---------------------------------------------------------
 bool CSG_Grid::Save(const CSG_String &FileName, int Format)
 {
+	CSG_Profiler_Region Profile("save", FileName, "grid");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("grid"), FileName.c_str()), true);
 
 	//-----------------------------------------------------
@@ -157,6 +162,7 @@ bool CSG_Grid::Save(const CSG_String &FileName, int Format)
 		if( SG_File_Cmp_Extension(FileName, "sg-grd"  ) )	Format	= GRID_FILE_FORMAT_Binary    ;
 		if( SG_File_Cmp_Extension(FileName, "sgrd"    ) )	Format	= GRID_FILE_FORMAT_Binary_old;
 		if( SG_File_Cmp_Extension(FileName, "tif"     ) )	Format	= GRID_FILE_FORMAT_GeoTIFF   ;
+		if( SG_File_Cmp_Extension(FileName, "sg-grd-t") )	Format	= GRID_FILE_FORMAT_Tiled     ;
 	}
 
 	//-----------------------------------------------------
@@ -172,6 +178,10 @@ bool CSG_Grid::Save(const CSG_String &FileName, int Format)
 		bResult = _Save_Compressed(FileName);
 		break;
 
+	case GRID_FILE_FORMAT_Tiled:
+		bResult = _Save_Tiled(FileName);
+		break;
+
 	case GRID_FILE_FORMAT_GeoTIFF:
 		SG_UI_Msg_Lock(true);
 		SG_RUN_TOOL(bResult, "io_gdal", 2,	// Export GeoTIFF
@@ -1098,6 +1108,13 @@ CSG_Grid_File_Info::CSG_Grid_File_Info(const CSG_String &FileName)
 
 bool CSG_Grid_File_Info::Create(const CSG_String &FileName)
 {
+	if( SG_File_Cmp_Extension(FileName, "sg-grd-t") )
+	{
+		CSG_Grid_File_Tiled	Tiled(FileName);
+
+		return( Tiled.is_Okay() && Create(Tiled.Get_Info()) );
+	}
+
 	if( !SG_File_Cmp_Extension(FileName, "sg-grd-z") )
 	{
 		if( SG_File_Cmp_Extension(FileName, "sgrd")
@@ -0,0 +1,827 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   grid_io_tiled.cpp                   //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// File layout (*.sg-grd-t):
+//
+//   magic "SG-GRD-T", byte order mark, version
+//   grid header: data type, extent, scaling, no-data
+//   tile size, codec, predictor
+//   name, description and unit (utf-8, length prefixed)
+//   tile offset table (number of tiles + 1)
+//   compressed tiles (row by row from the grid's lower left)
+//   meta data (xml) up to the end of file
+//
+// A tile's cell values are stored in the byte order of the
+// writing system. Before compression each tile row is split
+// into byte planes and the bytes are differenced, which
+// makes deflate work much better on floating point data.
+
+//---------------------------------------------------------
+#define TILED_MAGIC			"SG-GRD-T"
+#define TILED_BYTE_ORDER	0x01020304
+#define TILED_VERSION		1
+
+#define TILED_CODEC_DEFLATE	1
+#define TILED_PREDICTOR		1
+
+//---------------------------------------------------------
+static const BYTE	gSG_Tiled_Bitmask[8]	= { 0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80 };
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static inline int	SG_Tiled_Get_Value_Bytes	(TSG_Data_Type Type)
+{
+	return( Type == SG_DATATYPE_Bit ? 1 : (int)SG_Data_Type_Get_Size(Type) );	// bits are stored as bytes
+}
+
+//---------------------------------------------------------
+static void		SG_Tiled_Set_Value	(char *pValue, TSG_Data_Type Type, double Value)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Bit   : *(BYTE   *)pValue = Value != 0. ? 1 : 0  ; break;
+	case SG_DATATYPE_Byte  : *(BYTE   *)pValue = SG_ROUND_TO_BYTE (Value); break;
+	case SG_DATATYPE_Char  : *(char   *)pValue = SG_ROUND_TO_CHAR (Value); break;
+	case SG_DATATYPE_Word  : *(WORD   *)pValue = SG_ROUND_TO_WORD (Value); break;
+	case SG_DATATYPE_Short : *(short  *)pValue = SG_ROUND_TO_SHORT(Value); break;
+	case SG_DATATYPE_DWord : *(DWORD  *)pValue = SG_ROUND_TO_DWORD(Value); break;
+	case SG_DATATYPE_Int   : *(int    *)pValue = SG_ROUND_TO_INT  (Value); break;
+	case SG_DATATYPE_Long  : *(sLong  *)pValue = SG_ROUND_TO_SLONG(Value); break;
+	case SG_DATATYPE_ULong : *(uLong  *)pValue = SG_ROUND_TO_ULONG(Value); break;
+	case SG_DATATYPE_Float : *(float  *)pValue = (float )Value; break;
+	case SG_DATATYPE_Double: *(double *)pValue = (double)Value; break;
+	default: break;
+	}
+}
+
+//---------------------------------------------------------
+static double	SG_Tiled_Get_Value	(const char *pValue, TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Bit   : return( *(BYTE   *)pValue ? 1. : 0. );
+	case SG_DATATYPE_Byte  : return( *(BYTE   *)pValue );
+	case SG_DATATYPE_Char  : return( *(char   *)pValue );
+	case SG_DATATYPE_Word  : return( *(WORD   *)pValue );
+	case SG_DATATYPE_Short : return( *(short  *)pValue );
+	case SG_DATATYPE_DWord : return( *(DWORD  *)pValue );
+	case SG_DATATYPE_Int   : return( *(int    *)pValue );
+	case SG_DATATYPE_Long  : return( (double)*(sLong *)pValue );
+	case SG_DATATYPE_ULong : return( (double)*(uLong *)pValue );
+	case SG_DATATYPE_Float : return( *(float  *)pValue );
+	case SG_DATATYPE_Double: return( *(double *)pValue );
+	default: break;
+	}
+
+	return( 0. );
+}
+
+//---------------------------------------------------------
+static void		SG_Tiled_Encode		(const char *Values, BYTE *Bytes, int nx, int ny, int nBytes)
+{
+	size_t nLine = (size_t)nx * nBytes;
+
+	for(int y=0; y<ny; y++, Values+=nLine, Bytes+=nLine)
+	{
+		for(int i=0; i<nBytes; i++)	// split into byte planes
+		{
+			for(int x=0; x<nx; x++)
+			{
+				Bytes[i * nx + x] = (BYTE)Values[x * nBytes + i];
+			}
+		}
+
+		for(size_t i=nLine-1; i>0; i--)	// difference
+		{
+			Bytes[i] -= Bytes[i - 1];
+		}
+	}
+}
+
+//---------------------------------------------------------
+static void		SG_Tiled_Decode		(BYTE *Bytes, char *Values, int nx, int ny, int nBytes)
+{
+	size_t nLine = (size_t)nx * nBytes;
+
+	for(int y=0; y<ny; y++, Values+=nLine, Bytes+=nLine)
+	{
+		for(size_t i=1; i<nLine; i++)	// accumulate
+		{
+			Bytes[i] += Bytes[i - 1];
+		}
+
+		for(int i=0; i<nBytes; i++)	// merge byte planes
+		{
+			for(int x=0; x<nx; x++)
+			{
+				Values[x * nBytes + i] = (char)Bytes[i * nx + x];
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+static bool		SG_Tiled_Deflate	(const void *Bytes, size_t nBytes, CSG_Array &Packed)
+{
+	wxMemoryOutputStream Memory;
+
+	{
+		wxZlibOutputStream Stream(Memory, wxZ_BEST_SPEED, wxZLIB_ZLIB);	// the predictor does most of the work
+
+		if( !Stream.Write(Bytes, nBytes).IsOk() || !Stream.Close() )
+		{
+			return( false );
+		}
+	}
+
+	size_t nPacked = (size_t)Memory.GetLength();
+
+	return( Packed.Create(1, (sLong)nPacked) && Memory.CopyTo(Packed.Get_Array(), nPacked) == nPacked );
+}
+
+//---------------------------------------------------------
+static bool		SG_Tiled_Inflate	(const CSG_Array &Packed, void *Bytes, size_t nBytes)
+{
+	wxMemoryInputStream Memory(Packed.Get_Array(), Packed.Get_uSize());
+
+	wxZlibInputStream Stream(Memory, wxZLIB_ZLIB);
+
+	return( Stream.Read(Bytes, nBytes).LastRead() == nBytes );
+}
+
+//---------------------------------------------------------
+static bool		SG_Tiled_Write_String	(CSG_File &Stream, const CSG_String &String)
+{
+	CSG_Buffer Buffer(String.to_UTF8()); int n = (int)Buffer.Get_Size() - 1;	// size includes the terminating null character
+
+	return( Stream.Write_Int(n) && (n < 1 || Stream.Write(Buffer.Get_Data(), 1, n) == (size_t)n) );
+}
+
+//---------------------------------------------------------
+static CSG_String	SG_Tiled_Read_String	(CSG_File &Stream, bool bSwap)
+{
+	int n = Stream.Read_Int(bSwap);
+
+	if( n > 0 )
+	{
+		CSG_Array Buffer(1, n);
+
+		if( Stream.Read(Buffer.Get_Array(), 1, n) == (size_t)n )
+		{
+			return( CSG_String::from_UTF8((const char *)Buffer.Get_Array(), n) );
+		}
+	}
+
+	return( "" );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_File_Tiled::CSG_Grid_File_Tiled(void)
+{
+	_On_Construction();
+}
+
+//---------------------------------------------------------
+CSG_Grid_File_Tiled::CSG_Grid_File_Tiled(const CSG_String &File)
+{
+	_On_Construction();
+
+	Open(File);
+}
+
+//---------------------------------------------------------
+CSG_Grid_File_Tiled::~CSG_Grid_File_Tiled(void)
+{
+	Close();
+}
+
+//---------------------------------------------------------
+void CSG_Grid_File_Tiled::_On_Construction(void)
+{
+	m_pStream     = NULL;
+	m_bSwap       = false;
+	m_Tile_Size   = 0;
+	m_nx = m_ny   = 0;
+	m_nValueBytes = 0;
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_File_Tiled::Close(void)
+{
+	if( m_pStream )
+	{
+		delete(m_pStream);
+
+		m_pStream = NULL;
+	}
+
+	m_Offsets.Destroy();
+
+	m_Info.Create(CSG_Grid_File_Info());
+
+	m_Tile_Size = m_nx = m_ny = m_nValueBytes = 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_File_Tiled::Open(const CSG_String &File)
+{
+	Close();
+
+	m_pStream = new CSG_File;
+
+	char Magic[8];
+
+	if( !m_pStream->Open(File, SG_FILE_R, true) || m_pStream->Read(Magic, 1, 8) != 8 || memcmp(Magic, TILED_MAGIC, 8) )
+	{
+		Close();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int Order = m_pStream->Read_Int();
+
+	if( Order != TILED_BYTE_ORDER )
+	{
+		SG_Swap_Bytes(&Order, sizeof(Order));
+
+		if( Order != TILED_BYTE_ORDER )
+		{
+			Close();
+
+			return( false );
+		}
+
+		m_bSwap = true;
+	}
+
+	if( m_pStream->Read_Int(m_bSwap) != TILED_VERSION )
+	{
+		Close();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	m_Info.m_Type       = (TSG_Data_Type)m_pStream->Read_Int(m_bSwap);
+
+	int    NX           = m_pStream->Read_Int   (m_bSwap);
+	int    NY           = m_pStream->Read_Int   (m_bSwap);
+	double Cellsize     = m_pStream->Read_Double(m_bSwap);
+	double xMin         = m_pStream->Read_Double(m_bSwap);
+	double yMin         = m_pStream->Read_Double(m_bSwap);
+
+	m_Info.m_zScale     = m_pStream->Read_Double(m_bSwap);
+	m_Info.m_zOffset    = m_pStream->Read_Double(m_bSwap);
+	m_Info.m_NoData[0]  = m_pStream->Read_Double(m_bSwap);
+	m_Info.m_NoData[1]  = m_pStream->Read_Double(m_bSwap);
+
+	m_Tile_Size         = m_pStream->Read_Int   (m_bSwap);
+
+	int Codec           = m_pStream->Read_Int   (m_bSwap);
+	int Predictor       = m_pStream->Read_Int   (m_bSwap);
+
+	m_Info.m_Name        = SG_Tiled_Read_String(*m_pStream, m_bSwap);
+	m_Info.m_Description = SG_Tiled_Read_String(*m_pStream, m_bSwap);
+	m_Info.m_Unit        = SG_Tiled_Read_String(*m_pStream, m_bSwap);
+
+	if( m_Info.m_Type < 0 || m_Info.m_Type >= SG_DATATYPE_Undefined || !SG_Data_Type_is_Numeric(m_Info.m_Type)
+	||  Codec != TILED_CODEC_DEFLATE || Predictor != TILED_PREDICTOR || m_Tile_Size < 8 || m_Tile_Size % 8
+	||  !m_Info.m_System.Assign(Cellsize, xMin, yMin, NX, NY) )
+	{
+		Close();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	m_nValueBytes = SG_Tiled_Get_Value_Bytes(m_Info.m_Type);
+
+	m_nx = 1 + (NX - 1) / m_Tile_Size;
+	m_ny = 1 + (NY - 1) / m_Tile_Size;
+
+	sLong nOffsets = (sLong)m_nx * m_ny + 1;
+
+	if( !m_Offsets.Create(nOffsets) || m_pStream->Read(m_Offsets.Get_Array(), sizeof(sLong), nOffsets) != (size_t)nOffsets )
+	{
+		Close();
+
+		return( false );
+	}
+
+	for(sLong i=0; i<nOffsets; i++)
+	{
+		if( m_bSwap )
+		{
+			SG_Swap_Bytes(&m_Offsets[i], sizeof(sLong));
+		}
+
+		if( (i > 0 && m_Offsets[i] < m_Offsets[i - 1]) || m_Offsets[i] > m_pStream->Length() )
+		{
+			Close();
+
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_File_Tiled::_Get_Tile_Rect(int xTile, int yTile, int &xa, int &ya, int &nx, int &ny)	const
+{
+	if( xTile < 0 || xTile >= m_nx || yTile < 0 || yTile >= m_ny )
+	{
+		return( false );
+	}
+
+	xa = xTile * m_Tile_Size; nx = M_GET_MIN(m_Tile_Size, m_Info.m_System.Get_NX() - xa);
+	ya = yTile * m_Tile_Size; ny = M_GET_MIN(m_Tile_Size, m_Info.m_System.Get_NY() - ya);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Decompresses a single tile. Values receives the tile's cells
+  * row by row in the file's data type and the system's byte
+  * order (bit grids come with one byte per cell). Edge tiles
+  * are clipped to the grid extent. Can be called from parallel
+  * threads.
+*/
+bool CSG_Grid_File_Tiled::Read_Tile(int xTile, int yTile, CSG_Array &Values)	const
+{
+	int xa, ya, nx, ny;
+
+	if( !is_Okay() || !_Get_Tile_Rect(xTile, yTile, xa, ya, nx, ny) )
+	{
+		return( false );
+	}
+
+	sLong i = (sLong)yTile * m_nx + xTile, nPacked = m_Offsets[i + 1] - m_Offsets[i];
+
+	CSG_Array Packed(1, nPacked); bool bOkay = nPacked > 0;
+
+	#pragma omp critical (SG_Grid_File_Tiled)
+	{
+		bOkay = bOkay && m_pStream->Seek(m_Offsets[i]) && m_pStream->Read(Packed.Get_Array(), 1, (size_t)nPacked) == (size_t)nPacked;
+	}
+
+	//-----------------------------------------------------
+	size_t nBytes = (size_t)nx * ny * m_nValueBytes;
+
+	CSG_Array Bytes(1, (sLong)nBytes);
+
+	if( !bOkay || !Values.Create(1, (sLong)nBytes) || !SG_Tiled_Inflate(Packed, Bytes.Get_Array(), nBytes) )
+	{
+		return( false );
+	}
+
+	SG_Tiled_Decode((BYTE *)Bytes.Get_Array(), (char *)Values.Get_Array(), nx, ny, m_nValueBytes);
+
+	if( m_bSwap && m_nValueBytes > 1 )
+	{
+		char *pValue = (char *)Values.Get_Array();
+
+		for(size_t i=0; i<nBytes; i+=m_nValueBytes)
+		{
+			SG_Swap_Bytes(pValue + i, m_nValueBytes);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Fills Lines with the rows yFirst to yFirst + nLines - 1 in
+  * the memory layout of a grid row (see CSG_Grid::Get_Row_Data()),
+  * i.e. bit grids are packed to bytes. Only the tiles covering
+  * these rows are read, they are decompressed in parallel.
+*/
+bool CSG_Grid_File_Tiled::Read_Lines(int yFirst, int nLines, void *Lines)	const
+{
+	if( !is_Okay() || !Lines || yFirst < 0 || nLines < 1 || yFirst + nLines > m_Info.m_System.Get_NY() )
+	{
+		return( false );
+	}
+
+	bool bBits = m_Info.m_Type == SG_DATATYPE_Bit;
+
+	size_t nLineBytes = bBits ? 1 + m_Info.m_System.Get_NX() / 8 : (size_t)m_Info.m_System.Get_NX() * m_nValueBytes;
+
+	bool bOkay = true;
+
+	for(int yTile=yFirst/m_Tile_Size; bOkay && yTile<=(yFirst+nLines-1)/m_Tile_Size; yTile++)
+	{
+		#pragma omp parallel for reduction(&&:bOkay)
+		for(int xTile=0; xTile<m_nx; xTile++)
+		{
+			int xa, ya, nx, ny; CSG_Array Values;
+
+			if( !_Get_Tile_Rect(xTile, yTile, xa, ya, nx, ny) || !Read_Tile(xTile, yTile, Values) )
+			{
+				bOkay = false;
+
+				continue;
+			}
+
+			for(int y=M_GET_MAX(ya, yFirst); y<M_GET_MIN(ya + ny, yFirst + nLines); y++)
+			{
+				char *pLine  = (char *)Lines + (size_t)(y - yFirst) * nLineBytes;
+				char *pValue = (char *)Values.Get_Array() + (size_t)(y - ya) * nx * m_nValueBytes;
+
+				if( bBits )	// tile size is a multiple of 8, tiles don't share bytes
+				{
+					for(int x=xa; x<xa+nx; x++, pValue++)
+					{
+						pLine[x / 8] = *pValue ? pLine[x / 8] | gSG_Tiled_Bitmask[x % 8] : pLine[x / 8] & (~gSG_Tiled_Bitmask[x % 8]);
+					}
+				}
+				else
+				{
+					memcpy(pLine + (size_t)xa * m_nValueBytes, pValue, (size_t)nx * m_nValueBytes);
+				}
+			}
+		}
+	}
+
+	return( bOkay );
+}
+
+//---------------------------------------------------------
+/**
+  * Windowed read. Copies the file's cells into Grid, whereby
+  * Grid's cell (x, y) receives the file's cell (x + xOffset,
+  * y + yOffset). Values are copied unscaled, cells outside the
+  * file's extent are not touched. Only the tiles overlapping the
+  * window are decompressed.
+*/
+bool CSG_Grid_File_Tiled::Read(CSG_Grid &Grid, int xOffset, int yOffset)	const
+{
+	if( !is_Okay() || !Grid.is_Valid() )
+	{
+		return( false );
+	}
+
+	int xFirst = M_GET_MAX(0, xOffset), xLast = M_GET_MIN(m_Info.m_System.Get_NX(), xOffset + Grid.Get_NX()) - 1;
+	int yFirst = M_GET_MAX(0, yOffset), yLast = M_GET_MIN(m_Info.m_System.Get_NY(), yOffset + Grid.Get_NY()) - 1;
+
+	if( xFirst > xLast || yFirst > yLast )
+	{
+		return( true );	// no overlap, nothing to do
+	}
+
+	int x0 = xFirst / m_Tile_Size, nx = 1 + xLast / m_Tile_Size - x0;
+	int y0 = yFirst / m_Tile_Size, ny = 1 + yLast / m_Tile_Size - y0;
+
+	bool bOkay = true;
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iTile=0; iTile<nx*ny; iTile++)
+	{
+		int xTile = x0 + iTile % nx, yTile = y0 + iTile / nx, xa, ya, nxTile, nyTile; CSG_Array Values;
+
+		if( !_Get_Tile_Rect(xTile, yTile, xa, ya, nxTile, nyTile) || !Read_Tile(xTile, yTile, Values) )
+		{
+			bOkay = false;
+
+			continue;
+		}
+
+		for(int y=M_GET_MAX(ya, yFirst); y<=M_GET_MIN(ya + nyTile - 1, yLast); y++)
+		{
+			for(int x=M_GET_MAX(xa, xFirst); x<=M_GET_MIN(xa + nxTile - 1, xLast); x++)
+			{
+				const char *pValue = (const char *)Values.Get_Array() + ((size_t)(y - ya) * nxTile + (x - xa)) * m_nValueBytes;
+
+				Grid.Set_Value(x - xOffset, y - yOffset, SG_Tiled_Get_Value(pValue, m_Info.m_Type), false);
+			}
+		}
+	}
+
+	return( bOkay );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Writes the grid's header and compressed tiles to Stream.
+  * Tiles are compressed in parallel, one row of tiles at a
+  * time. The tile size is rounded down to a multiple of 8. The
+  * file position is left behind the last tile, which is where
+  * the meta data are expected.
+*/
+bool CSG_Grid_File_Tiled::Save(const CSG_Grid &Grid, CSG_File &Stream, int Tile_Size)
+{
+	if( !Stream.is_Writing() || !Grid.is_Valid() || !SG_Data_Type_is_Numeric(Grid.Get_Type()) )
+	{
+		return( false );
+	}
+
+	Tile_Size = M_GET_MAX(8, Tile_Size - Tile_Size % 8);
+
+	TSG_Data_Type Type = Grid.Get_Type(); int nValueBytes = SG_Tiled_Get_Value_Bytes(Type);
+
+	//-----------------------------------------------------
+	Stream.Write((void *)TILED_MAGIC, 1, 8);
+
+	Stream.Write_Int   (TILED_BYTE_ORDER);
+	Stream.Write_Int   (TILED_VERSION);
+	Stream.Write_Int   (Type);
+	Stream.Write_Int   (Grid.Get_NX());
+	Stream.Write_Int   (Grid.Get_NY());
+	Stream.Write_Double(Grid.Get_Cellsize());
+	Stream.Write_Double(Grid.Get_XMin());
+	Stream.Write_Double(Grid.Get_YMin());
+	Stream.Write_Double(Grid.Get_Scaling());
+	Stream.Write_Double(Grid.Get_Offset());
+	Stream.Write_Double(Grid.Get_NoData_Value());
+	Stream.Write_Double(Grid.Get_NoData_Value(true));
+	Stream.Write_Int   (Tile_Size);
+	Stream.Write_Int   (TILED_CODEC_DEFLATE);
+	Stream.Write_Int   (TILED_PREDICTOR);
+
+	SG_Tiled_Write_String(Stream, Grid.Get_Name       ());
+	SG_Tiled_Write_String(Stream, Grid.Get_Description());
+	SG_Tiled_Write_String(Stream, Grid.Get_Unit       ());
+
+	//-----------------------------------------------------
+	int nx = 1 + (Grid.Get_NX() - 1) / Tile_Size;
+	int ny = 1 + (Grid.Get_NY() - 1) / Tile_Size;
+
+	CSG_Array_sLong Offsets((sLong)nx * ny + 1); sLong Table = Stream.Tell();
+
+	if( Stream.Write(Offsets.Get_Array(), sizeof(sLong), Offsets.Get_uSize()) != sizeof(sLong) * Offsets.Get_uSize() )
+	{
+		return( false );
+	}
+
+	Offsets[0] = Stream.Tell();
+
+	//-----------------------------------------------------
+	CSG_Array *Packed = new CSG_Array[nx]; bool bOkay = true;
+
+	size_t nStrip = (size_t)Grid.Get_NX() * nValueBytes;	// one row of tiles, read before it is compressed in parallel
+
+	CSG_Array Strip(1, (sLong)(nStrip * Tile_Size));
+
+	for(int yTile=0; bOkay && yTile<ny && SG_UI_Process_Set_Progress(yTile, ny); yTile++)
+	{
+		int ya = yTile * Tile_Size, nyTile = M_GET_MIN(Tile_Size, Grid.Get_NY() - ya);
+
+		#pragma omp parallel for if(!Grid.is_Cached())	// a file cache might share one stream
+		for(int y=0; y<nyTile; y++)
+		{
+			char *pValues = (char *)Strip.Get_Array() + y * nStrip;
+
+			const char *pLine = Type == SG_DATATYPE_Bit ? NULL : (const char *)Grid.Get_Row_Data(ya + y);
+
+			if( pLine )
+			{
+				memcpy(pValues, pLine, nStrip);
+			}
+			else for(int x=0; x<Grid.Get_NX(); x++, pValues+=nValueBytes)
+			{
+				SG_Tiled_Set_Value(pValues, Type, Grid.asDouble(x, ya + y, false));
+			}
+		}
+
+		//-------------------------------------------------
+		#pragma omp parallel for reduction(&&:bOkay)
+		for(int xTile=0; xTile<nx; xTile++)
+		{
+			int xa = xTile * Tile_Size, nxTile = M_GET_MIN(Tile_Size, Grid.Get_NX() - xa);
+
+			size_t nLine = (size_t)nxTile * nValueBytes;
+
+			CSG_Array Values(1, (sLong)(nLine * nyTile)), Bytes(1, (sLong)(nLine * nyTile));
+
+			for(int y=0; y<nyTile; y++)
+			{
+				memcpy((char *)Values.Get_Array() + y * nLine, (const char *)Strip.Get_Array() + y * nStrip + (size_t)xa * nValueBytes, nLine);
+			}
+
+			SG_Tiled_Encode((const char *)Values.Get_Array(), (BYTE *)Bytes.Get_Array(), nxTile, nyTile, nValueBytes);
+
+			if( !SG_Tiled_Deflate(Bytes.Get_Array(), Bytes.Get_uSize(), Packed[xTile]) )
+			{
+				bOkay = false;
+			}
+		}
+
+		for(int xTile=0; bOkay && xTile<nx; xTile++)
+		{
+			sLong i = (sLong)yTile * nx + xTile;
+
+			bOkay = Stream.Write(Packed[xTile].Get_Array(), 1, Packed[xTile].Get_uSize()) == Packed[xTile].Get_uSize();
+
+			Offsets[i + 1] = Offsets[i] + Packed[xTile].Get_Size();
+		}
+	}
+
+	delete[](Packed);
+
+	//-----------------------------------------------------
+	if( !bOkay || !SG_UI_Process_Get_Okay() )
+	{
+		return( false );
+	}
+
+	sLong End = Stream.Tell();
+
+	return( Stream.Seek(Table)
+		&&  Stream.Write(Offsets.Get_Array(), sizeof(sLong), Offsets.Get_uSize()) == sizeof(sLong) * Offsets.Get_uSize()
+		&&  Stream.Seek(End)
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::_Load_Tiled(const CSG_String &File, bool bCached, bool bLoadData)
+{
+	if( !SG_File_Cmp_Extension(File, "sg-grd-t") )
+	{
+		return( false );
+	}
+
+	CSG_Grid_File_Tiled Tiled;
+
+	if( !Tiled.Open(File) )
+	{
+		return( false );
+	}
+
+	const CSG_Grid_File_Info &Info = Tiled.Get_Info();
+
+	//-----------------------------------------------------
+	Set_File_Name(File, true);
+
+	Set_Name        (Info.m_Name);
+	Set_Description (Info.m_Description);
+	Set_Unit        (Info.m_Unit);
+
+	Set_NoData_Value_Range(Info.m_NoData[0], Info.m_NoData[1]);
+
+	m_System		= Info.m_System;
+	m_Type			= Info.m_Type;
+	m_zScale		= Info.m_zScale;
+	m_zOffset		= Info.m_zOffset;
+
+	m_nBytes_Value	= SG_Data_Type_Get_Size(m_Type);
+	m_nBytes_Line	= m_Type == SG_DATATYPE_Bit ? 1 + Get_NX() / 8 : Get_NX() * m_nBytes_Value;
+
+	CSG_File Stream(File, SG_FILE_R, true);
+
+	if( Stream.Seek(Tiled.Get_MetaData_Offset()) )
+	{
+		Load_MetaData(Stream);	// includes the projection
+	}
+
+	if( !bLoadData )
+	{
+		return( _Memory_Create(bCached) );
+	}
+
+	//-----------------------------------------------------
+	if( !_Memory_Create(bCached) )
+	{
+		return( false );
+	}
+
+	Set_File_Type(GRID_FILE_FORMAT_Tiled);
+
+	if( is_Cached() )	// decompress tiles not before they are requested
+	{
+		return( _Cache_Source_Create(File) );
+	}
+
+	int nLines = Tiled.Get_Tile_Size();
+
+	for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y+=nLines)
+	{
+		if( !Tiled.Read_Lines(y, M_GET_MIN(nLines, Get_NY() - y), m_Values[y]) )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Save_Tiled(const CSG_String &File)
+{
+	if( !_Cache_Source_Detach() )	// the file might be the cache's own source, which is truncated when opened for writing
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s]", _TL("grid has not been saved, because it could not be read completely"), File.c_str()));
+
+		return( false );
+	}
+
+	CSG_File Stream(File, SG_FILE_W, true);
+
+	if( CSG_Grid_File_Tiled::Save(*this, Stream) )
+	{
+		Set_File_Type(GRID_FILE_FORMAT_Tiled);
+
+		Save_MetaData(Stream);	// appended behind the tiles
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
@@ -64,6 +64,15 @@
 //---------------------------------------------------------
 #include <memory.h>
 
+#if defined(_SAGA_MSW)
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "grid.h"
 #include "parameters.h"
 
@@ -148,6 +157,41 @@ double				SG_Grid_Cache_Get_Threshold_MB(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static sLong		gSG_Grid_Cache_Budget	= 0;
+
+//---------------------------------------------------------
+void				SG_Grid_Cache_Set_Budget(sLong nBytes)
+{
+	if( nBytes >= 0 )
+	{
+		gSG_Grid_Cache_Budget	= nBytes;
+	}
+}
+
+//---------------------------------------------------------
+void				SG_Grid_Cache_Set_Budget_MB(double nMegabytes)
+{
+	SG_Grid_Cache_Set_Budget((sLong)(nMegabytes * N_MEGABYTE_BYTES));
+}
+
+//---------------------------------------------------------
+sLong				SG_Grid_Cache_Get_Budget(void)
+{
+	return( gSG_Grid_Cache_Budget );
+}
+
+//---------------------------------------------------------
+double				SG_Grid_Cache_Get_Budget_MB(void)
+{
+	return( (double)gSG_Grid_Cache_Budget / (double)N_MEGABYTE_BYTES );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						Memory							 //
@@ -254,8 +298,277 @@ void CSG_Grid::_Array_Destroy(void)
 #endif
 
 //---------------------------------------------------------
-bool CSG_Grid::Set_Cache(bool bOn)
+// A file cache is memory mapped as a whole. Its rows are
+// grouped to tiles (bands of rows matching the file layout)
+// and a page table keeps track of the tiles that have been
+// touched. If a memory budget is given, resident tiles are
+// released following a clock (second chance) strategy, which
+// approximates a least recently used order.
+
+//---------------------------------------------------------
+#define CACHE_TILE_BYTES	(4 * N_MEGABYTE_BYTES)
+
+//---------------------------------------------------------
+enum
+{
+	CACHE_TILE_RELEASED	= 0,
+	CACHE_TILE_RESIDENT,
+	CACHE_TILE_REFERENCED
+};
+
+//---------------------------------------------------------
+typedef struct
+{
+	bool	bReadOnly;
+
+	int		nTiles, nTile_Rows, nResident, nResident_Max, Hand;
+
+	size_t	Size, nLine_Bytes, nPage_Bytes;
+
+	char	*pBase, *pData;
+
+	BYTE	*Tiles;
+
+#if defined(_SAGA_MSW)
+	HANDLE	hMap;
+#endif
+}
+TSG_Grid_Cache_Map;
+
+//---------------------------------------------------------
+static void	SG_Grid_Cache_Map_Release	(TSG_Grid_Cache_Map &Map, int iTile)
 {
+	char	*pStart	= Map.pData + (size_t)iTile * Map.nTile_Rows * Map.nLine_Bytes;
+	char	*pEnd	= pStart    + (size_t)           Map.nTile_Rows * Map.nLine_Bytes;
+
+	if( pEnd > Map.pBase + Map.Size )
+	{
+		pEnd	= Map.pBase + Map.Size;
+	}
+
+#if defined(_SAGA_MSW)
+	VirtualUnlock(pStart, pEnd - pStart);	// removes the pages from the working set
+#else
+	size_t	Start	= ((size_t)pStart + Map.nPage_Bytes - 1) & ~(Map.nPage_Bytes - 1);	// only pages completely covered by this tile
+	size_t	End		= ((size_t)pEnd                        ) & ~(Map.nPage_Bytes - 1);
+
+	if( Start < End )
+	{
+		madvise((void *)Start, End - Start, MADV_DONTNEED);	// dirty pages of shared file mappings are kept by the page cache
+	}
+#endif
+}
+
+//---------------------------------------------------------
+static void	SG_Grid_Cache_Map_Shrink	(TSG_Grid_Cache_Map &Map, int nResident)
+{
+	while( Map.nResident > nResident )
+	{
+		BYTE	&Tile	= Map.Tiles[Map.Hand];
+
+		if( Tile == CACHE_TILE_REFERENCED )
+		{
+			Tile	= CACHE_TILE_RESIDENT;	// second chance
+		}
+		else if( Tile == CACHE_TILE_RESIDENT )
+		{
+			Tile	= CACHE_TILE_RELEASED;
+
+			SG_Grid_Cache_Map_Release(Map, Map.Hand);
+
+			Map.nResident--;
+		}
+
+		Map.Hand	= (Map.Hand + 1) % Map.nTiles;
+	}
+}
+
+//---------------------------------------------------------
+static void	SG_Grid_Cache_Map_Touch		(TSG_Grid_Cache_Map &Map, int iTile)
+{
+	#pragma omp critical (SG_Grid_Cache_Map)
+	{
+		if( Map.Tiles[iTile] == CACHE_TILE_RELEASED )
+		{
+			if( Map.nResident_Max > 0 )
+			{
+				SG_Grid_Cache_Map_Shrink(Map, Map.nResident_Max - 1);
+			}
+
+			Map.nResident++;
+		}
+
+		Map.Tiles[iTile]	= CACHE_TILE_REFERENCED;
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Map_Create(void)
+{
+	_Cache_Map_Destroy();
+
+	if( !m_Cache_Stream || fflush(m_Cache_Stream) )
+	{
+		return( false );
+	}
+
+	sLong	nBytes	= m_Cache_Offset + (sLong)Get_NY() * Get_nLineBytes();
+
+	if( (sLong)(size_t)nBytes != nBytes )	// exceeds the address space (32 bit)
+	{
+		return( false );
+	}
+
+	TSG_Grid_Cache_Map	Map;	memset(&Map, 0, sizeof(Map));
+
+	//-----------------------------------------------------
+#if defined(_SAGA_MSW)
+	HANDLE	hFile	= (HANDLE)_get_osfhandle(_fileno(m_Cache_Stream));	LARGE_INTEGER	Size;
+
+	if( hFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(hFile, &Size) || Size.QuadPart < nBytes )
+	{
+		return( false );
+	}
+
+	if( (Map.hMap = CreateFileMapping(hFile, NULL, PAGE_READWRITE, 0, 0, NULL)) == NULL )
+	{
+		Map.bReadOnly	= true;	// file has been opened for reading only
+
+		if( (Map.hMap = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL)) == NULL )
+		{
+			return( false );
+		}
+	}
+
+	if( (Map.pBase = (char *)MapViewOfFile(Map.hMap, Map.bReadOnly ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, (SIZE_T)nBytes)) == NULL )
+	{
+		CloseHandle(Map.hMap);
+
+		return( false );
+	}
+
+	SYSTEM_INFO	Info;	GetSystemInfo(&Info);	Map.nPage_Bytes	= Info.dwPageSize;
+
+	//-----------------------------------------------------
+#else
+	int	hFile	= fileno(m_Cache_Stream);	struct stat	Status;
+
+	if( hFile < 0 || fstat(hFile, &Status) || Status.st_size < nBytes )
+	{
+		return( false );
+	}
+
+	void	*pBase	= mmap(NULL, (size_t)nBytes, PROT_READ|PROT_WRITE, MAP_SHARED, hFile, 0);
+
+	if( pBase == MAP_FAILED )
+	{
+		Map.bReadOnly	= true;	// file has been opened for reading only
+
+		if( (pBase = mmap(NULL, (size_t)nBytes, PROT_READ, MAP_SHARED, hFile, 0)) == MAP_FAILED )
+		{
+			return( false );
+		}
+	}
+
+	Map.pBase		= (char *)pBase;
+	Map.nPage_Bytes	= (size_t)sysconf(_SC_PAGESIZE);
+#endif
+
+	//-----------------------------------------------------
+	Map.Size		= (size_t)nBytes;
+	Map.pData		= Map.pBase + m_Cache_Offset;
+	Map.nLine_Bytes	= Get_nLineBytes();
+	Map.nTile_Rows	= (int)M_GET_MAX(1, CACHE_TILE_BYTES / Map.nLine_Bytes);
+	Map.nTiles		= 1 + (Get_NY() - 1) / Map.nTile_Rows;
+	Map.Tiles		= (BYTE *)SG_Calloc(Map.nTiles, sizeof(BYTE));
+
+	m_Cache_Map		= new TSG_Grid_Cache_Map(Map);
+
+	_Cache_Map_Set_Budget();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Map_Destroy(void)
+{
+	if( m_Cache_Map )
+	{
+		TSG_Grid_Cache_Map	*pMap	= (TSG_Grid_Cache_Map *)m_Cache_Map;
+
+	#if defined(_SAGA_MSW)
+		UnmapViewOfFile(pMap->pBase);
+		CloseHandle(pMap->hMap);
+	#else
+		munmap(pMap->pBase, pMap->Size);
+	#endif
+
+		SG_Free(pMap->Tiles);
+
+		delete(pMap);
+
+		m_Cache_Map	= NULL;
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Map_Set_Budget(void)
+{
+	TSG_Grid_Cache_Map	&Map	= *(TSG_Grid_Cache_Map *)m_Cache_Map;
+
+	sLong	Budget	= Get_Cache_Budget();
+
+	#pragma omp critical (SG_Grid_Cache_Map)
+	{
+		if( Budget > 0 )
+		{
+			Map.nResident_Max	= (int)M_GET_MAX(2, Budget / ((sLong)Map.nTile_Rows * Map.nLine_Bytes));
+
+			SG_Grid_Cache_Map_Shrink(Map, Map.nResident_Max);
+		}
+		else	// no limit, leave paging to the operating system
+		{
+			Map.nResident_Max	= 0;
+		}
+	}
+}
+
+//---------------------------------------------------------
+char * CSG_Grid::_Cache_Map_Get_Line(int y)	const
+{
+	TSG_Grid_Cache_Map	&Map	= *(TSG_Grid_Cache_Map *)m_Cache_Map;
+
+	if( m_Cache_Source )
+	{
+		_Cache_Source_Fill(y);
+	}
+
+	if( m_Cache_bFlip )
+	{
+		y	= Get_NY() - 1 - y;
+	}
+
+	if( Map.nResident_Max > 0 )	// the tile's state is only read and changed under the page table's lock
+	{
+		SG_Grid_Cache_Map_Touch(Map, y / Map.nTile_Rows);
+	}
+
+	return( Map.pData + (size_t)y * Map.nLine_Bytes );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::Set_Cache(bool bOn, sLong Budget)
+{
+	if( Budget >= 0 )
+	{
+		Set_Cache_Budget(Budget);
+	}
+
 	if( bOn )
 	{
 		return( is_Cached()
@@ -269,6 +582,31 @@ bool CSG_Grid::Set_Cache(bool bOn)
 	return( !is_Cached() || _Cache_Destroy(true) );
 }
 
+//---------------------------------------------------------
+/**
+  * Sets the amount of memory in bytes, which this grid is allowed
+  * to keep resident while it is file cached. A negative value
+  * resets the budget to the global default (see
+  * SG_Grid_Cache_Set_Budget()), zero means no limit.
+*/
+bool CSG_Grid::Set_Cache_Budget(sLong nBytes)
+{
+	m_Cache_Budget	= nBytes < 0 ? -1 : nBytes;
+
+	if( m_Cache_Map )
+	{
+		_Cache_Map_Set_Budget();
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+sLong CSG_Grid::Get_Cache_Budget(void)	const
+{
+	return( m_Cache_Budget >= 0 ? m_Cache_Budget : SG_Grid_Cache_Get_Budget() );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -328,6 +666,8 @@ bool CSG_Grid::_Cache_Create(const CSG_String &File, TSG_Data_Type Data_Type, sL
 
 	_Array_Destroy();
 
+	_Cache_Map_Create();	// falls back to stream based access, if the file cannot be mapped
+
 	return( true );
 }
 
@@ -363,6 +703,8 @@ bool CSG_Grid::_Cache_Create(void)	// create temporary cache file
 
 	_Array_Destroy();
 
+	_Cache_Map_Create();
+
 	return( true );
 }
 
@@ -371,7 +713,34 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 {
 	if( is_Cached() )
 	{
-		if( bMemory_Restore && _Array_Create() && !CACHE_FILE_SEEK(m_Cache_Stream, m_Cache_Offset, SEEK_SET) )
+		for(int y=0; bMemory_Restore && m_Cache_Source && !m_Cache_Map && y<Get_NY(); y++)
+		{
+			_Cache_Source_Fill(y);	// stream based restore reads the cache file directly
+		}
+
+		if( bMemory_Restore && m_Cache_Map )
+		{
+			if( _Array_Create() )
+			{
+				for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+				{
+					memcpy(m_Values[y], _Cache_Map_Get_Line(y), Get_nLineBytes());
+
+					if( m_Cache_bSwap )
+					{
+						char	*pValue	= (char *)m_Values[y];
+
+						for(int x=0; x<Get_NX(); x++, pValue+=Get_nValueBytes())
+						{
+							_Swap_Bytes(pValue, Get_nValueBytes());
+						}
+					}
+				}
+
+				SG_UI_Process_Set_Ready();
+			}
+		}
+		else if( bMemory_Restore && _Array_Create() && !CACHE_FILE_SEEK(m_Cache_Stream, m_Cache_Offset, SEEK_SET) )
 		{
 			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
 			{
@@ -392,6 +761,10 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 		}
 
 		//-------------------------------------------------
+		_Cache_Source_Destroy();
+
+		_Cache_Map_Destroy();
+
 		fclose(m_Cache_Stream);
 
 		m_Cache_Stream	= NULL;
@@ -408,6 +781,189 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// A temporary file cache can be backed by a tiled grid file
+// (*.sg-grd-t). Instead of decompressing the whole file when
+// loading it, each row of tiles is copied to the cache file,
+// when one of its cells is accessed for the first time.
+
+//---------------------------------------------------------
+typedef struct
+{
+	std::atomic<BYTE>	*bFilled;	// released after a row of tiles has been copied
+
+	CSG_Grid_File_Tiled	File;
+}
+TSG_Grid_Cache_Source;
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Source_Create(const CSG_String &File)
+{
+	_Cache_Source_Destroy();
+
+	if( !is_Cached() || !m_Cache_bTemp )
+	{
+		return( false );
+	}
+
+	TSG_Grid_Cache_Source	*pSource	= new TSG_Grid_Cache_Source;
+
+	if( !pSource->File.Open(File) || pSource->File.Get_Info().m_Type != m_Type
+	||  !pSource->File.Get_Info().m_System.is_Equal(m_System) )
+	{
+		delete(pSource);
+
+		return( false );
+	}
+
+	pSource->bFilled	= new std::atomic<BYTE>[pSource->File.Get_NY_Tiles()];
+
+	for(int i=0; i<pSource->File.Get_NY_Tiles(); i++)
+	{
+		pSource->bFilled[i]	= 0;
+	}
+
+	m_Cache_Source	= pSource;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Source_Destroy(void)
+{
+	if( m_Cache_Source )
+	{
+		TSG_Grid_Cache_Source	*pSource	= (TSG_Grid_Cache_Source *)m_Cache_Source;
+
+		delete[](pSource->bFilled);
+
+		delete(pSource);
+
+		m_Cache_Source	= NULL;
+	}
+}
+
+//---------------------------------------------------------
+/**
+  * Copies all rows, which have not been accessed yet, from the
+  * tiled source file to the cache and detaches the source, e.g.
+  * before the source file itself is overwritten. Returns false,
+  * if any of the rows could not be read.
+*/
+bool CSG_Grid::_Cache_Source_Detach(void)
+{
+	bool	bOkay	= true;
+
+	if( m_Cache_Source )
+	{
+		int	Tile_Size	= ((TSG_Grid_Cache_Source *)m_Cache_Source)->File.Get_Tile_Size();
+
+		for(int y=0; y<Get_NY(); y+=Tile_Size)
+		{
+			if( !_Cache_Source_Fill(y) )
+			{
+				bOkay	= false;
+			}
+		}
+
+		_Cache_Source_Destroy();
+	}
+
+	return( bOkay );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Source_Fill(int y)	const
+{
+	TSG_Grid_Cache_Source	&Source	= *(TSG_Grid_Cache_Source *)m_Cache_Source;
+
+	int	iTile	= y / Source.File.Get_Tile_Size();
+
+	if( Source.bFilled[iTile].load(std::memory_order_acquire) )
+	{
+		return( true );
+	}
+
+	bool	bOkay	= true;
+
+	#pragma omp critical (SG_Grid_Cache_Source)
+	{
+		if( !Source.bFilled[iTile].load(std::memory_order_acquire) )
+		{
+			int	yFirst	= iTile * Source.File.Get_Tile_Size();
+			int	nLines	= M_GET_MIN(Source.File.Get_Tile_Size(), Get_NY() - yFirst);
+
+			CSG_Array	Lines(1, (sLong)nLines * Get_nLineBytes());
+
+			if( !Source.File.Read_Lines(yFirst, nLines, Lines.Get_Array()) )	// don't retry failed reads, mark these rows as no-data
+			{
+				bOkay	= false;
+
+				SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s, %s %d-%d]", _TL("failed to read tiled grid file"),
+					Get_Name(), _TL("rows"), yFirst + 1, yFirst + nLines
+				));
+
+				char	*pLine	= (char *)Lines.Get_Array();	double	NoData	= Get_NoData_Value();	// refers to the unscaled values, as they are stored
+
+				memset(pLine, 0, Get_nLineBytes());	// bit grids
+
+				for(int x=0; x<Get_NX(); x++)	// first line, then copied to the others
+				{
+					switch( m_Type )
+					{
+					case SG_DATATYPE_Byte  : ((BYTE   *)pLine)[x] = (BYTE  )NoData; break;
+					case SG_DATATYPE_Char  : ((char   *)pLine)[x] = (char  )NoData; break;
+					case SG_DATATYPE_Word  : ((WORD   *)pLine)[x] = (WORD  )NoData; break;
+					case SG_DATATYPE_Short : ((short  *)pLine)[x] = (short )NoData; break;
+					case SG_DATATYPE_DWord : ((DWORD  *)pLine)[x] = (DWORD )NoData; break;
+					case SG_DATATYPE_Int   : ((int    *)pLine)[x] = (int   )NoData; break;
+					case SG_DATATYPE_ULong : ((uLong  *)pLine)[x] = (uLong )NoData; break;
+					case SG_DATATYPE_Long  : ((sLong  *)pLine)[x] = (sLong )NoData; break;
+					case SG_DATATYPE_Float : ((float  *)pLine)[x] = (float )NoData; break;
+					case SG_DATATYPE_Double: ((double *)pLine)[x] = (double)NoData; break;
+					default                : break;
+					}
+				}
+
+				for(int i=1; i<nLines; i++)
+				{
+					memcpy(pLine + (size_t)i * Get_nLineBytes(), pLine, Get_nLineBytes());
+				}
+			}
+
+			for(int i=0; i<nLines; i++)	// the temporary cache file is neither flipped nor swapped
+			{
+				char	*pLine	= (char *)Lines.Get_Array() + (size_t)i * Get_nLineBytes();
+
+				if( m_Cache_Map )
+				{
+					TSG_Grid_Cache_Map	&Map	= *(TSG_Grid_Cache_Map *)m_Cache_Map;
+
+					if( Map.nResident_Max > 0 )	// count the written tile against the budget
+					{
+						SG_Grid_Cache_Map_Touch(Map, (yFirst + i) / Map.nTile_Rows);
+					}
+
+					memcpy(Map.pData + (size_t)(yFirst + i) * Get_nLineBytes(), pLine, Get_nLineBytes());
+				}
+				else if( !CACHE_FILE_SEEK(m_Cache_Stream, m_Cache_Offset + (sLong)(yFirst + i) * Get_nLineBytes(), SEEK_SET) )
+				{
+					fwrite(pLine, 1, Get_nLineBytes(), m_Cache_Stream);
+				}
+			}
+
+			Source.bFilled[iTile].store(1, std::memory_order_release);
+		}
+	}
+
+	return( bOkay );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -415,6 +971,19 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 //---------------------------------------------------------
 void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
 {
+	if( m_Type == SG_DATATYPE_Bit )
+	{
+		if( m_Cache_Map && !((TSG_Grid_Cache_Map *)m_Cache_Map)->bReadOnly )
+		{
+			char	*pByte	= _Cache_Map_Get_Line(y) + x / 8;
+
+			*pByte	= Value != 0.0 ? *pByte | m_Bitmask[x % 8] : *pByte & (~m_Bitmask[x % 8]);
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
 	char	Buffer[8];
 
 	switch( m_Type )
@@ -428,6 +997,7 @@ void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
 	case SG_DATATYPE_DWord : (*(DWORD  *)Buffer) = SG_ROUND_TO_DWORD(Value); break;
 	case SG_DATATYPE_Int   : (*(int    *)Buffer) = SG_ROUND_TO_INT  (Value); break;
 	case SG_DATATYPE_Long  : (*(sLong  *)Buffer) = SG_ROUND_TO_SLONG(Value); break;
+	case SG_DATATYPE_ULong : (*(uLong  *)Buffer) = SG_ROUND_TO_ULONG(Value); break;
 
 	default:
 		return;
@@ -438,48 +1008,150 @@ void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
 		_Swap_Bytes(Buffer, Get_nValueBytes());
 	}
 
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
+	if( m_Cache_Map )
+	{
+		if( !((TSG_Grid_Cache_Map *)m_Cache_Map)->bReadOnly )
+		{
+			memcpy(_Cache_Map_Get_Line(y) + x * m_nBytes_Value, Buffer, m_nBytes_Value);
+		}
+	}
+	else
 	{
-		fwrite(Buffer, 1, Get_nValueBytes(), m_Cache_Stream);
+		if( m_Cache_Source )
+		{
+			_Cache_Source_Fill(y);
+		}
+
+		if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
+		{
+			fwrite(Buffer, 1, Get_nValueBytes(), m_Cache_Stream);
+		}
 	}
 }
 
 //---------------------------------------------------------
 double CSG_Grid::_Cache_Get_Value(int x, int y) const
 {
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
+	char	Buffer[8];
+
+	if( m_Cache_Map )
 	{
-		char	Buffer[8];
+		char	*pLine	= _Cache_Map_Get_Line(y);
 
-		if( fread(Buffer, 1, Get_nValueBytes(), m_Cache_Stream) == (size_t)Get_nValueBytes() )
+		if( m_Type == SG_DATATYPE_Bit )
 		{
-			switch( m_Type )
-			{
-			case SG_DATATYPE_Byte  : return( (double)(*(BYTE   *)Buffer) );
-			case SG_DATATYPE_Char  : return( (double)(*(char   *)Buffer) );
-			case SG_DATATYPE_Word  : return( (double)(*(WORD   *)Buffer) );
-			case SG_DATATYPE_Short : return( (double)(*(short  *)Buffer) );
-			case SG_DATATYPE_DWord : return( (double)(*(DWORD  *)Buffer) );
-			case SG_DATATYPE_Int   : return( (double)(*(int    *)Buffer) );
-			case SG_DATATYPE_Long  : return( (double)(*(sLong  *)Buffer) );
-			case SG_DATATYPE_Float : return( (double)(*(float  *)Buffer) );
-			case SG_DATATYPE_Double: return( (double)(*(double *)Buffer) );
-
-			default:
-				break;
-			}
+			return( (pLine[x / 8] & m_Bitmask[x % 8]) == 0 ? 0.0 : 1.0 );
+		}
 
-			if( m_Cache_bSwap )
-			{
-				_Swap_Bytes(Buffer, Get_nValueBytes());
-			}
+		memcpy(Buffer, pLine + x * m_nBytes_Value, m_nBytes_Value);
+	}
+	else
+	{
+		if( m_Cache_Source )
+		{
+			_Cache_Source_Fill(y);
+		}
+
+		if( m_Type == SG_DATATYPE_Bit || CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET)
+		||  fread(Buffer, 1, Get_nValueBytes(), m_Cache_Stream) != (size_t)Get_nValueBytes() )
+		{
+			return( 0.0 );
 		}
 	}
 
+	if( m_Cache_bSwap )
+	{
+		_Swap_Bytes(Buffer, Get_nValueBytes());
+	}
+
+	switch( m_Type )
+	{
+	case SG_DATATYPE_Byte  : return( (double)(*(BYTE   *)Buffer) );
+	case SG_DATATYPE_Char  : return( (double)(*(char   *)Buffer) );
+	case SG_DATATYPE_Word  : return( (double)(*(WORD   *)Buffer) );
+	case SG_DATATYPE_Short : return( (double)(*(short  *)Buffer) );
+	case SG_DATATYPE_DWord : return( (double)(*(DWORD  *)Buffer) );
+	case SG_DATATYPE_Int   : return( (double)(*(int    *)Buffer) );
+	case SG_DATATYPE_Long  : return( (double)(*(sLong  *)Buffer) );
+	case SG_DATATYPE_ULong : return( (double)(*(uLong  *)Buffer) );
+	case SG_DATATYPE_Float : return( (double)(*(float  *)Buffer) );
+	case SG_DATATYPE_Double: return( (double)(*(double *)Buffer) );
+
+	default:
+		break;
+	}
+
 	return( 0.0 );
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Row Data						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Returns a pointer to the memory of row y, if the grid is held
+  * in memory or its file cache is memory mapped and needs no byte
+  * swapping. The row holds Get_NX() unscaled values of the grid's
+  * data type. Returns NULL for bit grids and stream based caches.
+  * @see CSG_Grid_View
+*/
+const void * CSG_Grid::Get_Row_Data(int y)	const
+{
+	if( y >= 0 && y < Get_NY() && m_Type != SG_DATATYPE_Bit )
+	{
+		if( !is_Cached() )
+		{
+			return( m_Values ? m_Values[y] : NULL );
+		}
+
+		if( m_Cache_Map && !m_Cache_bSwap )
+		{
+			return( _Cache_Map_Get_Line(y) );
+		}
+	}
+
+	return( NULL );
+}
+
+//---------------------------------------------------------
+/**
+  * Same as the const version, but returns NULL if the file cache
+  * has been mapped read only. Changes made through the returned
+  * pointer bypass Set_Value(), so call Set_Modified() afterwards.
+*/
+void * CSG_Grid::Get_Row_Data(int y)
+{
+	if( m_Cache_Map && ((TSG_Grid_Cache_Map *)m_Cache_Map)->bReadOnly )
+	{
+		return( NULL );
+	}
+
+	return( (void *)((const CSG_Grid *)this)->Get_Row_Data(y) );
+}
+
+//---------------------------------------------------------
+/**
+  * Returns the address of the first row, if the grid is held in
+  * memory and is not a bit grid. All rows are then stored in one
+  * contiguous block, row y starting y * Get_nLineBytes() bytes
+  * after the returned address. Returns NULL otherwise. Allows
+  * sharing the grid's memory without copying, e.g. with NumPy.
+*/
+void * CSG_Grid::Get_Data(void)	const
+{
+	if( !is_Cached() && m_Values && m_Type != SG_DATATYPE_Bit )
+	{
+		return( m_Values[0] );
+	}
+
+	return( NULL );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -1708,6 +1708,8 @@ bool CSG_Grids::On_Delete(void)
 //---------------------------------------------------------
 bool CSG_Grids::Load(const CSG_String &FileName, bool bLoadData)
 {
+	CSG_Profiler_Region Profile("load", FileName, "grid collection");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s: %s...", _TL("Loading grid collection"), FileName.c_str()), true);
@@ -1736,6 +1738,8 @@ bool CSG_Grids::Load(const CSG_String &FileName, bool bLoadData)
 //---------------------------------------------------------
 bool CSG_Grids::Save(const CSG_String &FileName, int Format)
 {
+	CSG_Profiler_Region Profile("save", FileName, "grid collection");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("grid collection"), FileName.c_str()), true);
 
 	if( Format == GRIDS_FILE_FORMAT_Undefined )
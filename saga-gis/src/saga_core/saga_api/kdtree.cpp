@@ -59,11 +59,16 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// All adaptors copy the point coordinates to one contiguous
+// array at construction time, so that tree building and
+// searching access coordinates through a non-virtual inline
+// function instead of resolving the data source for each access.
 //---------------------------------------------------------
 class CSG_KDTree_Adaptor
 {
 public:
-	CSG_KDTree_Adaptor(void) {	m_pData = NULL; m_zScale = 1.;	}
+	CSG_KDTree_Adaptor(void) {	m_pData = NULL; m_nPoints = 0; m_nDimensions = 0;	}
 	virtual ~CSG_KDTree_Adaptor(void) {}
 
 	typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, CSG_KDTree_Adaptor>,
@@ -73,24 +78,37 @@ public:
 		CSG_KDTree_Adaptor, 3> kd_tree_3d;
 
 	//-----------------------------------------------------
-	virtual size_t				kdtree_get_point_count	(void)								const	= 0;
-	virtual double				kdtree_get_pt			(const size_t Index, int Dimension)	const	= 0;
+	inline size_t				kdtree_get_point_count	(void)								const
+	{
+		return( m_nPoints );
+	}
 
-	template <class BBOX> bool	kdtree_get_bbox			(BBOX &bb)	const
+	inline double				kdtree_get_pt			(const size_t Index, int Dimension)	const
 	{
-		double Extent[3][2];
+		return( m_pXYZ[Index * m_nDimensions + Dimension] );
+	}
 
-		if( !Get_Extent(Extent) )
+	template <class BBOX> bool	kdtree_get_bbox			(BBOX &bb)	const
+	{
+		if( m_nPoints < 1 )
 		{
 			return( false );
 		}
 
-		bb[0].low = Extent[0][0]; bb[0].high = Extent[0][1];
-		bb[1].low = Extent[1][0]; bb[1].high = Extent[1][1];
+		for(int i=0; i<m_nDimensions && i<(int)bb.size(); i++)
+		{
+			bb[i].low = bb[i].high = m_pXYZ[i];
+		}
 
-		if( bb.size() > 2 )
+		for(size_t j=1; j<m_nPoints; j++)
 		{
-			bb[2].low = Extent[2][0]; bb[2].high = Extent[2][1];
+			const double *p = m_pXYZ + j * m_nDimensions;
+
+			for(int i=0; i<m_nDimensions && i<(int)bb.size(); i++)
+			{
+				if( bb[i].low  > p[i] ) { bb[i].low  = p[i]; } else
+				if( bb[i].high < p[i] ) { bb[i].high = p[i]; }
+			}
 		}
 
 		return( true );
@@ -102,109 +120,98 @@ public:
 
 protected:
 
-	double						m_zScale;
-
-	CSG_Data_Object				*m_pData;
+	int							m_nDimensions;
 
+	size_t						m_nPoints;
 
-	virtual bool				Get_Extent				(double Extent[3][2])	const	{	return( false );	}
+	double						*m_pXYZ;
 
-};
+	CSG_Vector					m_XYZ;
 
-//---------------------------------------------------------
-class CSG_KDTree_Adaptor_Points : public CSG_KDTree_Adaptor
-{
-public:
-	CSG_KDTree_Adaptor_Points(CSG_Shapes *pPoints, int zField = -1, double zScale = 1.)
-	{
-		m_pData  = m_pPoints = pPoints;
-		m_zField = m_pPoints && zField < m_pPoints->Get_Count() ? zField : -1;
-		m_zScale = zScale;
-	}
+	CSG_Data_Object				*m_pData;
 
-	virtual ~CSG_KDTree_Adaptor_Points(void) {}
 
-	virtual size_t			kdtree_get_point_count	(void)	const
+	bool						_Create			(size_t nPoints, int nDimensions)
 	{
-		return( m_pPoints->Get_Count() );
-	}
+		m_nDimensions = nDimensions;
 
-	virtual double			kdtree_get_pt			(const size_t Index, int Dimension)	const
-	{
-		CSG_Shape *pPoint = m_pPoints->Get_Shape(Index);
+		if( nPoints > 0 && m_XYZ.Create(nPoints * nDimensions) )
+		{
+			m_nPoints = nPoints;
+		}
+		else
+		{
+			m_nPoints = 0;
+		}
 
-		if( Dimension == 0 ) { return( pPoint->Get_Point().x ); }
-		if( Dimension == 1 ) { return( pPoint->Get_Point().y ); }
-		if( Dimension == 2 ) { return( (m_zField < 0 ? pPoint->Get_Z() : pPoint->asDouble(m_zField)) * m_zScale); }
+		m_pXYZ = m_XYZ.Get_Data();
 
-		return( 0. );
+		return( m_nPoints > 0 );
 	}
 
+};
 
-protected:
-
-	int						m_zField;
+//---------------------------------------------------------
+class CSG_KDTree_Adaptor_Points : public CSG_KDTree_Adaptor
+{
+public:
+	CSG_KDTree_Adaptor_Points(CSG_Shapes *pPoints, int nDimensions = 3, int zField = -1, double zScale = 1.)
+	{
+		m_pData  = pPoints;
 
-	CSG_Shapes				*m_pPoints;
+		if( zField >= pPoints->Get_Field_Count() )
+		{
+			zField = -1;
+		}
 
+		if( _Create(pPoints->Get_Count(), nDimensions) )
+		{
+			#pragma omp parallel for
+			for(sLong i=0; i<pPoints->Get_Count(); i++)
+			{
+				CSG_Shape *pPoint = pPoints->Get_Shape(i); double *p = m_pXYZ + i * m_nDimensions;
 
-	virtual bool			Get_Extent				(double Extent[3][2])	const
-	{
-		Extent[0][0] = m_pPoints->Get_Extent().Get_XMin();
-		Extent[0][1] = m_pPoints->Get_Extent().Get_XMax();
-		Extent[1][0] = m_pPoints->Get_Extent().Get_YMin();
-		Extent[1][1] = m_pPoints->Get_Extent().Get_YMax();
-		Extent[2][0] = m_zField < 0 ? m_pPoints->Get_ZMin() : m_pPoints->Get_Minimum(m_zField);
-		Extent[2][1] = m_zField < 0 ? m_pPoints->Get_ZMax() : m_pPoints->Get_Maximum(m_zField);
+				p[0] = pPoint->Get_Point().x;
+				p[1] = pPoint->Get_Point().y;
 
-		return( true );
+				if( m_nDimensions > 2 )
+				{
+					p[2] = zScale * (zField < 0 ? pPoint->Get_Z() : pPoint->asDouble(zField));
+				}
+			}
+		}
 	}
 
+	virtual ~CSG_KDTree_Adaptor_Points(void) {}
+
 };
 
 //---------------------------------------------------------
 class CSG_KDTree_Adaptor_PointCloud : public CSG_KDTree_Adaptor
 {
 public:
-	CSG_KDTree_Adaptor_PointCloud(CSG_PointCloud *pPoints, double zScale = 1.)
-	{
-		m_pData  = m_pPoints = pPoints;
-		m_zScale = zScale;
-	}
-
-	virtual ~CSG_KDTree_Adaptor_PointCloud(void) {}
-
-	virtual size_t			kdtree_get_point_count	(void)	const
+	CSG_KDTree_Adaptor_PointCloud(CSG_PointCloud *pPoints, int nDimensions = 3, double zScale = 1.)
 	{
-		return( m_pPoints->Get_Count() );
-	}
+		m_pData  = pPoints;
 
-	virtual double			kdtree_get_pt			(const size_t Index, int Dimension)	const
-	{
-		if( Dimension == 0 ) { return( m_pPoints->Get_X((sLong)Index)            ); }
-		if( Dimension == 1 ) { return( m_pPoints->Get_Y((sLong)Index)            ); }
-		if( Dimension == 2 ) { return( m_pPoints->Get_Z((sLong)Index) * m_zScale ); }
+		if( _Create(pPoints->Get_Count(), nDimensions) )
+		{
+			for(int i=0; i<m_nDimensions; i++)
+			{
+				pPoints->Get_Field_Values(i, m_pXYZ + i, 0, -1, m_nDimensions);
+			}
 
-		return( 0. );
+			if( m_nDimensions > 2 && zScale != 1. )
+			{
+				for(sLong i=2; i<m_XYZ.Get_Size(); i+=m_nDimensions)
+				{
+					m_XYZ[i] *= zScale;
+				}
+			}
+		}
 	}
 
-
-protected:
-
-	CSG_PointCloud			*m_pPoints;
-
-
-	virtual bool			Get_Extent				(double Extent[3][2])	const
-	{
-		Extent[0][0] = m_pPoints->Get_Extent().Get_XMin();
-		Extent[0][1] = m_pPoints->Get_Extent().Get_XMax();
-		Extent[1][0] = m_pPoints->Get_Extent().Get_YMin();
-		Extent[1][1] = m_pPoints->Get_Extent().Get_YMax();
-		Extent[2][0] = m_pPoints->             Get_ZMin();
-		Extent[2][1] = m_pPoints->             Get_ZMax();
-
-		return( true );
-	}
+	virtual ~CSG_KDTree_Adaptor_PointCloud(void) {}
 
 };
 
@@ -212,31 +219,20 @@ protected:
 class CSG_KDTree_Adaptor_Coordinates : public CSG_KDTree_Adaptor
 {
 public:
-	CSG_KDTree_Adaptor_Coordinates(const double **Points, size_t nPoints)
+	CSG_KDTree_Adaptor_Coordinates(const double **Points, size_t nPoints, int nDimensions)
 	{
-		m_Points  = Points;
-		m_nPoints = nPoints;
+		if( _Create(nPoints, nDimensions) )
+		{
+			#pragma omp parallel for
+			for(sLong i=0; i<(sLong)nPoints; i++)
+			{
+				memcpy(m_pXYZ + i * m_nDimensions, Points[i], m_nDimensions * sizeof(double));
+			}
+		}
 	}
 
 	virtual ~CSG_KDTree_Adaptor_Coordinates(void) {}
 
-	virtual size_t			kdtree_get_point_count	(void)	const
-	{
-		return( m_nPoints );
-	}
-
-	virtual double			kdtree_get_pt			(const size_t Index, int Dimension)	const
-	{
-		return( m_Points[Index][Dimension] );
-	}
-
-
-protected:
-
-	size_t					m_nPoints;
-
-	const double			**m_Points;
-
 };
 
 
@@ -304,6 +300,72 @@ CSG_Shape * CSG_KDTree::Get_Match_Shape(size_t i) const
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Collects the 'Count' nearest neighbours, restricted to a
+// search radius if 'Radius' is greater than zero. The radius
+// is set as initial worst distance of the result set, so that
+// the tree is only descended into cells within the radius and
+// no intermediate list of all points within the radius is
+// built. Results are written to the supplied buffers, which
+// must provide space for 'Count' elements, and are sorted by
+// distance.
+//---------------------------------------------------------
+template <class TTree, typename TIndex>
+size_t SG_KDTree_Get_Nearest_Points(const TTree *pTree, const double *Coordinate, size_t Count, double Radius, TIndex *Indices, double *Distances)
+{
+	if( !pTree || Count < 1 )
+	{
+		return( 0 );
+	}
+
+	nanoflann::KNNResultSet<double, TIndex> Result(Count);
+
+	Result.init(Indices, Distances);
+
+	if( Radius > 0. )
+	{
+		Distances[Count - 1] = Radius*Radius;
+	}
+
+	pTree->findNeighbors(Result, Coordinate, nanoflann::SearchParams());
+
+	Count = Result.size();
+
+	for(size_t i=0; i<Count; i++)
+	{
+		Distances[i] = sqrt(Distances[i]);
+	}
+
+	return( Count );
+}
+
+//---------------------------------------------------------
+template <class TTree>
+size_t SG_KDTree_Get_Nearest_Points(const TTree *pTree, int nDimensions, const double *Coordinates, size_t nQueries, size_t Count, double Radius, size_t *Indices, double *Distances, size_t *nMatches)
+{
+	size_t nTotal = 0;
+
+	#pragma omp parallel for reduction(+:nTotal)
+	for(sLong i=0; i<(sLong)nQueries; i++)
+	{
+		size_t n = SG_KDTree_Get_Nearest_Points(pTree, Coordinates + i * nDimensions, Count, Radius, Indices + i * Count, Distances + i * Count);
+
+		if( nMatches )
+		{
+			nMatches[i] = n;
+		}
+
+		nTotal += n;
+	}
+
+	return( nTotal );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -374,7 +436,7 @@ bool CSG_KDTree_2D::Create(CSG_Shapes *pPoints, int Field)
 			return( false );
 		}
 
-		m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(m_Points, m_Points.Get_NRows());
+		m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(m_Points, m_Points.Get_NRows(), 2);
 		m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_2d(2, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 		((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->buildIndex();
@@ -388,7 +450,7 @@ bool CSG_KDTree_2D::Create(CSG_Shapes *pPoints, int Field)
 		return( false );
 	}
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_Points(pPoints);
+	m_pAdaptor = new CSG_KDTree_Adaptor_Points(pPoints, 2);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_2d(2, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->buildIndex();
@@ -417,7 +479,7 @@ bool CSG_KDTree_2D::Create(CSG_PointCloud *pPoints)
 
 	Destroy();
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_PointCloud(pPoints);
+	m_pAdaptor = new CSG_KDTree_Adaptor_PointCloud(pPoints, 2);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_2d(2, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->buildIndex();
@@ -470,7 +532,7 @@ bool CSG_KDTree_2D::Create(const double **Points, size_t nPoints)
 
 	Destroy();
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(Points, nPoints);
+	m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(Points, nPoints, 2);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_2d(2, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->buildIndex();
@@ -505,51 +567,39 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, dou
 //---------------------------------------------------------
 size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances)
 {
-	if( Radius > 0. )
+	if( Count > 0 )
 	{
-		nanoflann::SearchParams SearchParams;
-
-		SearchParams.sorted = Count > 0;
-
-		std::vector<std::pair<size_t, double>> Matches;
-
-		((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->radiusSearch(Coordinate, Radius*Radius, Matches, SearchParams);
-
-		if( Count == 0 || Count > Matches.size() )
-		{
-			Count = Matches.size();
-		}
-
 		Indices  .Create(Count);
 		Distances.Create(Count);
 
-		for(size_t i=0; i<Count; i++)
+		Count = SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree, Coordinate, Count, Radius, Indices.Get_Array(), Distances.Get_Data());
+
+		if( Count < (size_t)Indices.Get_Size() )
 		{
-			Indices  [i] = (int)Matches[i]. first ;
-			Distances[i] = sqrt(Matches[i].second);
+			Indices  .Set_Array(Count);
+			Distances.Set_Rows (Count);
 		}
 	}
-	else if( Count > 0 )
+	else if( Radius > 0. )
 	{
-		size_t *_Indices = new size_t[Count];
+		nanoflann::SearchParams SearchParams;
 
-		Distances.Create(Count);
+		SearchParams.sorted = false;
 
-		Count = Get_Nearest_Points(Coordinate, Count, _Indices, Distances.Get_Data());
+		std::vector<std::pair<size_t, double>> Matches;
 
-		if( Count < (size_t)Distances.Get_N() )
-		{
-			Distances.Set_Rows(Count);
-		}
+		((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->radiusSearch(Coordinate, Radius*Radius, Matches, SearchParams);
+
+		Count = Matches.size();
 
-		Indices.Create(Count);
+		Indices  .Create(Count);
+		Distances.Create(Count);
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices[i] = (int)(_Indices[i]);
+			Indices  [i] = (sLong)Matches[i]. first ;
+			Distances[i] =   sqrt(Matches[i].second);
 		}
-
-		delete[](_Indices);
 	}
 
 	return( Count );
@@ -558,14 +608,39 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, dou
 //---------------------------------------------------------
 size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, size_t *Indices, double *Distances)
 {
-	Count = ((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->knnSearch(Coordinate, Count, Indices, Distances);
-		
-	for(size_t i=0; i<Count; i++)
-	{
-		Distances[i] = sqrt(Distances[i]);
-	}
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree, Coordinate, Count, 0., Indices, Distances) );
+}
 
-	return( Count );
+//---------------------------------------------------------
+/**
+* Finds the 'Count' nearest points within the given search
+* radius (no radius restriction if 'Radius' is not greater than
+* zero). Indices and distances are written to the supplied
+* arrays, which must provide space for 'Count' elements. Nothing
+* is allocated, so this is the version of choice for repeated
+* queries with per-thread buffers.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, double Radius, size_t *Indices, double *Distances)
+{
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree, Coordinate, Count, Radius, Indices, Distances) );
+}
+
+//---------------------------------------------------------
+/**
+* Batch version answering 'nQueries' queries at once, e.g. for
+* all cells of an output grid row. 'Coordinates' provides the
+* query coordinates point by point (x, y). The results of
+* the i-th query are stored at 'Indices[i * Count]' and
+* 'Distances[i * Count]', which both must provide space for
+* 'nQueries * Count' elements. If not NULL, 'nMatches' receives
+* the number of points found for each query. Queries are processed
+* in parallel. Returns the total number of points found.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_2D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, size_t Count, double Radius, size_t *Indices, double *Distances, size_t *nMatches)
+{
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree, 2, Coordinates, nQueries, Count, Radius, Indices, Distances, nMatches) );
 }
 
 //---------------------------------------------------------
@@ -658,6 +733,11 @@ size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count,
 	double c[2]; c[0] = x; c[1] = y; return( Get_Nearest_Points(c, Count, Indices, Distances) );
 }
 
+size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, double Radius, size_t *Indices, double *Distances)
+{
+	double c[2]; c[0] = x; c[1] = y; return( Get_Nearest_Points(c, Count, Radius, Indices, Distances) );
+}
+
 bool        CSG_KDTree_2D::Get_Nearest_Point(double x, double y, size_t &Index, double &Distance)
 {
 	double c[2]; c[0] = x; c[1] = y; return( Get_Nearest_Point(c, Index, Distance) );
@@ -759,7 +839,7 @@ bool CSG_KDTree_3D::Create(CSG_Shapes *pPoints, int Field, int zField, double zS
 			return( false );
 		}
 
-		m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(m_Points, m_Points.Get_NRows());
+		m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(m_Points, m_Points.Get_NRows(), 3);
 		m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_3d(3, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 		((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->buildIndex();
@@ -773,7 +853,7 @@ bool CSG_KDTree_3D::Create(CSG_Shapes *pPoints, int Field, int zField, double zS
 		return( false );
 	}
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_Points(pPoints, zField, zScale);
+	m_pAdaptor = new CSG_KDTree_Adaptor_Points(pPoints, 3, zField, zScale);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_3d(3, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->buildIndex();
@@ -798,7 +878,7 @@ bool CSG_KDTree_3D::Create(CSG_PointCloud *pPoints)
 
 	Destroy();
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_PointCloud(pPoints);
+	m_pAdaptor = new CSG_KDTree_Adaptor_PointCloud(pPoints, 3);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_3d(3, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->buildIndex();
@@ -851,7 +931,7 @@ bool CSG_KDTree_3D::Create(const double **Points, size_t nPoints)
 
 	Destroy();
 
-	m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(Points, nPoints);
+	m_pAdaptor = new CSG_KDTree_Adaptor_Coordinates(Points, nPoints, 3);
 	m_pKDTree  = new CSG_KDTree_Adaptor::kd_tree_3d(3, *m_pAdaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
 
 	((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->buildIndex();
@@ -886,51 +966,39 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, dou
 //---------------------------------------------------------
 size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances)
 {
-	if( Radius > 0. )
+	if( Count > 0 )
 	{
-		nanoflann::SearchParams SearchParams;
-
-		SearchParams.sorted = Count > 0;
-
-		std::vector<std::pair<size_t, double>> Matches;
-
-		((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->radiusSearch(Coordinate, Radius*Radius, Matches, SearchParams);
-
-		if( Count == 0 || Count > Matches.size() )
-		{
-			Count = Matches.size();
-		}
-
 		Indices  .Create(Count);
 		Distances.Create(Count);
 
-		for(size_t i=0; i<Count; i++)
+		Count = SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree, Coordinate, Count, Radius, Indices.Get_Array(), Distances.Get_Data());
+
+		if( Count < (size_t)Indices.Get_Size() )
 		{
-			Indices  [i] = (int)Matches[i]. first ;
-			Distances[i] = sqrt(Matches[i].second);
+			Indices  .Set_Array(Count);
+			Distances.Set_Rows (Count);
 		}
 	}
-	else if( Count > 0 )
+	else if( Radius > 0. )
 	{
-		size_t *_Indices = new size_t[Count];
+		nanoflann::SearchParams SearchParams;
 
-		Distances.Create(Count);
+		SearchParams.sorted = false;
+
+		std::vector<std::pair<size_t, double>> Matches;
 
-		Count = Get_Nearest_Points(Coordinate, Count, _Indices, Distances.Get_Data());
+		((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->radiusSearch(Coordinate, Radius*Radius, Matches, SearchParams);
 
-		if( Count < (size_t)Distances.Get_N() )
-		{
-			Distances.Set_Rows(Count);
-		}
+		Count = Matches.size();
 
-		Indices.Create(Count);
+		Indices  .Create(Count);
+		Distances.Create(Count);
 
 		for(size_t i=0; i<Count; i++)
 		{
-			Indices[i] = (int)(_Indices[i]);
+			Indices  [i] = (sLong)Matches[i]. first ;
+			Distances[i] =   sqrt(Matches[i].second);
 		}
-
-		delete[](_Indices);
 	}
 
 	return( Count );
@@ -939,14 +1007,39 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, dou
 //---------------------------------------------------------
 size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, size_t *Indices, double *Distances)
 {
-	Count = ((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->knnSearch(Coordinate, Count, Indices, Distances);
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree, Coordinate, Count, 0., Indices, Distances) );
+}
 
-	for(size_t i=0; i<Count; i++)
-	{
-		Distances[i] = sqrt(Distances[i]);
-	}
+//---------------------------------------------------------
+/**
+* Finds the 'Count' nearest points within the given search
+* radius (no radius restriction if 'Radius' is not greater than
+* zero). Indices and distances are written to the supplied
+* arrays, which must provide space for 'Count' elements. Nothing
+* is allocated, so this is the version of choice for repeated
+* queries with per-thread buffers.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, double Radius, size_t *Indices, double *Distances)
+{
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree, Coordinate, Count, Radius, Indices, Distances) );
+}
 
-	return( Count );
+//---------------------------------------------------------
+/**
+* Batch version answering 'nQueries' queries at once, e.g. for
+* all cells of an output grid row. 'Coordinates' provides the
+* query coordinates point by point (x, y, z). The results of
+* the i-th query are stored at 'Indices[i * Count]' and
+* 'Distances[i * Count]', which both must provide space for
+* 'nQueries * Count' elements. If not NULL, 'nMatches' receives
+* the number of points found for each query. Queries are processed
+* in parallel. Returns the total number of points found.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_3D::Get_Nearest_Points(const double *Coordinates, size_t nQueries, size_t Count, double Radius, size_t *Indices, double *Distances, size_t *nMatches)
+{
+	return( SG_KDTree_Get_Nearest_Points((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree, 3, Coordinates, nQueries, Count, Radius, Indices, Distances, nMatches) );
 }
 
 //---------------------------------------------------------
@@ -1039,6 +1132,11 @@ size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size
 	double c[3]; c[0] = x; c[1] = y; c[2] = z; return( Get_Nearest_Points(c, Count, Indices, Distances) );
 }
 
+size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, double Radius, size_t *Indices, double *Distances)
+{
+	double c[3]; c[0] = x; c[1] = y; c[2] = z; return( Get_Nearest_Points(c, Count, Radius, Indices, Distances) );
+}
+
 bool        CSG_KDTree_3D::Get_Nearest_Point(double x, double y, double z, size_t &Index, double &Distance)
 {
 	double c[3]; c[0] = x; c[1] = y; c[2] = z; return( Get_Nearest_Point(c, Index, Distance) );
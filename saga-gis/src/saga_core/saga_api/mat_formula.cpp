@@ -88,6 +88,8 @@
 //---------------------------------------------------------
 #define GET_VALUE_BUFSIZE	500
 
+#define GET_VALUES_BLOCK	256
+
 //---------------------------------------------------------
 #define EPSILON				1e-9
 
@@ -653,6 +655,232 @@ double CSG_Formula::_Get_Value(const double *Parameters, TSG_Formula func) const
 } 
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Evaluates the formula for Count sets of variables at once.
+// Values[i] points to Count values for variable 'a' + i. If
+// Values[i] is NULL (or i >= nValues) the scalar set with
+// Set_Variable() is used instead. The byte code is walked
+// once per block of GET_VALUES_BLOCK elements, each operator
+// being applied as a plain loop over the whole block, which
+// removes the interpreter overhead per element and lets the
+// compiler vectorise the arithmetic. Results are identical
+// to those of Get_Value().
+//---------------------------------------------------------
+bool CSG_Formula::Get_Values(const double **Values, int nValues, double *Results, sLong Count) const
+{
+	int nStack = _Get_Stack_Size();
+
+	if( nStack < 1 || !Results || Count < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Array Stack(sizeof(double), (sLong)nStack * GET_VALUES_BLOCK);
+
+	if( !Stack.Get_Array() )
+	{
+		return( false );
+	}
+
+	for(sLong i=0; i<Count; i+=GET_VALUES_BLOCK)
+	{
+		const double *Block[32];
+
+		for(int j=0; j<32; j++)
+		{
+			Block[j] = Values && j < nValues && Values[j] ? Values[j] + i : NULL;
+		}
+
+		if( !_Get_Values(Block, Results + i, (int)M_GET_MIN(GET_VALUES_BLOCK, Count - i), (double *)Stack.Get_Array()) )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_Formula::_Get_Stack_Size(void) const
+{
+	int n = 0, nMax = 0;
+
+	for(const char *function=m_Formula.code; function && *function; )
+	{
+		switch( *function++ )
+		{
+		case 'D': case 'V':
+			function++; n++;
+			break;
+
+		case 'M':
+			break;
+
+		case 'F':
+			n += 1 - m_Functions[*function++].nParameters;
+			break;
+
+		default:
+			n--;
+			break;
+		}
+
+		if( nMax < n )
+		{
+			nMax = n;
+		}
+	}
+
+	return( nMax );
+}
+
+//---------------------------------------------------------
+bool CSG_Formula::_Get_Values(const double **Values, double *Results, int n, double *Stack) const
+{
+	double *x, *y, *z, *bufp = Stack; // bufp points to the first free block on the stack
+
+	const char *function = m_Formula.code;
+
+	for( ; ; )
+	{
+		switch( *function++ )
+		{
+		case '\0':
+			memcpy(Results, Stack, n * sizeof(double));
+			return( true );
+
+		case 'D': {
+			double d = m_Formula.ctable[*function++];
+			for(int k=0; k<n; k++) { bufp[k] = d; }
+			bufp += GET_VALUES_BLOCK;
+			break; }
+
+		case 'V': {
+			int i = (*function++) - 'a';
+			if( Values[i] )
+			{
+				memcpy(bufp, Values[i], n * sizeof(double));
+			}
+			else
+			{
+				double d = m_Parameters[i];
+				for(int k=0; k<n; k++) { bufp[k] = d; }
+			}
+			bufp += GET_VALUES_BLOCK;
+			break; }
+
+		case 'M':
+			x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = -x[k]; }
+			break;
+
+		case '+':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] + x[k]; }
+			break;
+
+		case '-':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = x[k] - y[k]; }
+			break;
+
+		case '*':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = x[k] * y[k]; }
+			break;
+
+		case '/':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = x[k] / y[k]; }
+			break;
+
+		case '^':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = pow(x[k], y[k]); }
+			break;
+
+		case '=':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] == x[k] ? 1.0 : 0.0; }
+			break;
+
+		case '>':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] <  x[k] ? 1.0 : 0.0; }
+			break;
+
+		case '<':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] >  x[k] ? 1.0 : 0.0; }
+			break;
+
+		case '&':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] != 0.0 && x[k] != 0.0 ? 1.0 : 0.0; }
+			break;
+
+		case '|':
+			y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+			for(int k=0; k<n; k++) { x[k] = y[k] != 0.0 || x[k] != 0.0 ? 1.0 : 0.0; }
+			break;
+
+		case 'F': {
+			TSG_Formula_Function_1 f = m_Functions[*function].Function;
+
+			switch( m_Functions[*function++].nParameters )
+			{
+			case 0:
+				x = bufp; bufp += GET_VALUES_BLOCK;
+				for(int k=0; k<n; k++) { x[k] = ((TSG_Formula_Function_0)f)(); }
+				break;
+
+			case 1:
+				x = bufp - GET_VALUES_BLOCK;
+				if     ( f == (TSG_Formula_Function_1)fabs  ) { for(int k=0; k<n; k++) { x[k] = fabs(x[k]); } }
+				else if( f == (TSG_Formula_Function_1)sqrt  ) { for(int k=0; k<n; k++) { x[k] = sqrt(x[k]); } }
+				else if( f == (TSG_Formula_Function_1)f_sqr ) { for(int k=0; k<n; k++) { x[k] = x[k] * x[k]; } }
+				else if( f == (TSG_Formula_Function_1)f_int ) { for(int k=0; k<n; k++) { x[k] = (int)(x[k]); } }
+				else                                          { for(int k=0; k<n; k++) { x[k] = f(x[k]);     } }
+				break;
+
+			case 2: {
+				TSG_Formula_Function_2 f2 = (TSG_Formula_Function_2)f;
+				y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+				if     ( f2 == f_gt  ) { for(int k=0; k<n; k++) { x[k] = x[k] > y[k] ? 1.0 : 0.0; } }
+				else if( f2 == f_lt  ) { for(int k=0; k<n; k++) { x[k] = x[k] < y[k] ? 1.0 : 0.0; } }
+				else if( f2 == f_eq  ) { for(int k=0; k<n; k++) { x[k] = fabs(x[k] - y[k]) < EPSILON ? 1.0 : 0.0; } }
+				else if( f2 == f_min ) { for(int k=0; k<n; k++) { x[k] = x[k] < y[k] ? x[k] : y[k]; } }
+				else if( f2 == f_max ) { for(int k=0; k<n; k++) { x[k] = x[k] > y[k] ? x[k] : y[k]; } }
+				else if( f2 == f_and ) { for(int k=0; k<n; k++) { x[k] = x[k] != 0.0 && y[k] != 0.0 ? 1.0 : 0.0; } }
+				else if( f2 == f_or  ) { for(int k=0; k<n; k++) { x[k] = x[k] != 0.0 || y[k] != 0.0 ? 1.0 : 0.0; } }
+				else                   { for(int k=0; k<n; k++) { x[k] = f2(x[k], y[k]); } }
+				break; }
+
+			case 3: {
+				TSG_Formula_Function_3 f3 = (TSG_Formula_Function_3)f;
+				z = bufp -= GET_VALUES_BLOCK; y = bufp -= GET_VALUES_BLOCK; x = bufp - GET_VALUES_BLOCK;
+				if     ( f3 == f_ifelse ) { for(int k=0; k<n; k++) { x[k] = x[k] ? y[k] : z[k]; } }
+				else                      { for(int k=0; k<n; k++) { x[k] = f3(x[k], y[k], z[k]); } }
+				break; }
+
+			default:
+				return( false );	// _Set_Error(_TL("I2: too many parameters"));
+			}
+			break; }
+
+		default:
+			return( false );	// _Set_Error(_TL("I1: unrecognizable operator"));
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
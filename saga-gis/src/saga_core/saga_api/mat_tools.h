@@ -1886,6 +1886,8 @@ public:
 	double						Get_Value			(double *Values, int nValues)	const;
 	double						Get_Value			(const char *Arguments, ... )	const;
 
+	bool						Get_Values			(const double **Values, int nValues, double *Results, sLong Count)	const;
+
 	const char *				Get_Used_Variables	(void);
 
 
@@ -1938,6 +1940,9 @@ private:
 
 	double						_Get_Value			(const double *Parameters, TSG_Formula Function)	const;
 
+	int							_Get_Stack_Size		(void)	const;
+	bool						_Get_Values			(const double **Values, double *Results, int Count, double *Stack)	const;
+
 	int							_is_Operand			(char c);
 	int							_is_Operand_Code	(char c);
 	int							_is_Number			(char c);
@@ -65,6 +65,12 @@
 
 #define PC_GET_NBYTES(type)	(type == SG_DATATYPE_String ? PC_STR_NBYTES : type == SG_DATATYPE_Date ? PC_DAT_NBYTES : (int)SG_Data_Type_Get_Size(type))
 
+//---------------------------------------------------------
+#define PC_BLOCK_MIN_POINTS	256						// smallest number of point records allocated at once
+#define PC_BLOCK_MAX_BYTES	(64 * N_MEGABYTE_BYTES)	// storage blocks grow with the point count up to this size
+
+#define PC_FILE_BUFFER_BYTES	(4 * N_MEGABYTE_BYTES)	// point records are read and written in chunks of this size
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -148,6 +154,8 @@ bool CSG_PointCloud::Create(const char       *File) { return( Create(CSG_String(
 bool CSG_PointCloud::Create(const wchar_t    *File) { return( Create(CSG_String(File)) ); }
 bool CSG_PointCloud::Create(const CSG_String &File)
 {
+	CSG_Profiler_Region Profile("load", File, "point cloud");
+
 	return( _Load(File) );
 }
 
@@ -189,6 +197,7 @@ void CSG_PointCloud::_On_Construction(void)
 
 	m_Points       = NULL;
 	m_nRecords     = 0;
+	m_nCapacity    = 0;
 	m_nPointBytes  = 0;
 
 	m_Cursor       = NULL;
@@ -321,6 +330,8 @@ bool CSG_PointCloud::_Load(const CSG_String &File)
 //---------------------------------------------------------
 bool CSG_PointCloud::Save(const CSG_String &_File, int Format)
 {
+	CSG_Profiler_Region Profile("save", _File, "point cloud");
+
 	if( Format == POINTCLOUD_FILE_FORMAT_Undefined )
 	{
 		Format	= SG_File_Cmp_Extension(_File, "sg-pts-z")
@@ -442,6 +453,21 @@ bool CSG_PointCloud::Get_Header_Content(const CSG_String &File, CSG_MetaData &He
 
 //---------------------------------------------------------
 bool CSG_PointCloud::_Load(CSG_File &Stream)
+{
+	if( !_Load_Header(Stream) )
+	{
+		return( false );
+	}
+
+	Reserve((Stream.Length() - Stream.Tell()) / (m_nPointBytes - 1));
+
+	_Load_Points(Stream, -1, true);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::_Load_Header(CSG_File &Stream)
 {
 	if( !Stream.is_Reading() )
 	{
@@ -507,16 +533,64 @@ bool CSG_PointCloud::_Load(CSG_File &Stream)
 	}
 
 	//-----------------------------------------------------
-	sLong fLength = Stream.Length();
+	return( nPointBytes == m_nPointBytes - 1 );	// file and memory record layout must match (apart from the leading flag byte)
+}
 
-	while( _Inc_Array() && Stream.Read(m_Cursor + 1, nPointBytes) && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+//---------------------------------------------------------
+/**
+* Appends up to nPoints point records (all remaining, if nPoints
+* is less than zero) from the stream, which is expected to be
+* positioned at the begin of a point record. Records are read
+* in large chunks, not one by one. Returns the number of points
+* that have been read.
+*/
+//---------------------------------------------------------
+sLong CSG_PointCloud::_Load_Points(CSG_File &Stream, sLong nPoints, bool bProgress)
+{
+	int nPointBytes = m_nPointBytes - 1;
+
+	if( !Stream.is_Reading() || m_nFields < 1 || nPoints == 0 )
 	{
-		// nop
+		return( 0 );
 	}
 
-	_Dec_Array();
+	sLong nBuffer = M_GET_MAX(1, PC_FILE_BUFFER_BYTES / nPointBytes);
 
-	return( true );
+	if( nPoints > 0 && nBuffer > nPoints )
+	{
+		nBuffer = nPoints;
+	}
+
+	CSG_Array Buffer(nPointBytes, nBuffer); char *pBuffer = (char *)Buffer.Get_Array();
+
+	if( !pBuffer )
+	{
+		return( 0 );
+	}
+
+	//-----------------------------------------------------
+	sLong nRead = 0, fLength = bProgress ? Stream.Length() : 0;
+
+	while( nPoints < 0 || nRead < nPoints )
+	{
+		size_t n = Stream.Read(pBuffer, nPointBytes, (size_t)(nPoints < 0 ? nBuffer : M_GET_MIN(nBuffer, nPoints - nRead)));
+
+		char *pPoint = pBuffer;
+
+		for(size_t i=0; i<n && _Inc_Array(); i++, nRead++, pPoint+=nPointBytes)
+		{
+			memcpy(m_Cursor + 1, pPoint, nPointBytes);
+		}
+
+		if( n < 1 || (bProgress && !SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength)) )
+		{
+			break;
+		}
+	}
+
+	m_Cursor = NULL;
+
+	return( nRead );
 }
 
 //---------------------------------------------------------
@@ -545,9 +619,24 @@ bool CSG_PointCloud::_Save(CSG_File &Stream)
 
 	_Shape_Flush();
 
-	for(sLong i=0; i<m_nRecords && SG_UI_Process_Set_Progress(i, m_nRecords); i++)
+	//-----------------------------------------------------
+	sLong nBuffer = M_GET_MAX(1, PC_FILE_BUFFER_BYTES / nPointBytes);
+
+	CSG_Array Buffer(nPointBytes, M_GET_MIN(nBuffer, m_nRecords)); char *pBuffer = (char *)Buffer.Get_Array();
+
+	for(sLong i=0; i<m_nRecords && SG_UI_Process_Set_Progress(i, m_nRecords); )
 	{
-		Stream.Write(m_Points[i] + 1, nPointBytes);
+		sLong n = 0; char *pPoint = pBuffer;
+
+		for(; n<nBuffer && i<m_nRecords; n++, i++, pPoint+=nPointBytes)
+		{
+			memcpy(pPoint, m_Points[i] + 1, nPointBytes);
+		}
+
+		if( Stream.Write(pBuffer, nPointBytes, (size_t)n) != (size_t)n * nPointBytes )	// returns the number of bytes written
+		{
+			return( false );
+		}
 	}
 
 	return( true );
@@ -608,6 +697,8 @@ bool CSG_PointCloud::Assign(CSG_Data_Object *pObject)
 			_Add_Field(pPoints->m_Field_Name[iField]->c_str(), pPoints->m_Field_Type[iField]);
 		}
 
+		Reserve(pPoints->m_nRecords);
+
 		for(sLong i=0; i<pPoints->m_nRecords; i++)
 		{
 			if( _Inc_Array() )
@@ -694,7 +785,12 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 		m_nPointBytes = 1;
 	}
 
-	m_nFields++; m_nPointBytes += nFieldBytes;
+	if( !_Set_Point_Bytes(m_nPointBytes + nFieldBytes, Field < m_nFields ? m_Field_Offset[Field] : m_nPointBytes, nFieldBytes) )
+	{
+		return( false );
+	}
+
+	m_nFields++;
 
 	//-----------------------------------------------------
 	m_Field_Name   = (CSG_String            **)SG_Realloc(m_Field_Name  , m_nFields * sizeof(CSG_String            *));
@@ -718,22 +814,6 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 		m_Field_Offset[iField] = Offset; Offset+=m_Field_Size(iField);
 	}
 
-	//-----------------------------------------------------
-	int Offset = m_Field_Offset[Field], nMoveBytes = Field < m_nFields - 1 ? m_nPointBytes - m_Field_Offset[Field + 1] : 0;
-
-	#pragma omp parallel for
-	for(sLong i=0; i<m_nRecords; i++)
-	{
-		m_Points[i] = (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
-
-		if( nMoveBytes > 0 )
-		{
-			memmove(m_Points[i] + Offset + nFieldBytes, m_Points[i] + Offset, nMoveBytes);
-		}
-
-		memset(m_Points[i] + Offset, 0, nFieldBytes);
-	}
-
 	//-----------------------------------------------------
 	m_Shapes.Add_Field(Name, Type, Field);
 
@@ -756,22 +836,13 @@ bool CSG_PointCloud::Del_Field(int Index)
 	//-----------------------------------------------------
 	int nFieldBytes = PC_GET_NBYTES(m_Field_Type[Index]);
 
-	m_nFields--; m_nPointBytes -= nFieldBytes;
-
-	//-----------------------------------------------------
-	int Offset = m_Field_Offset[Index], nMoveBytes = Index < m_nFields ? (m_nPointBytes + nFieldBytes) - m_Field_Offset[Index + 1] : 0;
-
-	#pragma omp parallel for
-	for(sLong i=0; i<m_nRecords; i++)
+	if( !_Set_Point_Bytes(m_nPointBytes - nFieldBytes, m_Field_Offset[Index], -nFieldBytes) )
 	{
-		if( nMoveBytes > 0 )
-		{
-			memmove(m_Points[i] + Offset, m_Points[i] + Offset + nFieldBytes, nMoveBytes);
-		}
-
-		m_Points[i] = (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
+		return( false );
 	}
 
+	m_nFields--;
+
 	//-----------------------------------------------------
 	delete(m_Field_Name [Index]);
 	delete(m_Field_Stats[Index]);
@@ -1007,6 +1078,79 @@ bool CSG_PointCloud::_Get_Field_Value(char *pPoint, int iField, CSG_String &Valu
 	return( false );
 }
 
+//---------------------------------------------------------
+template <typename T>
+static void	PC_Set_Field_Values(char **Points, sLong nPoints, int Offset, const double *Values)
+{
+	#pragma omp parallel for
+	for(sLong i=0; i<nPoints; i++)
+	{
+		*((T *)(Points[i] + Offset)) = (T)Values[i];
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::Get_Field_Values(int iField, CSG_Vector &Values)	const
+{
+	if( iField < 0 || iField >= m_nFields || !Values.Create(m_nRecords) )
+	{
+		return( false );
+	}
+
+	double *pValues = Values.Get_Data();
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		pValues[i] = _Get_Field_Value(m_Points[i], iField);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::Set_Field_Values(int iField, const CSG_Vector &Values)
+{
+	if( iField < 0 || iField >= m_nFields || Values.Get_Size() != m_nRecords )
+	{
+		return( false );
+	}
+
+	const double *pValues = Values.Get_Data(); int Offset = m_Field_Offset[iField];
+
+	switch( m_Field_Type[iField] )
+	{
+	case SG_DATATYPE_Byte  : PC_Set_Field_Values<BYTE  >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Char  : PC_Set_Field_Values<char  >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Word  : PC_Set_Field_Values<WORD  >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Short : PC_Set_Field_Values<short >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_DWord : PC_Set_Field_Values<DWORD >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Int   : PC_Set_Field_Values<int   >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Long  : PC_Set_Field_Values<sLong >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_ULong : PC_Set_Field_Values<uLong >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Float : PC_Set_Field_Values<float >(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Double: PC_Set_Field_Values<double>(m_Points, m_nRecords, Offset, pValues); break;
+	case SG_DATATYPE_Color : PC_Set_Field_Values<DWORD >(m_Points, m_nRecords, Offset, pValues); break;
+	default:
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			_Set_Field_Value(m_Points[i], iField, pValues[i]);
+		}
+		break;
+	}
+
+	m_Field_Stats[iField]->Invalidate();
+
+	Set_Modified();
+
+	if( iField < 3 )
+	{
+		Set_Update_Flag();	// extent might have changed
+	}
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1109,6 +1253,58 @@ bool CSG_PointCloud::Add_Point(const CSG_Point_3D &Point)
 	return( Add_Point(Point.x, Point.y, Point.z) );
 }
 
+//---------------------------------------------------------
+/**
+* Appends a copy of the point with given index from the source
+* point cloud. Leading fields of the same type in both point clouds
+* share their byte offsets and are copied as one block, all other
+* fields are copied field by field. So a point is copied as a whole,
+* if the source's fields equal the first fields of this point cloud,
+* e.g. after fields have been appended to a copy of the source.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::Add_Point(CSG_PointCloud *pSource, sLong Index)
+{
+	if( !pSource || Index < 0 || Index >= pSource->m_nRecords || !_Inc_Array() )
+	{
+		return( false );
+	}
+
+	char *pPoint = pSource->m_Points[Index];
+
+	int nSame = 0;
+
+	while( nSame < m_nFields && nSame < pSource->m_nFields && m_Field_Type[nSame] == pSource->m_Field_Type[nSame] )
+	{
+		nSame++;
+	}
+
+	if( nSame > 0 )
+	{
+		memcpy(m_Cursor + 1, pPoint + 1, (nSame < pSource->m_nFields ? pSource->m_Field_Offset[nSame] : pSource->m_nPointBytes) - 1l);
+	}
+
+	for(int iField=nSame; iField<m_nFields && iField<pSource->m_nFields; iField++)
+	{
+		if( SG_Data_Type_is_Numeric(pSource->m_Field_Type[iField]) )
+		{
+			_Set_Field_Value(m_Cursor, iField, pSource->_Get_Field_Value(pPoint, iField));
+		}
+		else
+		{
+			CSG_String Value; pSource->_Get_Field_Value(pPoint, iField, Value);
+
+			_Set_Field_Value(m_Cursor, iField, Value.c_str());
+		}
+	}
+
+	Set_Modified();
+	Set_Update_Flag();
+	_Stats_Invalidate();
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Point(sLong Index)
 {
@@ -1145,16 +1341,19 @@ bool CSG_PointCloud::Del_Point(sLong Index)
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Points(void)
 {
-	for(sLong i=0; i<m_nRecords; i++)
+	for(sLong i=0; i<m_Blocks.Get_Size(); i++)
 	{
-		SG_Free(m_Points[i]);
+		SG_Free(m_Blocks[i]);
 	}
 
+	m_Blocks.Destroy();
+
 	m_Array_Points.Destroy();
 
-	m_nRecords = 0;
-	m_Points   = NULL;
-	m_Cursor   = NULL;
+	m_nRecords  = 0;
+	m_nCapacity = 0;
+	m_Points    = NULL;
+	m_Cursor    = NULL;
 
 	m_Selection.Set_Array(0);
 
@@ -1166,23 +1365,62 @@ bool CSG_PointCloud::Del_Points(void)
 }
 
 
+//---------------------------------------------------------
+/**
+* Like Del_Points(), but keeps the allocated storage for the
+* records to be added next.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::_Clear_Points(void)
+{
+	m_nRecords  = 0;
+	m_Cursor    = NULL;
+
+	m_Selection.Set_Array(0);
+
+	for(sLong i=0; i<m_Shapes.Get_Count(); i++)
+	{
+		m_Shapes[i].m_Index = -1;
+	}
+
+	Set_Modified();
+	Set_Update_Flag();
+	_Stats_Invalidate();
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
 //														 //
 ///////////////////////////////////////////////////////////
 
+// Point records are not allocated one by one but in large
+// blocks of contiguous memory. The m_Points array references
+// all allocated records, so that records beyond m_nRecords
+// (up to m_nCapacity) are spare records that will be reused
+// by the next added points.
+
 //---------------------------------------------------------
 bool CSG_PointCloud::_Inc_Array(void)
 {
-	if( m_nFields > 0 && m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
+	if( m_nRecords >= m_nCapacity )
 	{
-		m_Points[m_nRecords++]	= m_Cursor	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
+		sLong nPoints = M_GET_MIN(m_nCapacity, (sLong)(PC_BLOCK_MAX_BYTES / M_GET_MAX(1, m_nPointBytes)));
 
-		return( true );
+		if( !_Add_Block(M_GET_MAX(PC_BLOCK_MIN_POINTS, nPoints)) )
+		{
+			return( false );
+		}
 	}
 
-	return( false );
+	m_Cursor = m_Points[m_nRecords++];
+
+	memset(m_Cursor, 0, m_nPointBytes);
+
+	return( true );
 }
 
 //---------------------------------------------------------
@@ -1193,10 +1431,189 @@ bool CSG_PointCloud::_Dec_Array(void)
 		m_nRecords	--;
 
 		m_Cursor	= NULL;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::_Add_Block(sLong nPoints)
+{
+	if( m_nFields < 1 || nPoints < 1 || !m_Array_Points.Set_Array(m_nCapacity + nPoints, (void **)&m_Points) )
+	{
+		return( false );
+	}
+
+	char *pBlock = (char *)SG_Malloc((size_t)nPoints * m_nPointBytes);
+
+	if( !pBlock )
+	{
+		m_Array_Points.Set_Array(m_nCapacity, (void **)&m_Points);
+
+		return( false );
+	}
+
+	m_Blocks.Add(pBlock);
+
+	for(sLong i=0; i<nPoints; i++, pBlock+=m_nPointBytes)
+	{
+		m_Points[m_nCapacity++] = pBlock;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Changes the size of the point records, inserting (nShift > 0)
+* zero initialized or removing (nShift < 0) bytes at given offset.
+* Removing bytes moves the record tails in place and needs no
+* additional memory, the released bytes stay unused until the
+* records are moved again. Inserting bytes moves all records to
+* one new contiguous block and drops spare records. While copying,
+* the old and the new records are both held in memory, so the peak
+* memory use is about twice the size of the point data.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::_Set_Point_Bytes(int nPointBytes, int Offset, int nShift)
+{
+	if( nShift < 0 )
+	{
+		int nTail = nPointBytes - Offset;
+
+		#pragma omp parallel for
+		for(sLong i=0; i<m_nRecords; i++)
+		{
+			memmove(m_Points[i] + Offset, m_Points[i] + Offset - nShift, nTail);
+		}
+
+		m_nPointBytes = nPointBytes;
+		m_Cursor      = NULL;
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	char *pBlock = NULL;
+
+	if( m_nRecords > 0 && (pBlock = (char *)SG_Malloc((size_t)m_nRecords * nPointBytes)) == NULL )
+	{
+		return( false );
+	}
+
+	int nTail = nPointBytes - Offset - (nShift > 0 ? nShift : 0);
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		char *pPoint = pBlock + i * nPointBytes;
+
+		memcpy(pPoint, m_Points[i], Offset);
+
+		if( nShift > 0 )
+		{
+			memset(pPoint + Offset         , 0, nShift);
+			memcpy(pPoint + Offset + nShift, m_Points[i] + Offset, nTail);
+		}
+		else
+		{
+			memcpy(pPoint + Offset, m_Points[i] + Offset - nShift, nTail);
+		}
 
-		SG_Free(m_Points[m_nRecords]);
+		m_Points[i] = pPoint;
+	}
 
-		m_Array_Points.Set_Array(m_nRecords, (void **)&m_Points);
+	//-----------------------------------------------------
+	for(sLong i=0; i<m_Blocks.Get_Size(); i++)
+	{
+		SG_Free(m_Blocks[i]);
+	}
+
+	m_Blocks.Destroy();
+
+	if( pBlock )
+	{
+		m_Blocks.Add(pBlock);
+	}
+
+	m_Array_Points.Set_Array(m_nCapacity = m_nRecords, (void **)&m_Points);
+
+	m_nPointBytes = nPointBytes;
+	m_Cursor      = NULL;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Pre-allocates storage for the given total number of points,
+* so that subsequently added points do not need any further
+* memory allocation.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::Reserve(sLong nPoints)
+{
+	return( nPoints <= m_nCapacity || _Add_Block(nPoints - m_nCapacity) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+template <typename TValue>
+void SG_PointCloud_Get_Values(char **pPoints, int Offset, double *Values, sLong Count, sLong Stride)
+{
+	for(sLong i=0; i<Count; i++, Values+=Stride)
+	{
+		*Values = (double)*((TValue *)(pPoints[i] + Offset));
+	}
+}
+
+//---------------------------------------------------------
+/**
+* Copies the values of a field for a range of points to the
+* Values array, which is expected to provide (Count - 1) * Stride + 1
+* elements. The data type is resolved once for the whole range,
+* so this is the preferred way to read complete columns, e.g.
+* the coordinates. A Count less than zero selects all points
+* from First on.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::Get_Field_Values(int Field, double *Values, sLong First, sLong Count, sLong Stride)	const
+{
+	if( Field < 0 || Field >= m_nFields || !Values || First < 0 || First > m_nRecords || Stride < 1 )
+	{
+		return( false );
+	}
+
+	if( Count < 0 || Count > m_nRecords - First )
+	{
+		Count = m_nRecords - First;
+	}
+
+	char **pPoints = m_Points + First; int Offset = m_Field_Offset[Field];
+
+	switch( m_Field_Type[Field] )
+	{
+	case SG_DATATYPE_Byte  : SG_PointCloud_Get_Values<BYTE  >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Char  : SG_PointCloud_Get_Values<char  >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Word  : SG_PointCloud_Get_Values<WORD  >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Short : SG_PointCloud_Get_Values<short >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_DWord : SG_PointCloud_Get_Values<DWORD >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Int   : SG_PointCloud_Get_Values<int   >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Long  : SG_PointCloud_Get_Values<sLong >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_ULong : SG_PointCloud_Get_Values<uLong >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Float : SG_PointCloud_Get_Values<float >(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Double: SG_PointCloud_Get_Values<double>(pPoints, Offset, Values, Count, Stride); break;
+	case SG_DATATYPE_Color : SG_PointCloud_Get_Values<DWORD >(pPoints, Offset, Values, Count, Stride); break;
+	default                :
+		for(sLong i=0; i<Count; i++, Values+=Stride)
+		{
+			*Values = _Get_Field_Value(pPoints[i], Field);
+		}
+		break;
 	}
 
 	return( true );
@@ -1615,22 +2032,18 @@ sLong CSG_PointCloud::Del_Selection(void)
 
 		for(sLong i=0; i<m_nRecords; i++)
 		{
-			if( (m_Points[i][0] & SG_TABLE_REC_FLAG_Selected) != 0 )
-			{
-				SG_Free(m_Points[i]);
-			}
-			else
+			if( (m_Points[i][0] & SG_TABLE_REC_FLAG_Selected) == 0 )
 			{
-				if( n < i )
+				if( n < i )	// keep the deleted record as spare record
 				{
-					m_Points[n] = m_Points[i];
+					char *pPoint = m_Points[n]; m_Points[n] = m_Points[i]; m_Points[i] = pPoint;
 				}
 
 				n++;
 			}
 		}
 
-		m_Array_Points.Set_Array(m_nRecords = n, (void **)&m_Points);
+		m_nRecords = n;
 
 		Set_Modified();
 		Set_Update_Flag();
@@ -1666,6 +2079,132 @@ sLong CSG_PointCloud::Inv_Selection(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_PointCloud_Reader::CSG_PointCloud_Reader(void)
+{
+	m_pStream = NULL; m_nPoints = m_nRead = 0;
+}
+
+//---------------------------------------------------------
+CSG_PointCloud_Reader::CSG_PointCloud_Reader(const CSG_String &File)
+{
+	m_pStream = NULL; m_nPoints = m_nRead = 0;
+
+	Open(File);
+}
+
+//---------------------------------------------------------
+CSG_PointCloud_Reader::~CSG_PointCloud_Reader(void)
+{
+	Close();
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud_Reader::Open(const CSG_String &File)
+{
+	Close();
+
+	if( SG_File_Cmp_Extension(File, "sg-pts-z") ) // POINTCLOUD_FILE_FORMAT_Compressed
+	{
+		CSG_File_Zip *pStream = new CSG_File_Zip(File, SG_FILE_R); m_pStream = pStream;
+
+		CSG_String _File(SG_File_Get_Name(File, false) + ".");
+
+		if( pStream->Get_File(_File + "sg-prj") )
+		{
+			m_Structure.Get_Projection().Load(*pStream);
+		}
+
+		if( !pStream->Get_File(_File + "sg-pts") )
+		{
+			return( Close() && false );
+		}
+	}
+	else // if( SG_File_Cmp_Extension(File, "sg-pts"/"spc") ) // POINTCLOUD_FILE_FORMAT_Normal
+	{
+		m_pStream = new CSG_File(File, SG_FILE_R, true);
+
+		m_Structure.Get_Projection().Load(SG_File_Make_Path("", File, "sg-prj"));
+	}
+
+	//-----------------------------------------------------
+	CSG_Projection Projection(m_Structure.Get_Projection());
+
+	if( !m_Structure._Load_Header(*m_pStream) )
+	{
+		return( Close() && false );
+	}
+
+	m_Structure.Get_Projection().Create(Projection);	// header loading destroys the structure's projection
+
+	m_Structure.Set_Name(SG_File_Get_Name(File, false));
+
+	m_nPoints = (m_pStream->Length() - m_pStream->Tell()) / (m_Structure.m_nPointBytes - 1);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud_Reader::Close(void)
+{
+	if( m_pStream )
+	{
+		delete(m_pStream);
+
+		m_pStream = NULL;
+	}
+
+	m_Structure.Destroy();
+
+	m_nPoints = m_nRead = 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Replaces the points of the given point cloud with the next
+* chunk of up to nPoints points. The point cloud's field
+* structure is adjusted to that of the file if necessary.
+* Returns false, if there are no more points to read.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud_Reader::Read(CSG_PointCloud &Points, sLong nPoints)
+{
+	if( !m_pStream || nPoints < 1 )
+	{
+		return( false );
+	}
+
+	if( !Points.is_Compatible(&m_Structure) )
+	{
+		Points.Create(&m_Structure);
+
+		Points.Get_Projection().Create(m_Structure.Get_Projection());
+
+		Points.Set_Name(m_Structure.Get_Name());
+	}
+	else
+	{
+		Points._Clear_Points();
+	}
+
+	Points.Reserve(nPoints);
+
+	sLong n = Points._Load_Points(*m_pStream, nPoints);
+
+	m_nRead += n;
+
+	return( n > 0 );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -156,9 +156,15 @@ public:
 	//-----------------------------------------------------
 	bool							Add_Point			(double x, double y, double z);
 	bool							Add_Point			(const CSG_Point_3D &Point);
+	bool							Add_Point			(CSG_PointCloud *pSource, sLong Index);
 	bool							Del_Point			(sLong Index);
 	bool							Del_Points			(void);
 
+	bool							Reserve				(sLong nPoints);
+	sLong							Get_Capacity		(void)	const			{	return( m_nCapacity );	}
+
+	bool							Get_Field_Values	(int Field, double *Values, sLong First = 0, sLong Count = -1, sLong Stride = 1)	const;
+
 	//-----------------------------------------------------
 	bool							Set_Cursor			(sLong Index)							{	return( (m_Cursor = Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL) != NULL );	}
 	virtual bool					Set_Value			(             int Field, double Value)	{	return( _Set_Field_Value(m_Cursor, Field, Value) );	}
@@ -190,6 +196,9 @@ public:
 	virtual bool					Set_Attribute		(sLong Index, int Field, const SG_Char *Value)			{	return( Set_Value(Index, Field + 3, Value) );	}
 	virtual bool					Get_Attribute		(sLong Index, int Field, CSG_String    &Value)	const	{	return( Get_Value(Index, Field + 3, Value) );	}
 
+	virtual bool					Get_Field_Values	(int Field, CSG_Vector &Values)	const;
+	virtual bool					Set_Field_Values	(int Field, const CSG_Vector &Values);
+
 	TSG_Point_3D					Get_Point			(void)			const;
 	TSG_Point_3D					Get_Point			(sLong Index)	const;
 	virtual bool					Set_Point			(             const TSG_Point_3D &Point);
@@ -246,14 +255,20 @@ private:
 	char							**m_Points, *m_Cursor;
 
 	int								m_nPointBytes, *m_Field_Offset;
+
+	sLong							m_nCapacity;
 	
 	CSG_Array						m_Array_Points;
 
+	CSG_Array_Pointer				m_Blocks;
+
 	CSG_Shapes						m_Shapes;
 
 
 	bool							_Load				(const CSG_String &File);
 	bool							_Load				(CSG_File &Stream);
+	bool							_Load_Header		(CSG_File &Stream);
+	sLong							_Load_Points		(CSG_File &Stream, sLong nPoints, bool bProgress = false);
 	bool							_Save				(CSG_File &Stream);
 	CSG_MetaData					_Create_Header		(void)	const;
 
@@ -265,10 +280,67 @@ private:
 
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
+	bool							_Add_Block			(sLong nPoints);
+	bool							_Set_Point_Bytes	(int nPointBytes, int Offset, int nShift);
+	bool							_Clear_Points		(void);
 
 	CSG_Shape *						_Shape_Get			(sLong Index);
 	void							_Shape_Flush		(void);
 
+
+	friend class CSG_PointCloud_Reader;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_PointCloud_Reader reads the points of a point cloud file
+* (sg-pts or sg-pts-z) chunk by chunk, so that point clouds can
+* be processed that do not fit into memory as a whole:
+*
+*	CSG_PointCloud_Reader Reader(File); CSG_PointCloud Points;
+*
+*	while( Reader.Read(Points, 1000000) )
+*	{
+*		for(sLong i=0; i<Points.Get_Count(); i++) { ... }
+*	}
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_PointCloud_Reader
+{
+public:
+	CSG_PointCloud_Reader(void);
+	virtual ~CSG_PointCloud_Reader(void);
+
+									CSG_PointCloud_Reader	(const CSG_String &File);
+	bool							Open					(const CSG_String &File);
+	bool							Close					(void);
+
+	bool							is_Open					(void)	const	{	return( m_pStream != NULL );	}
+
+	const CSG_PointCloud &			Get_Structure			(void)	const	{	return( m_Structure );	}
+
+	sLong							Get_Count				(void)	const	{	return( m_nPoints );	}
+	sLong							Get_Position			(void)	const	{	return( m_nRead   );	}
+
+	bool							Read					(CSG_PointCloud &Points, sLong nPoints = 1048576);
+
+
+private:
+
+	sLong							m_nPoints, m_nRead;
+
+	CSG_File						*m_pStream;
+
+	CSG_PointCloud					m_Structure;
+
 };
 
 
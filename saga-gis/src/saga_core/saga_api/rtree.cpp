@@ -0,0 +1,369 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                      rtree.cpp                        //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "shapes.h"
+
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct SSG_RTree_Node
+{
+	TSG_Rect	Extent;
+
+	sLong		First, Count;	// range of child nodes or, for leafs, of items
+}
+TSG_RTree_Node;
+
+//---------------------------------------------------------
+// Sort-Tile-Recursive: sort by x, cut into vertical slices
+// of sqrt(number of nodes) nodes, then sort each slice by y.
+//---------------------------------------------------------
+static void SG_RTree_STR_Sort(sLong *Index, sLong n, const TSG_Rect *Rects, int nCapacity)
+{
+	sLong	nNodes	= (n + nCapacity - 1) / nCapacity;
+	sLong	nSlice	= nCapacity * (sLong)ceil(sqrt((double)nNodes));
+
+	std::sort(Index, Index + n, [Rects](sLong a, sLong b)
+	{
+		return( Rects[a].xMin + Rects[a].xMax < Rects[b].xMin + Rects[b].xMax );
+	});
+
+	for(sLong i=0; i<n; i+=nSlice)
+	{
+		std::sort(Index + i, Index + i + M_GET_MIN(nSlice, n - i), [Rects](sLong a, sLong b)
+		{
+			return( Rects[a].yMin + Rects[a].yMax < Rects[b].yMin + Rects[b].yMax );
+		});
+	}
+}
+
+//---------------------------------------------------------
+static inline bool SG_RTree_Intersects(const TSG_Rect &a, const TSG_Rect &b)
+{
+	return( a.xMin <= b.xMax && a.xMax >= b.xMin
+		&&  a.yMin <= b.yMax && a.yMax >= b.yMin );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_RTree::CSG_RTree(void)
+{
+	m_nLeafs	= 0;
+
+	m_Nodes.Create(sizeof(TSG_RTree_Node));
+	m_Rects.Create(sizeof(TSG_Rect      ));
+}
+
+//---------------------------------------------------------
+CSG_RTree::CSG_RTree(CSG_Shapes *pShapes, int nCapacity)
+{
+	m_nLeafs	= 0;
+
+	m_Nodes.Create(sizeof(TSG_RTree_Node));
+	m_Rects.Create(sizeof(TSG_Rect      ));
+
+	Create(pShapes, nCapacity);
+}
+
+//---------------------------------------------------------
+CSG_RTree::CSG_RTree(const TSG_Rect *Rects, sLong nRects, int nCapacity)
+{
+	m_nLeafs	= 0;
+
+	m_Nodes.Create(sizeof(TSG_RTree_Node));
+	m_Rects.Create(sizeof(TSG_Rect      ));
+
+	Create(Rects, nRects, nCapacity);
+}
+
+//---------------------------------------------------------
+CSG_RTree::~CSG_RTree(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_RTree::Destroy(void)
+{
+	m_nLeafs	= 0;
+
+	m_Nodes.Set_Array(0);
+	m_Rects.Set_Array(0);
+	m_Items.Destroy();
+
+	m_Extent.Assign(0., 0., 0., 0.);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Indexes the bounding boxes of all shapes. Requesting the
+* extents here also updates the shapes' cached extents, so
+* that they can be read afterwards from parallel threads.
+*/
+bool CSG_RTree::Create(CSG_Shapes *pShapes, int nCapacity)
+{
+	Destroy();
+
+	if( !pShapes || pShapes->Get_Count() < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Array	Rects(sizeof(TSG_Rect), pShapes->Get_Count());
+
+	for(sLong i=0; i<pShapes->Get_Count(); i++)
+	{
+		((TSG_Rect *)Rects.Get_Array())[i]	= pShapes->Get_Shape(i)->Get_Extent();
+	}
+
+	return( Create((const TSG_Rect *)Rects.Get_Array(), pShapes->Get_Count(), nCapacity) );
+}
+
+//---------------------------------------------------------
+bool CSG_RTree::Create(const TSG_Rect *Rects, sLong nRects, int nCapacity)
+{
+	Destroy();
+
+	if( !Rects || nRects < 1 || nCapacity < 2 )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// leafs, packing the items in STR order
+
+	m_Items.Create(nRects);
+
+	for(sLong i=0; i<nRects; i++)
+	{
+		m_Items[i]	= i;
+	}
+
+	SG_RTree_STR_Sort(m_Items.Get_Array(), nRects, Rects, nCapacity);
+
+	TSG_Rect	*pRects	= (TSG_Rect *)m_Rects.Get_Array(nRects);
+
+	for(sLong i=0; i<nRects; i++)
+	{
+		pRects[i]	= Rects[m_Items[i]];
+	}
+
+	//-----------------------------------------------------
+	// nodes are stored level by level, leafs first, root last
+
+	sLong	nNodes	= 0;
+
+	for(sLong n=nRects; nNodes<1 || n>1; nNodes+=n)
+	{
+		n	= (n + nCapacity - 1) / nCapacity;
+	}
+
+	TSG_RTree_Node	*pNodes	= (TSG_RTree_Node *)m_Nodes.Get_Array(nNodes);
+
+	sLong	nLevel	= nRects;	// number of entries to be packed into the current level
+	sLong	iLevel	= 0;		// index of the current level's first node
+	sLong	iChild	= 0;		// index of the first node of the level below
+
+	do
+	{
+		bool	bLeafs		= iLevel == 0;
+
+		sLong	nParents	= (nLevel + nCapacity - 1) / nCapacity;
+
+		for(sLong i=0; i<nParents; i++)
+		{
+			TSG_RTree_Node	&Node	= pNodes[iLevel + i];
+
+			Node.First	= (bLeafs ? 0 : iChild) + i * nCapacity;
+			Node.Count	= M_GET_MIN((sLong)nCapacity, nLevel - i * nCapacity);
+			Node.Extent	= bLeafs ? pRects[Node.First] : pNodes[Node.First].Extent;
+
+			for(sLong j=1; j<Node.Count; j++)
+			{
+				const TSG_Rect	&r	= bLeafs ? pRects[Node.First + j] : pNodes[Node.First + j].Extent;
+
+				if( Node.Extent.xMin > r.xMin )	Node.Extent.xMin	= r.xMin;
+				if( Node.Extent.xMax < r.xMax )	Node.Extent.xMax	= r.xMax;
+				if( Node.Extent.yMin > r.yMin )	Node.Extent.yMin	= r.yMin;
+				if( Node.Extent.yMax < r.yMax )	Node.Extent.yMax	= r.yMax;
+			}
+		}
+
+		if( bLeafs )
+		{
+			m_nLeafs	= nParents;
+		}
+
+		//-------------------------------------------------
+		if( nParents > 1 )	// bring this level's nodes in STR order, too, before packing them
+		{
+			CSG_Array	Extents(sizeof(TSG_Rect), nParents), Nodes(sizeof(TSG_RTree_Node), nParents);
+
+			TSG_Rect		*pExtents	= (TSG_Rect       *)Extents.Get_Array();
+			TSG_RTree_Node	*pLevel		= (TSG_RTree_Node *)Nodes  .Get_Array();
+
+			CSG_Array_sLong	Index(nParents);
+
+			for(sLong i=0; i<nParents; i++)
+			{
+				Index[i]	= i;
+				pLevel[i]	= pNodes[iLevel + i];
+				pExtents[i]	= pNodes[iLevel + i].Extent;
+			}
+
+			SG_RTree_STR_Sort(Index.Get_Array(), nParents, pExtents, nCapacity);
+
+			for(sLong i=0; i<nParents; i++)
+			{
+				pNodes[iLevel + i]	= pLevel[Index[i]];
+			}
+		}
+
+		iChild	 = iLevel;
+		iLevel	+= nParents;
+		nLevel	 = nParents;
+	}
+	while( nLevel > 1 );
+
+	m_Extent	= pNodes[nNodes - 1].Extent;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Collects the indices of all items, whose bounding box
+* intersects with the given extent, in ascending order.
+*/
+sLong CSG_RTree::Get_Intersecting(const TSG_Rect &Extent, CSG_Array_sLong &Indices) const
+{
+	Indices.Set_Array(0, false);
+
+	if( is_Okay() && SG_RTree_Intersects(m_Extent, Extent) )
+	{
+		_Get_Intersecting(m_Nodes.Get_Size() - 1, Extent, Indices);
+
+		std::sort(Indices.Get_Array(), Indices.Get_Array() + Indices.Get_Size());
+	}
+
+	return( Indices.Get_Size() );
+}
+
+//---------------------------------------------------------
+/**
+* Collects the indices of all items, whose bounding box
+* contains the given point, in ascending order.
+*/
+sLong CSG_RTree::Get_Intersecting(const TSG_Point &Point, CSG_Array_sLong &Indices) const
+{
+	TSG_Rect	Extent;
+
+	Extent.xMin	= Extent.xMax	= Point.x;
+	Extent.yMin	= Extent.yMax	= Point.y;
+
+	return( Get_Intersecting(Extent, Indices) );
+}
+
+//---------------------------------------------------------
+void CSG_RTree::_Get_Intersecting(sLong iNode, const TSG_Rect &Extent, CSG_Array_sLong &Indices) const
+{
+	const TSG_RTree_Node	&Node	= ((const TSG_RTree_Node *)m_Nodes.Get_Array())[iNode];
+
+	if( iNode < m_nLeafs )
+	{
+		const TSG_Rect	*pRects	= (const TSG_Rect *)m_Rects.Get_Array() + Node.First;
+
+		for(sLong i=0; i<Node.Count; i++)
+		{
+			if( SG_RTree_Intersects(pRects[i], Extent) )
+			{
+				Indices	+= m_Items[Node.First + i];
+			}
+		}
+	}
+	else
+	{
+		const TSG_RTree_Node	*pNodes	= (const TSG_RTree_Node *)m_Nodes.Get_Array();
+
+		for(sLong i=Node.First; i<Node.First+Node.Count; i++)
+		{
+			if( SG_RTree_Intersects(pNodes[i].Extent, Extent) )
+			{
+				_Get_Intersecting(i, Extent, Indices);
+			}
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -87,6 +87,106 @@
 #include "saga_api.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#if defined(_SAGA_PYTHON)
+
+//---------------------------------------------------------
+// NumPy array interface: grids held in memory and vectors
+// expose their memory through '__array_interface__', so
+// that 'numpy.asarray()' creates a view without copying.
+// The view is only valid as long as the object exists and
+// has not been resized, i.e. its memory not reallocated.
+//---------------------------------------------------------
+%{
+static PyObject *	SG_NumPy_Array_Interface(void *Data, TSG_Data_Type Type, PyObject *Shape)
+{
+	const int	Endian	= 1;
+
+	char	Typestr[4]	= { *((const char *)&Endian) ? '<' : '>', 'f', '8', '\0' };
+
+	switch( Type )
+	{
+	case SG_DATATYPE_Byte  : Typestr[0] = '|'; Typestr[1] = 'u'; Typestr[2] = '1'; break;
+	case SG_DATATYPE_Char  : Typestr[0] = '|'; Typestr[1] = 'i'; Typestr[2] = '1'; break;
+	case SG_DATATYPE_Word  : Typestr[1] = 'u'; Typestr[2] = '2'; break;
+	case SG_DATATYPE_Short : Typestr[1] = 'i'; Typestr[2] = '2'; break;
+	case SG_DATATYPE_DWord : Typestr[1] = 'u'; Typestr[2] = '4'; break;
+	case SG_DATATYPE_Color : Typestr[1] = 'u'; Typestr[2] = '4'; break;
+	case SG_DATATYPE_Int   : Typestr[1] = 'i'; Typestr[2] = '4'; break;
+	case SG_DATATYPE_ULong : Typestr[1] = 'u'; Typestr[2] = '8'; break;
+	case SG_DATATYPE_Long  : Typestr[1] = 'i'; Typestr[2] = '8'; break;
+	case SG_DATATYPE_Float : Typestr[1] = 'f'; Typestr[2] = '4'; break;
+	case SG_DATATYPE_Double: Typestr[1] = 'f'; Typestr[2] = '8'; break;
+
+	default:
+		Py_DECREF(Shape);
+
+		PyErr_SetString(PyExc_AttributeError, "data type is not supported by the array interface");
+
+		return( NULL );
+	}
+
+	return( Py_BuildValue("{s:N,s:s,s:(NO),s:i}",
+		"shape"  , Shape,
+		"typestr", Typestr,
+		"data"   , PyLong_FromVoidPtr(Data), Py_False,
+		"version", 3
+	));
+}
+%}
+
+//---------------------------------------------------------
+%extend CSG_Grid
+{
+	/** Rows are ordered from south to north, i.e. the first row is the lower one (y = 0). */
+	PyObject *	_Get_Array_Interface(void)
+	{
+		void	*Data	= $self->Get_Data();
+
+		if( !Data )
+		{
+			PyErr_SetString(PyExc_AttributeError, "grid values are not held in memory as one contiguous block");
+
+			return( NULL );
+		}
+
+		return( SG_NumPy_Array_Interface(Data, $self->Get_Type(), Py_BuildValue("(ii)", $self->Get_NY(), $self->Get_NX())) );
+	}
+
+	%pythoncode %{
+		__array_interface__ = property(_Get_Array_Interface)
+	%}
+}
+
+//---------------------------------------------------------
+%extend CSG_Vector
+{
+	PyObject *	_Get_Array_Interface(void)
+	{
+		if( $self->Get_Size() < 1 )
+		{
+			PyErr_SetString(PyExc_AttributeError, "vector is empty");
+
+			return( NULL );
+		}
+
+		return( SG_NumPy_Array_Interface($self->Get_Data(), SG_DATATYPE_Double, Py_BuildValue("(n)", (Py_ssize_t)$self->Get_Size())) );
+	}
+
+	%pythoncode %{
+		__array_interface__ = property(_Get_Array_Interface)
+	%}
+}
+
+#endif // #if defined(_SAGA_PYTHON)
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
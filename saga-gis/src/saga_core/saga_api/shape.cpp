@@ -105,6 +105,7 @@ TSG_Vertex_Type CSG_Shape::Get_Vertex_Type(void) const
 inline void CSG_Shape::_Invalidate(void)
 {
 	((CSG_Shapes *)m_pTable)->Set_Update_Flag();
+	((CSG_Shapes *)m_pTable)->m_bSpatial_Index = false;	// rebuilt once with the next query
 	
 	Set_Modified();
 }
@@ -192,6 +192,9 @@ void CSG_Shapes::_On_Construction(void)
 	m_Type        = SHAPE_TYPE_Undefined;
 	m_Vertex_Type = SG_VERTEX_TYPE_XY;
 
+	m_bSpatial_Index = false;
+	m_pSpatial_Index = NULL;
+
 	m_Encoding    = SG_FILE_ENCODING_UTF8;
 }
 
@@ -211,6 +214,8 @@ bool CSG_Shapes::Create(const char       *File) { return( Create(CSG_String(File
 bool CSG_Shapes::Create(const wchar_t    *File) { return( Create(CSG_String(File)) ); }
 bool CSG_Shapes::Create(const CSG_String &File)
 {
+	CSG_Profiler_Region Profile("load", File, "shapes");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Loading"), _TL("shapes"), File.c_str()), true);
@@ -346,6 +351,8 @@ CSG_Shapes::~CSG_Shapes(void)
 //---------------------------------------------------------
 bool CSG_Shapes::Destroy(void)
 {
+	Del_Spatial_Index();
+
 	if( CSG_Table::Destroy() )
 	{
 		m_Type = SHAPE_TYPE_Undefined;
@@ -438,6 +445,33 @@ bool CSG_Shapes::Del_Shape(sLong Index)
 	return( Del_Record(Index) );
 }
 
+//---------------------------------------------------------
+CSG_Table_Record * CSG_Shapes::Ins_Record(sLong Index, CSG_Table_Record *pCopy)
+{
+	if( Index < Get_Count() )	// appending new (empty) shapes keeps the spatial index valid
+	{
+		m_bSpatial_Index = false;
+	}
+
+	return( CSG_Table::Ins_Record(Index, pCopy) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Record(sLong Index)
+{
+	m_bSpatial_Index = false;
+
+	return( CSG_Table::Del_Record(Index) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Records(void)
+{
+	Del_Spatial_Index();
+
+	return( CSG_Table::Del_Records() );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -500,29 +534,26 @@ CSG_Shape * CSG_Shapes::Get_Shape(const CSG_Point &Point, double Epsilon)
 {
 	CSG_Rect r(Point.x - Epsilon, Point.y - Epsilon, Point.x + Epsilon, Point.y + Epsilon);
 
-	CSG_Shape *pNearest = NULL;
+	CSG_Shape *pNearest = NULL; CSG_Array_sLong Indices;
 
-	if( r.Intersects(Get_Extent()) != INTERSECTION_None )
+	if( Get_Intersecting(r, Indices) > 0 )
 	{
 		double dNearest = -1.;
 
-		for(sLong iShape=0; iShape<Get_Count(); iShape++)
+		for(sLong i=0; i<Indices.Get_Size(); i++)
 		{
-			CSG_Shape *pShape = Get_Shape(iShape);
+			CSG_Shape *pShape = Get_Shape(Indices[i]);
 
-			if( pShape->Intersects(r) )
-			{
-				double d = pShape->Get_Distance(Point);
+			double d = pShape->Get_Distance(Point);
 
-				if( d == 0. )
-				{
-					return( pShape );
-				}
-				else if( d > 0. && d <= Epsilon && (pNearest == NULL || d < dNearest) )
-				{
-					dNearest = d;
-					pNearest = pShape;
-				}
+			if( d == 0. )
+			{
+				return( pShape );
+			}
+			else if( d > 0. && d <= Epsilon && (pNearest == NULL || d < dNearest) )
+			{
+				dNearest = d;
+				pNearest = pShape;
 			}
 		}
 	}
@@ -531,6 +562,127 @@ CSG_Shape * CSG_Shapes::Get_Shape(const CSG_Point &Point, double Epsilon)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Builds the spatial index (an R-tree over the shapes'
+* bounding boxes), if it does not exist yet. Inserting or
+* deleting shapes and editing their geometries marks the
+* index as outdated and it is rebuilt once with the next
+* call. Extent and point queries build it on demand. This is
+* safe from parallel threads, as long as the shapes are not
+* edited at the same time.
+*/
+bool CSG_Shapes::Set_Spatial_Index(void)
+{
+	bool bOkay;
+
+	#pragma omp critical(SG_Shapes_Spatial_Index)	// the first of concurrent queries builds the index, the others wait for it
+	{
+		if( !m_bSpatial_Index && Get_Count() > 0 )
+		{
+			if( m_pSpatial_Index == NULL )
+			{
+				m_pSpatial_Index = new CSG_RTree;
+			}
+
+			if( (m_bSpatial_Index = m_pSpatial_Index->Create(this)) == false )
+			{
+				delete(m_pSpatial_Index); m_pSpatial_Index = NULL;
+			}
+		}
+
+		bOkay = m_bSpatial_Index;
+	}
+
+	return( bOkay );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Del_Spatial_Index(void)
+{
+	if( m_pSpatial_Index )
+	{
+		delete(m_pSpatial_Index);
+
+		m_pSpatial_Index = NULL;
+	}
+
+	m_bSpatial_Index = false;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Collects the indices of all shapes intersecting the given
+* extent in ascending order.
+*/
+sLong CSG_Shapes::Get_Intersecting(const TSG_Rect &Extent, CSG_Array_sLong &Indices)
+{
+	if( !Set_Spatial_Index() || !m_pSpatial_Index->Get_Intersecting(Extent, Indices) )
+	{
+		Indices.Set_Array(0, false);
+
+		return( 0 );
+	}
+
+	sLong n = 0;
+
+	for(sLong i=0; i<Indices.Get_Size(); i++)
+	{
+		if( Get_Shape(Indices[i])->Intersects(Extent) )
+		{
+			Indices[n++] = Indices[i];
+		}
+	}
+
+	Indices.Set_Array(n, false);
+
+	return( n );
+}
+
+//---------------------------------------------------------
+/**
+* Collects the indices of all polygons containing the given
+* point, respectively of all points and lines touching it,
+* in ascending order.
+*/
+sLong CSG_Shapes::Get_Intersecting(const TSG_Point &Point, CSG_Array_sLong &Indices)
+{
+	if( Get_Type() != SHAPE_TYPE_Polygon )
+	{
+		return( Get_Intersecting(CSG_Rect(Point, Point), Indices) );
+	}
+
+	if( !Set_Spatial_Index() || !m_pSpatial_Index->Get_Intersecting(Point, Indices) )
+	{
+		Indices.Set_Array(0, false);
+
+		return( 0 );
+	}
+
+	sLong n = 0;
+
+	for(sLong i=0; i<Indices.Get_Size(); i++)
+	{
+		if( Get_Shape(Indices[i])->asPolygon()->Contains(Point) )
+		{
+			Indices[n++] = Indices[i];
+		}
+	}
+
+	Indices.Set_Array(n, false);
+
+	return( n );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
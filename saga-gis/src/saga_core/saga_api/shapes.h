@@ -823,6 +823,10 @@ public:
 	virtual bool					Del_Shape				(CSG_Shape *pShape);
 	virtual bool					Del_Shapes				(void)					{	return( Del_Records() );	}
 
+	virtual CSG_Table_Record *		Ins_Record				(sLong Index, CSG_Table_Record *pCopy = NULL);
+	virtual bool					Del_Record				(sLong Index);
+	virtual bool					Del_Records				(void);
+
 	virtual CSG_Shape *				Get_Shape				(const CSG_Point &Point, double Epsilon = 0.);
 	virtual CSG_Shape *				Get_Shape				(sLong Index)	const	{	return( (CSG_Shape *)Get_Record        (Index) );	}
 	virtual CSG_Shape *				Get_Shape_byIndex		(sLong Index)	const	{	return( (CSG_Shape *)Get_Record_byIndex(Index) );	}
@@ -839,6 +843,14 @@ public:
 	virtual bool					Select					(const TSG_Rect &Extent         , bool bInvert = false);
 	virtual bool					Select					(const TSG_Point &Point         , bool bInvert = false);
 
+	//-----------------------------------------------------
+	bool							Set_Spatial_Index		(void);
+	bool							Del_Spatial_Index		(void);
+	bool							has_Spatial_Index		(void)	const			{	return( m_pSpatial_Index != NULL && m_bSpatial_Index );	}
+
+	sLong							Get_Intersecting		(const TSG_Rect  &Extent, CSG_Array_sLong &Indices);
+	sLong							Get_Intersecting		(const TSG_Point &Point , CSG_Array_sLong &Indices);
+
 
 protected:
 
@@ -850,6 +862,10 @@ protected:
 
 	CSG_Rect						m_Extent_Selected;
 
+	bool							m_bSpatial_Index;	// false, if the spatial index needs to be rebuilt
+
+	class CSG_RTree					*m_pSpatial_Index;
+
 
 	virtual bool					On_Update				(void);
 	virtual bool					On_Reload				(void);
@@ -1286,6 +1302,8 @@ public:
 	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, double Radius);
 	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, double Radius, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(const double *Coordinates, size_t nQueries, size_t Count, double Radius, size_t *Indices, double *Distances, size_t *nMatches = NULL);
 	virtual bool				Get_Nearest_Point	(double Coordinate[2], size_t &Index, double &Distance);
 	virtual bool				Get_Nearest_Point	(double Coordinate[2], size_t &Index);
 	virtual bool				Get_Nearest_Value	(double Coordinate[2], double &Value);
@@ -1296,6 +1314,7 @@ public:
 	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius);
 	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius, size_t *Indices, double *Distances);
 	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index, double &Distance);
 	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index);
 	virtual bool				Get_Nearest_Value	(double x, double y, double &Value);
@@ -1336,6 +1355,8 @@ public:
 	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, double Radius);
 
 	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, double Radius, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(const double *Coordinates, size_t nQueries, size_t Count, double Radius, size_t *Indices, double *Distances, size_t *nMatches = NULL);
 	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual bool				Get_Nearest_Point	(double Coordinate[3], size_t &Index, double &Distance);
 	virtual bool				Get_Nearest_Point	(double Coordinate[3], size_t &Index);
@@ -1347,6 +1368,7 @@ public:
 	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius);
 	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius, CSG_Array_sLong &Indices, CSG_Vector &Distances);
 	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, size_t *Indices, double *Distances);
+	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius, size_t *Indices, double *Distances);
 	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index, double &Distance);
 	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index);
 	virtual bool				Get_Nearest_Value	(double x, double y, double z, double &Value);
@@ -1431,6 +1453,60 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                 Spatial Index (R-Tree)                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** CSG_RTree is a static R-tree over bounding rectangles,
+* bulk loaded with the Sort-Tile-Recursive (STR) algorithm.
+* Item indices returned by the queries refer to the order
+* of the rectangles (or shapes) used for construction.
+* Once created the tree is read-only, so queries can be
+* run concurrently from several threads.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_RTree
+{
+public:
+	CSG_RTree(void);
+	virtual ~CSG_RTree(void);
+
+								CSG_RTree			(CSG_Shapes *pShapes, int nCapacity = 16);
+	bool						Create				(CSG_Shapes *pShapes, int nCapacity = 16);
+
+								CSG_RTree			(const TSG_Rect *Rects, sLong nRects, int nCapacity = 16);
+	bool						Create				(const TSG_Rect *Rects, sLong nRects, int nCapacity = 16);
+
+	bool						Destroy				(void);
+
+	bool						is_Okay				(void)	const	{	return( m_Nodes.Get_Size() > 0 );	}
+
+	sLong						Get_Count			(void)	const	{	return( m_Items.Get_Size() );		}
+	const CSG_Rect &			Get_Extent			(void)	const	{	return( m_Extent );					}
+
+	sLong						Get_Intersecting	(const TSG_Rect  &Extent, CSG_Array_sLong &Indices)	const;
+	sLong						Get_Intersecting	(const TSG_Point &Point , CSG_Array_sLong &Indices)	const;
+
+
+private:
+
+	sLong						m_nLeafs;
+
+	CSG_Rect					m_Extent;
+
+	CSG_Array					m_Nodes, m_Rects;
+
+	CSG_Array_sLong				m_Items;
+
+
+	void						_Get_Intersecting	(sLong iNode, const TSG_Rect &Extent, CSG_Array_sLong &Indices)	const;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //					Polygon Tools						 //
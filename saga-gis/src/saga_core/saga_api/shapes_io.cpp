@@ -140,6 +140,8 @@ CSG_String				SG_Shapes_Get_File_Extension_Default	(void)
 //---------------------------------------------------------
 bool CSG_Shapes::Save(const CSG_String &File, int Format)
 {
+	CSG_Profiler_Region Profile("save", File, "shapes");
+
 	if( Format == SHAPE_FILE_FORMAT_Undefined )
 	{
 		Format = gSG_Shape_File_Format_Default;
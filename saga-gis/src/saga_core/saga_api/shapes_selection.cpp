@@ -79,12 +79,11 @@ bool CSG_Shapes::Select(const TSG_Rect &Extent, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Indices; sLong n = Get_Intersecting(Extent, Indices);
+
+	for(sLong i=0; i<n; i++)
 	{
-		if( Get_Shape(i)->Intersects(Extent) )
-		{
-			CSG_Table::Select(i, true);
-		}
+		CSG_Table::Select(Indices[i], true);
 	}
 
 	return( Get_Selection_Count() > 0 );
@@ -103,12 +102,11 @@ bool CSG_Shapes::Select(const TSG_Point &Point, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Indices; sLong n = Get_Intersecting(Point, Indices);
+
+	for(sLong i=0; i<n; i++)
 	{
-		if( ((CSG_Shape_Polygon *)Get_Shape(i))->Contains(Point) )
-		{
-			CSG_Table::Select(i, true);
-		}
+		CSG_Table::Select(Indices[i], true);
 	}
 
 	return( Get_Selection_Count() > 0 );
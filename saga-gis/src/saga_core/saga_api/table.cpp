@@ -166,6 +166,8 @@ bool CSG_Table::Create(const char       *File, TSG_Table_File_Type Format, int E
 bool CSG_Table::Create(const wchar_t    *File, TSG_Table_File_Type Format, int Encoding) { return( Create(CSG_String(File), Format, Encoding) ); }
 bool CSG_Table::Create(const CSG_String &File, TSG_Table_File_Type Format, int Encoding)
 {
+	CSG_Profiler_Region Profile("load", File, "table");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Loading"), _TL("table"), File.c_str()), true);
@@ -1189,6 +1191,51 @@ bool CSG_Table::Get_Value(sLong iRecord, int iField, double      &Value) const
 	return( false );
 }
 
+//---------------------------------------------------------
+/**
+  * Copies the values of field iField of all records in their
+  * storage order (not index order) into the vector Values.
+*/
+bool CSG_Table::Get_Field_Values(int iField, CSG_Vector &Values) const
+{
+	if( iField < 0 || iField >= m_nFields || !Values.Create(m_nRecords) )
+	{
+		return( false );
+	}
+
+	double *pValues = Values.Get_Data();
+
+	#pragma omp parallel for
+	for(sLong iRecord=0; iRecord<m_nRecords; iRecord++)
+	{
+		pValues[iRecord] = m_Records[iRecord]->asDouble(iField);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Sets the values of field iField of all records from the vector
+  * Values, which must have one entry per record in storage order.
+*/
+bool CSG_Table::Set_Field_Values(int iField, const CSG_Vector &Values)
+{
+	if( iField < 0 || iField >= m_nFields || Values.Get_Size() != m_nRecords )
+	{
+		return( false );
+	}
+
+	const double *pValues = Values.Get_Data();
+
+	for(sLong iRecord=0; iRecord<m_nRecords; iRecord++)
+	{
+		m_Records[iRecord]->Set_Value(iField, pValues[iRecord]);
+	}
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1298,6 +1345,115 @@ bool CSG_Table::On_Update(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Columns							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Table_Column::CSG_Table_Column(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+CSG_Table_Column::CSG_Table_Column(const CSG_Table *pTable, int Field)
+{
+	Create(pTable, Field);
+}
+
+//---------------------------------------------------------
+CSG_Table_Column::~CSG_Table_Column(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Destroy(void)
+{
+	m_bString = false;
+	m_Field   = -1;
+	m_nValues = 0;
+	m_nNoData = 0;
+
+	m_Values .Destroy();
+	m_Chars  .Destroy();
+	m_NoData .Destroy();
+	m_Offsets.Destroy();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Create(const CSG_Table *pTable, int Field)
+{
+	Destroy();
+
+	if( !pTable || Field < 0 || Field >= pTable->Get_Field_Count() )
+	{
+		return( false );
+	}
+
+	sLong nValues = pTable->Get_Count();
+
+	m_bString = pTable->Get_Field_Type(Field) == SG_DATATYPE_String
+	         || pTable->Get_Field_Type(Field) == SG_DATATYPE_Date;
+
+	if( nValues > 0 )
+	{
+		if( !m_NoData.Create(sizeof(BYTE), (nValues + 7) / 8)
+		||  (m_bString ? !m_Offsets.Create(nValues) || !m_Chars.Create(sizeof(SG_Char), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_3) : !m_Values.Create(sizeof(double), nValues)) )
+		{
+			return( Destroy() && false );
+		}
+
+		memset(m_NoData.Get_Array(), 0, m_NoData.Get_uSize());
+	}
+
+	//-----------------------------------------------------
+	BYTE *NoData = (BYTE *)m_NoData.Get_Array(); double *Values = (double *)m_Values.Get_Array();
+
+	for(sLong i=0; i<nValues; i++)
+	{
+		CSG_Table_Record *pRecord = pTable->Get_Record(i);
+
+		if( pRecord->is_NoData(Field) )
+		{
+			NoData[i >> 3] |= 1 << (i & 7); m_nNoData++;
+		}
+
+		if( m_bString )	// append the string to the string pool, including the terminating null character
+		{
+			const SG_Char *String = pRecord->asString(Field); size_t Length = String ? SG_STR_LEN(String) : 0;
+
+			if( !m_Chars.Inc_Array(Length + 1) )
+			{
+				return( Destroy() && false );
+			}
+
+			SG_Char *Chars = (SG_Char *)m_Chars.Get_Array() + (m_Offsets[i] = m_Chars.Get_Size() - (Length + 1));
+
+			if( Length > 0 )
+			{
+				memcpy(Chars, String, Length * sizeof(SG_Char));
+			}
+
+			Chars[Length] = SG_T('\0');
+		}
+		else
+		{
+			Values[i] = pRecord->asDouble(Field);
+		}
+	}
+
+	m_Field   = Field;
+	m_nValues = nValues;
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						Index							 //
@@ -1375,40 +1531,26 @@ class CSG_Table_Record_Compare_Field : public CSG_Index::CSG_Index_Compare
 public:
 	CSG_Table_Record_Compare_Field(const CSG_Table *pTable, int Field, bool Ascending)
 	{
-		m_pTable	= pTable;
-		m_Field		= Field;
 		m_Ascending	= Ascending;
 
-		if( !m_pTable || m_Field < 0 || m_Field >= m_pTable->Get_Field_Count() )
-		{
-			m_pTable	= NULL;
-		}
+		m_Column.Create(pTable, Field);
 	}
 
-	bool				is_Okay		(void)	const	{	return( m_pTable != NULL );	}
+	bool				is_Okay		(void)	const	{	return( m_Column.is_Valid() );	}
 
 	virtual int			Compare		(const sLong _a, const sLong _b)
 	{
 		sLong a = m_Ascending ? _a : _b;
 		sLong b = m_Ascending ? _b : _a;
 
-		switch( m_pTable->Get_Field_Type(m_Field) )
+		if( m_Column.is_String() )
 		{
-		default: {
-			double d =
-				m_pTable->Get_Record(a)->asDouble(m_Field) -
-				m_pTable->Get_Record(b)->asDouble(m_Field);
-
-			return( d < 0. ? -1 : d > 0. ? 1 : 0 );
+			return( SG_STR_CMP(m_Column.asString(a), m_Column.asString(b)) );
 		}
 
-		case SG_DATATYPE_String:
-		case SG_DATATYPE_Date  :
-			return( SG_STR_CMP(
-				m_pTable->Get_Record(a)->asString(m_Field),
-				m_pTable->Get_Record(b)->asString(m_Field))
-			);
-		}
+		double d = m_Column.asDouble(a) - m_Column.asDouble(b);
+
+		return( d < 0. ? -1 : d > 0. ? 1 : 0 );
 	}
 
 
@@ -1416,9 +1558,7 @@ private:
 
 	bool				m_Ascending;
 
-	int					m_Field;
-
-	const CSG_Table		*m_pTable;
+	CSG_Table_Column	m_Column;
 
 };
 
@@ -1440,38 +1580,35 @@ class CSG_Table_Record_Compare_Fields : public CSG_Index::CSG_Index_Compare
 {
 public:
 	CSG_Table_Record_Compare_Fields(const CSG_Table *pTable, int Fields[], int nFields, bool Ascending)
-		: m_pTable(pTable), m_Fields(Fields), m_nFields(nFields)
 	{
 		m_Ascending.Create(nFields);
 
-		for(int i=0; m_pTable && i<m_nFields; i++)
+		for(int i=0; i<nFields; i++)
 		{
-			if( m_Fields[i] >= m_pTable->Get_Field_Count() )
-			{
-				m_pTable = NULL;
-			}
-
 			m_Ascending[i] = Ascending ? 1 : 0;
 		}
+
+		_Create(pTable, Fields, nFields);
 	}
 
 	CSG_Table_Record_Compare_Fields(const CSG_Table *pTable, int Fields[], int nFields, int Ascending[])
-		: m_pTable(pTable), m_Fields(Fields), m_nFields(nFields)
 	{
 		m_Ascending.Create(nFields);
 
-		for(int i=0; m_pTable && i<m_nFields; i++)
+		for(int i=0; i<nFields; i++)
 		{
-			if( m_Fields[i] >= m_pTable->Get_Field_Count() )
-			{
-				m_pTable = NULL;
-			}
-
 			m_Ascending[i] = Ascending[i] > 0 ? 1 : 0;
 		}
+
+		_Create(pTable, Fields, nFields);
+	}
+
+	virtual ~CSG_Table_Record_Compare_Fields(void)
+	{
+		delete[](m_Columns);
 	}
 
-	bool				is_Okay		(void)	const	{	return( m_pTable != NULL );	}
+	bool				is_Okay		(void)	const	{	return( m_Columns != NULL );	}
 
 	virtual int			Compare		(const sLong _a, const sLong _b)
 	{
@@ -1479,24 +1616,20 @@ public:
 
 		for(int i=0; !Difference && i<m_nFields; i++)
 		{
-			int	Field = m_Fields[i];
+			const CSG_Table_Column &Column = m_Columns[i];
 
 			sLong a = m_Ascending[i] ? _a : _b;
 			sLong b = m_Ascending[i] ? _b : _a;
 
-			switch( m_pTable->Get_Field_Type(Field) )
+			if( Column.is_String() )
 			{
-			default: {
-				double d = m_pTable->Get_Record(a)->asDouble(Field);
-				d       -= m_pTable->Get_Record(b)->asDouble(Field);
-				Difference = d < 0. ? -1 : d > 0. ? 1 : 0;
-			}	break;
+				Difference = SG_STR_CMP(Column.asString(a), Column.asString(b));
+			}
+			else
+			{
+				double d = Column.asDouble(a) - Column.asDouble(b);
 
-			case SG_DATATYPE_String:
-			case SG_DATATYPE_Date  :
-				CSG_String   s    (m_pTable->Get_Record(a)->asString(Field));
-				Difference = s.Cmp(m_pTable->Get_Record(b)->asString(Field));
-				break;
+				Difference = d < 0. ? -1 : d > 0. ? 1 : 0;
 			}
 		}
 
@@ -1506,11 +1639,27 @@ public:
 
 private:
 
-	int					*m_Fields, m_nFields;
+	int					m_nFields;
 
 	CSG_Array_Int		m_Ascending;
 
-	const CSG_Table		*m_pTable;
+	CSG_Table_Column	*m_Columns;
+
+
+	void				_Create		(const CSG_Table *pTable, int Fields[], int nFields)
+	{
+		m_nFields = nFields; m_Columns = new CSG_Table_Column[nFields];
+
+		for(int i=0; i<nFields; i++)
+		{
+			if( !m_Columns[i].Create(pTable, Fields[i]) )
+			{
+				delete[](m_Columns); m_Columns = NULL;
+
+				return;
+			}
+		}
+	}
 
 };
 
@@ -272,6 +272,66 @@ protected:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Table_Column takes a snapshot of a table field's values
+* and stores it column-wise, i.e. numeric values in one contiguous
+* array of doubles, text (string and date) values in one string
+* pool, and the no-data state of all records in a bit map. Use it
+* for repeated scans or comparisons of a field's values, which
+* then neither need to access the records nor to call virtual
+* value accessors. The snapshot does not follow later changes of
+* the table. It is a transient copy, so take it only where values
+* are visited more than once, e.g. for sorting. Single pass scans
+* read the records directly.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Table_Column
+{
+public:
+	CSG_Table_Column(void);
+	virtual ~CSG_Table_Column(void);
+
+									CSG_Table_Column	(const class CSG_Table *pTable, int Field);
+	bool							Create				(const class CSG_Table *pTable, int Field);
+
+	bool							Destroy				(void);
+
+	bool							is_Valid			(void)		const	{	return( m_Field >= 0 );	}
+	bool							is_String			(void)		const	{	return( m_bString    );	}
+
+	int								Get_Field			(void)		const	{	return( m_Field      );	}
+	sLong							Get_Count			(void)		const	{	return( m_nValues    );	}
+	sLong							Get_NoData_Count	(void)		const	{	return( m_nNoData    );	}
+
+	bool							is_NoData			(sLong i)	const	{	return( (((const BYTE *)m_NoData.Get_Array())[i >> 3] & (1 << (i & 7))) != 0 );	}
+
+	const double *					Get_Values			(void)		const	{	return( (const double *)m_Values.Get_Array() );	}
+	double							asDouble			(sLong i)	const	{	return( ((const double *)m_Values.Get_Array())[i] );	}
+	const SG_Char *					asString			(sLong i)	const	{	return( m_bString ? (const SG_Char *)m_Chars.Get_Array() + m_Offsets[i] : NULL );	}
+
+
+private:
+
+	bool							m_bString;
+
+	int								m_Field;
+
+	sLong							m_nValues, m_nNoData;
+
+	CSG_Array						m_Values, m_Chars, m_NoData;
+
+	CSG_Array_sLong					m_Offsets;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -414,6 +474,9 @@ public:
 	virtual bool					Get_Value			(sLong Index, int iField, CSG_String     &Value)	const;
 	virtual bool					Get_Value			(sLong Index, int iField, double         &Value)	const;
 
+	virtual bool					Get_Field_Values	(int iField, CSG_Vector &Values)	const;
+	virtual bool					Set_Field_Values	(int iField, const CSG_Vector &Values);
+
 	virtual void					Set_Modified		(bool bModified = true);
 
 	//-----------------------------------------------------
@@ -497,8 +560,9 @@ private:
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
-	size_t							_Load_Text_Trim		(      CSG_String &Text, const SG_Char Separator);
-	size_t							_Load_Text_EndQuote	(const CSG_String &Text, const SG_Char Separator);
+	static bool						_Load_Text_Token	(const SG_Char *&pLine, const SG_Char Separator, const SG_Char *&Token, size_t &Length, bool &bQuoted);
+	static bool						_Load_Text_Number	(const SG_Char *Token, size_t Length, double &Value, bool &bInteger);
+	bool							_Load_Text_Record	(CSG_Table_Record *pRecord, const CSG_String &Line, const SG_Char Separator, TSG_Data_Type *Types)	const;
 
 	bool							_Load_Text			(const CSG_String &File, bool bHeadline, const SG_Char Separator);
 	bool							_Load_DBase			(const CSG_String &File);
@@ -53,6 +53,10 @@
 #include "table.h"
 #include "table_dbase.h"
 
+#include <cerrno>
+#include <clocale>
+#include <string>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -154,6 +158,8 @@ bool CSG_Table::Save(const CSG_String &FileName, int Format)
 //---------------------------------------------------------
 bool CSG_Table::Save(const CSG_String &FileName, int Format, SG_Char Separator, int Encoding)
 {
+	CSG_Profiler_Region Profile("save", FileName, "table");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("table"), FileName.c_str()), true);
 
 	Set_File_Encoding(Encoding);
@@ -232,59 +238,183 @@ bool CSG_Table::Save(const CSG_String &FileName, int Format, SG_Char Separator,
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-size_t CSG_Table::_Load_Text_Trim(CSG_String &s, const SG_Char Separator)
+#define TEXT_BATCH_LINES	16384	// number of lines read at once, the first batch also serves as sample for the field type detection
+
+//---------------------------------------------------------
+/**
+* Splits the next field from the line and advances pLine behind
+* its separator. Leading white space is skipped. A field value
+* enclosed in quotes may contain separators. Returns false if
+* the end of the line has been reached.
+*/
+//---------------------------------------------------------
+bool CSG_Table::_Load_Text_Token(const SG_Char *&pLine, const SG_Char Separator, const SG_Char *&Token, size_t &Length, bool &bQuoted)
 {
-	for(size_t i=0; i<s.Length(); i++)
+	while( *pLine && *pLine != Separator && (*pLine == ' ' || *pLine == '\t' || *pLine == '\n' || *pLine == '\v' || *pLine == '\f' || *pLine == '\r') )
+	{
+		pLine++;
+	}
+
+	if( !*pLine )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	const SG_Char *pEnd = NULL;
+
+	if( pLine[0] == '\"' && pLine[1] )	// value in quotes, find the separator behind the closing quote
 	{
-		SG_Char	c	= s[i];
+		bool bInQuotes = true; const SG_Char *p = pLine + 1;
 
-		if( c == Separator || (c != ' ' && c != '\t' && c != '\n' && c != '\v' && c != '\f' && c != '\r') )
+		for( ; *p && (bInQuotes || *p != Separator); p++)
 		{
-			if( i > 0 )
+			if( *p == '\"' )
 			{
-				s	= s.Right(s.Length() - i);
+				bInQuotes = !bInQuotes;
 			}
+		}
 
-			return( i );
+		if( *p == Separator || p[-1] == '\"' )
+		{
+			pEnd = p;
 		}
 	}
 
-	return( 0 );
+	if( pEnd )
+	{
+		bQuoted = true; Token = pLine + 1; Length = pEnd - pLine > 2 ? pEnd - pLine - 2 : 0;
+	}
+	else
+	{
+		for(pEnd=pLine; *pEnd && *pEnd != Separator; pEnd++) {}
+
+		bQuoted = false; Token = pLine; Length = pEnd - pLine;
+	}
+
+	pLine = *pEnd ? pEnd + 1 : pEnd;
+
+	return( true );
 }
 
 //---------------------------------------------------------
-size_t	CSG_Table::_Load_Text_EndQuote(const CSG_String &s, const SG_Char Separator)
+/**
+* Locale independent conversion of a number. Accepts what the
+* C library's strtod() accepts in the "C" locale, including
+* exponents, hexadecimal numbers, "inf" and "nan". Returns false
+* if the token is not a number as a whole or if it is out of the
+* range of a double. bInteger is set to true if the number has no
+* decimal point and fits into an integer.
+*/
+//---------------------------------------------------------
+bool CSG_Table::_Load_Text_Number(const SG_Char *Token, size_t Length, double &Value, bool &bInteger)
 {
-	if( s.Length() > 1 && s[0] == '\"' )
+	const struct lconv *pLocale = localeconv();	// strtod() expects the decimal point of the current locale
+
+	const char Point = pLocale && pLocale->decimal_point && *pLocale->decimal_point ? *pLocale->decimal_point : '.';
+
+	char Buffer[64]; std::string Long; char *Number = Buffer;
+
+	if( Length >= sizeof(Buffer) )
 	{
-		bool	bInQuotes	= true;
+		Long.resize(Length + 1); Number = &Long[0];
+	}
+
+	bool bPoint = false;
 
-		for(size_t i=1; i<s.Length(); i++)
+	for(size_t i=0; i<Length; i++)
+	{
+		if( Token[i] < 1 || Token[i] > 127 || (Point != '.' && Token[i] == Point) )	// a number is plain ascii
 		{
-			if( bInQuotes )
+			return( false );
+		}
+
+		if( Token[i] == '.' )
+		{
+			bPoint = true; Number[i] = Point;
+		}
+		else
+		{
+			Number[i] = (char)Token[i];
+		}
+	}
+
+	Number[Length] = '\0';
+
+	//-----------------------------------------------------
+	char *End; errno = 0;
+
+	Value = strtod(Number, &End);
+
+	if( End == Number || *End || errno == ERANGE )
+	{
+		return( false );
+	}
+
+	bInteger = !bPoint && Value >= -2147483648. && Value <= 2147483647. && Value == floor(Value);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Sets the record's values from a line of text. If a value does
+* not match the type of its field, the type, to which the field
+* needs to be promoted, is stored in Types.
+*/
+//---------------------------------------------------------
+bool CSG_Table::_Load_Text_Record(CSG_Table_Record *pRecord, const CSG_String &Line, const SG_Char Separator, TSG_Data_Type *Types) const
+{
+	const SG_Char *pLine = Line.c_str(), *Token; size_t Length; bool bQuoted, bOkay = true;
+
+	for(int iField=0; iField<m_nFields; iField++)
+	{
+		CSG_Table_Value &Value = *pRecord->m_Values[iField];
+
+		if( !_Load_Text_Token(pLine, Separator, Token, Length, bQuoted) || Length < 1 )
+		{
+			if( m_Field_Type[iField] == SG_DATATYPE_String )
 			{
-				if( s[i] == '\"' )
-				{
-					bInQuotes	= false;
-				}
+				Value.Set_Value(SG_T(""));
 			}
-			else if( s[i] == '\"' )
+			else
 			{
-				bInQuotes	= true;
+				Value.Set_Value(Get_NoData_Value());
 			}
-			else if( s[i] == Separator )
+
+			continue;
+		}
+
+		if( m_Field_Type[iField] == SG_DATATYPE_String )
+		{
+			Value.Set_Value(Line.Mid(Token - Line.c_str(), Length).c_str());
+
+			continue;
+		}
+
+		//-------------------------------------------------
+		double d; bool bInteger;
+
+		if( bQuoted || !_Load_Text_Number(Token, Length, d, bInteger) )
+		{
+			Types[iField] = SG_DATATYPE_String; bOkay = false;
+		}
+		else if( m_Field_Type[iField] == SG_DATATYPE_Int && !bInteger )
+		{
+			if( Types[iField] != SG_DATATYPE_String )
 			{
-				return( i );
+				Types[iField] = SG_DATATYPE_Double;
 			}
-		}
 
-		if( s[s.Length() - 1] == '\"' )
+			bOkay = false;
+		}
+		else
 		{
-			return( s.Length() );
+			Value.Set_Value(d);
 		}
 	}
 
-	return( 0 );
+	return( bOkay );
 }
 
 //---------------------------------------------------------
@@ -312,138 +442,197 @@ bool CSG_Table::_Load_Text(const CSG_String &FileName, bool bHeadline, const SG_
 	}
 
 	//-----------------------------------------------------
-	CSG_Table	Table;
+	CSG_Strings	Names;
 
-	_Load_Text_Trim(sLine, Separator);
-
-	while( !sLine.is_Empty() )
 	{
-		CSG_String	sField;
+		const SG_Char *pLine = sLine.c_str(), *Token; size_t Length; bool bQuoted;
 
-		if( sLine[0] == '\"' )	// value in quotas
-		{
-			sField	= sLine.AfterFirst('\"').BeforeFirst('\"');
-			sLine	= sLine.AfterFirst('\"').AfterFirst ('\"');
-		}
-		else
+		while( _Load_Text_Token(pLine, Separator, Token, Length, bQuoted) )
 		{
-			sField	= sLine.BeforeFirst(Separator);
-		}
-
-		sLine	= sLine.AfterFirst(Separator);	_Load_Text_Trim(sLine, Separator);
-
-		if( !bHeadline || sField.Length() == 0 )
-		{
-			sField.Printf("F%02d", Table.Get_Field_Count() + 1);
+			if( !bHeadline || Length < 1 )
+			{
+				Names.Add(CSG_String::Format("F%02d", Names.Get_Count() + 1));
+			}
+			else
+			{
+				Names.Add(sLine.Mid(Token - sLine.c_str(), Length));
+			}
 		}
+	}
 
-		Table.Add_Field(sField, SG_DATATYPE_String);
+	if( Names.Get_Count() < 1 )
+	{
+		return( false );
 	}
 
 	//-----------------------------------------------------
-	TSG_Data_Type	*Type	= new TSG_Data_Type[Table.Get_Field_Count()];
+	// field types are detected from the first batch of lines,
+	// if a later value does not match its field's type, the
+	// field type is promoted in place and the batch is read again
+
+	CSG_Array Array(sizeof(TSG_Data_Type), Names.Get_Count());
+
+	TSG_Data_Type *Promote = (TSG_Data_Type *)Array.Get_Array();
 
-	for(int iField=0; iField<Table.Get_Field_Count(); iField++)
+	for(int iField=0; iField<Names.Get_Count(); iField++)
 	{
-		Type[iField]	= SG_DATATYPE_Int;
+		Promote[iField] = SG_DATATYPE_Undefined;
 	}
 
-	if( !bHeadline )
+	int nThreads = SG_OMP_Get_Max_Num_Threads();	// each thread collects its own promotions
+
+	CSG_Array Thread_Array(sizeof(TSG_Data_Type), (sLong)nThreads * Names.Get_Count());
+
+	TSG_Data_Type *Thread_Promote = (TSG_Data_Type *)Thread_Array.Get_Array();
+
+	CSG_Strings Lines; Lines.Set_Count(TEXT_BATCH_LINES);
+
+	Stream.Seek_Start();
+
+	if( bHeadline )
 	{
-		Stream.Seek_Start();
+		Stream.Read_Line(sLine);
 	}
 
-	while( Stream.Read_Line(sLine) && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+	sLong Data_Start = Stream.Tell();
+
+	for(int nLines=TEXT_BATCH_LINES; nLines==TEXT_BATCH_LINES && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength); )
 	{
-		if( sLine.Length() < 1 )
+		for(nLines=0; nLines<TEXT_BATCH_LINES && Stream.Read_Line(Lines[nLines]); )
 		{
-			continue;
+			if( Lines[nLines].Length() > 0 )
+			{
+				nLines++;
+			}
 		}
 
-		CSG_Table_Record *pRecord = Table.Add_Record();
-
-		_Load_Text_Trim(sLine, Separator);
-
-		for(int iField=0; iField<Table.Get_Field_Count() && !sLine.is_Empty(); iField++)
+		//-------------------------------------------------
+		if( m_nFields < 1 )	// first batch, detect field types
 		{
-			size_t Position = _Load_Text_EndQuote(sLine, Separator); CSG_String sField;
-
-			if( Position > 0 )	// value in quotas !!!
+			for(int iLine=0; iLine<nLines; iLine++)
 			{
-				if( Position - 2 > 0 )
-				{
-					sField	= sLine.Mid(1, Position - 2);
-				}
-				else
+				const SG_Char *pLine = Lines[iLine].c_str(), *Token; size_t Length; bool bQuoted;
+
+				for(int iField=0; iField<Names.Get_Count() && _Load_Text_Token(pLine, Separator, Token, Length, bQuoted); iField++)
 				{
-					sField.Clear();
+					double Value; bool bInteger;
+
+					if( Length > 0 && Promote[iField] != SG_DATATYPE_String )
+					{
+						Promote[iField] = bQuoted || !_Load_Text_Number(Token, Length, Value, bInteger) ? SG_DATATYPE_String
+							: !bInteger ? SG_DATATYPE_Double : Promote[iField] != SG_DATATYPE_Double ? SG_DATATYPE_Int : SG_DATATYPE_Double;
+					}
 				}
+			}
 
-				sLine	= sLine.Right(sLine.Length() - Position);
+			for(int iField=0; iField<Names.Get_Count(); iField++)
+			{
+				Add_Field(Names[iField], Promote[iField] != SG_DATATYPE_Undefined ? Promote[iField] : SG_DATATYPE_Int); Promote[iField] = SG_DATATYPE_Undefined;
+			}
+		}
+
+		//-------------------------------------------------
+		sLong nRecords = m_nRecords;
+
+		if( !Set_Count(nRecords + nLines) )
+		{
+			return( false );
+		}
+
+		bool bPromote = true;
 
-				Type[iField]	= SG_DATATYPE_String;
+		while( bPromote )
+		{
+			bPromote = false;
+
+			for(sLong i=0; i<(sLong)nThreads * Names.Get_Count(); i++)
+			{
+				Thread_Promote[i] = SG_DATATYPE_Undefined;
 			}
-			else
+
+			#pragma omp parallel for reduction(||:bPromote)
+			for(int iLine=0; iLine<nLines; iLine++)
 			{
-				sField	= sLine.BeforeFirst(Separator);
+				if( !_Load_Text_Record(m_Records[nRecords + iLine], Lines[iLine], Separator, Thread_Promote + SG_OMP_Get_Thread_Num() * Names.Get_Count()) )
+				{
+					bPromote = true;
+				}
 			}
 
-			sLine	= sLine.AfterFirst(Separator);	_Load_Text_Trim(sLine, Separator);
+			if( !bPromote )
+			{
+				continue;
+			}
 
 			//---------------------------------------------
-			if( Type[iField] != SG_DATATYPE_String && !sField.is_Empty() )
+			// merge the promotions of all threads, string wins over double
+
+			bool bString = false;
+
+			for(int iField=0; iField<Names.Get_Count(); iField++)
 			{
-				try
+				for(int iThread=0; iThread<nThreads; iThread++)
 				{
-					size_t pos; double Value = std::stod(sField.to_StdString(), &pos);
+					TSG_Data_Type Type = Thread_Promote[iThread * Names.Get_Count() + iField];
 
-					if( pos < sField.Length() )
+					if( Type == SG_DATATYPE_String || (Type == SG_DATATYPE_Double && Promote[iField] != SG_DATATYPE_String) )
 					{
-						Type[iField]	= SG_DATATYPE_String;
-					}
-					else if( Type[iField] != SG_DATATYPE_Double && (Value - (int)Value != 0. || sField.Find('.') >= 0) )
-					{
-						Type[iField]	= SG_DATATYPE_Double;
+						Promote[iField] = Type;
 					}
 				}
-				catch(...)
+
+				if( Promote[iField] == SG_DATATYPE_String )
 				{
-					Type[iField]	= SG_DATATYPE_String;
+					bString = true;
 				}
-			}
 
-			pRecord->Set_Value(iField, sField);
-		}
-	}
-
-	//-----------------------------------------------------
-	if( Table.Get_Field_Count() > 0 )
-	{
-		for(int iField=0; iField<Table.Get_Field_Count(); iField++)
-		{
-			Add_Field(Table.Get_Field_Name(iField), Type[iField]);
-		}
+				if( Promote[iField] != SG_DATATYPE_Undefined )	// numbers convert without loss
+				{
+					Set_Field_Type(iField, Promote[iField]);
+				}
+			}
 
-		for(sLong iRecord=0; iRecord<Table.Get_Count() && SG_UI_Process_Set_Progress(iRecord, Table.Get_Count()); iRecord++)
-		{
-			CSG_Table_Record *pRecord = Add_Record();
+			//---------------------------------------------
+			// numbers that have been loaded before into a field that
+			// is now a string field get back their original text
 
-			for(int iField=0; iField<Get_Field_Count(); iField++)
+			if( bString && nRecords > 0 )
 			{
-				if( *Table[iRecord].asString(iField) )
-				{
-					pRecord->Set_Value(iField, Table[iRecord].asString(iField));
-				}
-				else
+				sLong Position = Stream.Tell(); Stream.Seek(Data_Start);
+
+				for(sLong iRecord=0; iRecord<nRecords && Stream.Read_Line(sLine); )
 				{
-					pRecord->Set_NoData(iField);
+					if( sLine.Length() < 1 )
+					{
+						continue;
+					}
+
+					const SG_Char *pLine = sLine.c_str(), *Token; size_t Length; bool bQuoted;
+
+					for(int iField=0; iField<Names.Get_Count(); iField++)
+					{
+						bool bToken = _Load_Text_Token(pLine, Separator, Token, Length, bQuoted);
+
+						if( Promote[iField] == SG_DATATYPE_String )
+						{
+							m_Records[iRecord]->Set_Value(iField, bToken && Length > 0 ? sLine.Mid(Token - sLine.c_str(), Length).c_str() : SG_T(""));
+						}
+					}
+
+					iRecord++;
 				}
+
+				Stream.Seek(Position);
+			}
+
+			for(int iField=0; iField<Names.Get_Count(); iField++)
+			{
+				Promote[iField] = SG_DATATYPE_Undefined;
 			}
 		}
 	}
 
-	delete[](Type);
-
+	//-----------------------------------------------------
 	SG_UI_Process_Set_Ready();
 
 	return( Get_Field_Count() > 0 );
@@ -47,19 +47,26 @@
 //                                                       //
 //    e-mail:     oconrad@saga-gis.org                   //
 //                                                       //
-///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
 //
-// The Delaunay Triangulation algorithm used here is based
-// on Paul Bourke's C source codes, which can be found at:
-//
-//     http://astronomy.swin.edu.au/~pbourke/
+// Delaunay triangulation by incremental insertion (Bowyer-
+// Watson). Points are inserted in the order of a Hilbert
+// curve, and the triangle in conflict with the next point is
+// found by walking from the last created triangle, so that
+// the expected effort per point is constant. The convex hull
+// is handled with 'ghost' triangles sharing an infinite vertex
+// instead of a super triangle. Orientation and in-circle tests
+// use adaptive floating point filters with an exact fallback
+// based on floating point expansions (Shewchuk 1997).
 //
 //---------------------------------------------------------
 
 
 //---------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
 #include "tin.h"
 
 
@@ -86,344 +93,653 @@ int SG_TIN_Compare(const void *pp1, const void *pp2)
 
 ///////////////////////////////////////////////////////////
 //														 //
-//														 //
+//					Robust Predicates					 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_TIN::_Triangulate(void)
+static const double	SG_TIN_Epsilon		= 1.1102230246251565e-16;	// 2^-53
+static const double	SG_TIN_Orient_Bound	= ( 3. + 16. * SG_TIN_Epsilon) * SG_TIN_Epsilon;
+static const double	SG_TIN_Circle_Bound	= (10. + 96. * SG_TIN_Epsilon) * SG_TIN_Epsilon;
+
+//---------------------------------------------------------
+static inline void	SG_TIN_Two_Sum		(double a, double b, double &x, double &y)
 {
-	_Destroy_Edges(); _Destroy_Triangles();
+	x = a + b; double bv = x - a, av = x - bv; y = (a - av) + (b - bv);
+}
 
-	//-----------------------------------------------------
-	CSG_TIN_Node **Nodes = (CSG_TIN_Node **)SG_Malloc((Get_Node_Count() + 3l) * sizeof(CSG_TIN_Node *));
+static inline void	SG_TIN_Fast_Two_Sum	(double a, double b, double &x, double &y)
+{
+	x = a + b; y = b - (x - a);
+}
 
-	for(sLong i=0; i<Get_Node_Count(); i++)
-	{
-		Nodes[i] = Get_Node(i); Nodes[i]->_Del_Relations();
-	}
+static inline void	SG_TIN_Two_Diff		(double a, double b, double &x, double &y)
+{
+	x = a - b; double bv = a - x, av = x + bv; y = (a - av) + (bv - b);
+}
 
-	//-----------------------------------------------------
-	qsort(Nodes, Get_Node_Count(), sizeof(CSG_TIN_Node *), SG_TIN_Compare);
+static inline void	SG_TIN_Two_Product	(double a, double b, double &x, double &y)
+{
+	x = a * b; y = fma(a, b, -x);
+}
 
-	for(sLong i=0, j=0, n=Get_Node_Count(); j<n; i++) // remove duplicates
+//---------------------------------------------------------
+// Expansions are arrays of non-overlapping components ordered
+// by increasing magnitude, the sign of an expansion is the sign
+// of its last (largest) component.
+
+//---------------------------------------------------------
+static int SG_TIN_Exp_Sum(int ne, const double *e, int nf, const double *f, double *h)
+{
+	int ie = 0, iff = 0, n = 0; double en = e[0], fn = f[0], Q, q;
+
+	if( (fn > en) == (fn > -en) ) { Q = en; en = ++ie < ne ? e[ie] : 0.; } else { Q = fn; fn = ++iff < nf ? f[iff] : 0.; }
+
+	if( ie < ne && iff < nf )
 	{
-		Nodes[i] = Nodes[j++];
+		if( (fn > en) == (fn > -en) ) { SG_TIN_Fast_Two_Sum(en, Q, Q, q); en = ++ie < ne ? e[ie] : 0.; } else { SG_TIN_Fast_Two_Sum(fn, Q, Q, q); fn = ++iff < nf ? f[iff] : 0.; }
 
-		while( j < n
-			&& Nodes[i]->Get_X() == Nodes[j]->Get_X()
-			&& Nodes[i]->Get_Y() == Nodes[j]->Get_Y() )
+		if( q != 0. ) { h[n++] = q; }
+
+		while( ie < ne && iff < nf )
 		{
-			Del_Node(Nodes[j++]->Get_Index(), false);
+			if( (fn > en) == (fn > -en) ) { SG_TIN_Two_Sum(Q, en, Q, q); en = ++ie < ne ? e[ie] : 0.; } else { SG_TIN_Two_Sum(Q, fn, Q, q); fn = ++iff < nf ? f[iff] : 0.; }
+
+			if( q != 0. ) { h[n++] = q; }
 		}
 	}
 
-	//-----------------------------------------------------
-	for(sLong i=Get_Node_Count(); i<Get_Node_Count()+3l; i++)
+	while( ie  < ne ) { SG_TIN_Two_Sum(Q, en, Q, q); en = ++ie  < ne ? e[ie ] : 0.; if( q != 0. ) { h[n++] = q; } }
+	while( iff < nf ) { SG_TIN_Two_Sum(Q, fn, Q, q); fn = ++iff < nf ? f[iff] : 0.; if( q != 0. ) { h[n++] = q; } }
+
+	if( Q != 0. || n == 0 ) { h[n++] = Q; }
+
+	return( n );
+}
+
+//---------------------------------------------------------
+static int SG_TIN_Exp_Scale(int ne, const double *e, double b, double *h)
+{
+	int n = 0; double Q, q, p1, p0, s;
+
+	SG_TIN_Two_Product(e[0], b, Q, q); if( q != 0. ) { h[n++] = q; }
+
+	for(int i=1; i<ne; i++)
 	{
-		Nodes[i] = new CSG_TIN_Node(this, 0);
+		SG_TIN_Two_Product(e[i], b, p1, p0);
+		SG_TIN_Two_Sum     (Q, p0, s, q); if( q != 0. ) { h[n++] = q; }
+		SG_TIN_Fast_Two_Sum(p1, s, Q, q); if( q != 0. ) { h[n++] = q; }
 	}
 
-	//-----------------------------------------------------
-	TTIN_Triangle *Triangles = (TTIN_Triangle *)SG_Malloc(Get_Node_Count() * 3l * sizeof(TTIN_Triangle));
+	if( Q != 0. || n == 0 ) { h[n++] = Q; }
 
-	int nTriangles; bool bResult = _Triangulate(Nodes, (int)Get_Node_Count(), Triangles, nTriangles);
+	return( n );
+}
 
-	if( bResult )
+//---------------------------------------------------------
+static int SG_TIN_Exp_Product(int ne, const double *e, int nf, const double *f, double *h) // h must hold 2 * ne * nf components
+{
+	double s[64], t[1024]; int n = SG_TIN_Exp_Scale(ne, e, f[0], h);
+
+	for(int i=1; i<nf; i++)
 	{
-		for(int i=0; i<nTriangles && SG_UI_Process_Set_Progress(i, nTriangles); i++)
-		{
-			_Add_Triangle(Nodes[Triangles[i].p1], Nodes[Triangles[i].p2], Nodes[Triangles[i].p3]);
-		}
+		int ns = SG_TIN_Exp_Scale(ne, e, f[i], s);
+
+		n = SG_TIN_Exp_Sum(n, h, ns, s, t); memcpy(h, t, n * sizeof(double));
 	}
 
-	SG_Free(Triangles);
+	return( n );
+}
 
-	//-----------------------------------------------------
-	for(sLong i=Get_Node_Count(); i<Get_Node_Count()+3l; i++)
+//---------------------------------------------------------
+static inline int SG_TIN_Exp_Diff(double a, double b, double *h)
+{
+	SG_TIN_Two_Diff(a, b, h[1], h[0]);
+
+	if( h[0] == 0. ) { h[0] = h[1]; return( 1 ); }
+
+	return( 2 );
+}
+
+//---------------------------------------------------------
+static inline void SG_TIN_Exp_Negate(int n, double *e)
+{
+	for(int i=0; i<n; i++) { e[i] = -e[i]; }
+}
+
+//---------------------------------------------------------
+static int SG_TIN_Orient_Exact(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c)
+{
+	double acx[2], bcy[2], acy[2], bcx[2], l[8], r[8], d[16];
+
+	int nacx = SG_TIN_Exp_Diff(a.x, c.x, acx), nbcy = SG_TIN_Exp_Diff(b.y, c.y, bcy);
+	int nacy = SG_TIN_Exp_Diff(a.y, c.y, acy), nbcx = SG_TIN_Exp_Diff(b.x, c.x, bcx);
+
+	int nl = SG_TIN_Exp_Product(nacx, acx, nbcy, bcy, l);
+	int nr = SG_TIN_Exp_Product(nacy, acy, nbcx, bcx, r); SG_TIN_Exp_Negate(nr, r);
+	int nd = SG_TIN_Exp_Sum(nl, l, nr, r, d);
+
+	return( d[nd - 1] > 0. ? 1 : d[nd - 1] < 0. ? -1 : 0 );
+}
+
+//---------------------------------------------------------
+/** Returns 1 if c lies left of the line from a to b, -1 if it lies right of it, 0 if the three points are collinear. */
+static inline int SG_TIN_Orient(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c)
+{
+	double l = (a.x - c.x) * (b.y - c.y);
+	double r = (a.y - c.y) * (b.x - c.x), d = l - r;
+
+	if( fabs(d) > SG_TIN_Orient_Bound * (fabs(l) + fabs(r)) )
 	{
-		delete(Nodes[i]);
+		return( d > 0. ? 1 : -1 );
 	}
 
-	SG_Free(Nodes);
+	return( SG_TIN_Orient_Exact(a, b, c) );
+}
 
-	SG_UI_Process_Set_Ready();
+//---------------------------------------------------------
+static int SG_TIN_InCircle_Term(const double *ax, int nax, const double *ay, int nay, const double *bx, int nbx, const double *by, int nby, const double *cx, int ncx, const double *cy, int ncy, double *h)
+{
+	double s[16], t[16], lift[16], det[16];
 
-	return( bResult );
+	int ns = SG_TIN_Exp_Product(nax, ax, nax, ax, s);
+	int nt = SG_TIN_Exp_Product(nay, ay, nay, ay, t);
+	int nl = SG_TIN_Exp_Sum(ns, s, nt, t, lift);	// ax² + ay²
+
+	ns = SG_TIN_Exp_Product(nbx, bx, ncy, cy, s);
+	nt = SG_TIN_Exp_Product(nby, by, ncx, cx, t); SG_TIN_Exp_Negate(nt, t);
+	int nd = SG_TIN_Exp_Sum(ns, s, nt, t, det);		// bx * cy - by * cx
+
+	return( SG_TIN_Exp_Product(nl, lift, nd, det, h) );
+}
+
+//---------------------------------------------------------
+static int SG_TIN_InCircle_Exact(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c, const TSG_Point &d)
+{
+	double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2], A[512], B[512], C[512], AB[1024], ABC[1536];
+
+	int nadx = SG_TIN_Exp_Diff(a.x, d.x, adx), nady = SG_TIN_Exp_Diff(a.y, d.y, ady);
+	int nbdx = SG_TIN_Exp_Diff(b.x, d.x, bdx), nbdy = SG_TIN_Exp_Diff(b.y, d.y, bdy);
+	int ncdx = SG_TIN_Exp_Diff(c.x, d.x, cdx), ncdy = SG_TIN_Exp_Diff(c.y, d.y, cdy);
+
+	int nA = SG_TIN_InCircle_Term(adx, nadx, ady, nady, bdx, nbdx, bdy, nbdy, cdx, ncdx, cdy, ncdy, A);
+	int nB = SG_TIN_InCircle_Term(bdx, nbdx, bdy, nbdy, cdx, ncdx, cdy, ncdy, adx, nadx, ady, nady, B);
+	int nC = SG_TIN_InCircle_Term(cdx, ncdx, cdy, ncdy, adx, nadx, ady, nady, bdx, nbdx, bdy, nbdy, C);
+
+	int nAB  = SG_TIN_Exp_Sum(nA , A , nB, B, AB );
+	int nABC = SG_TIN_Exp_Sum(nAB, AB, nC, C, ABC);
+
+	return( ABC[nABC - 1] > 0. ? 1 : ABC[nABC - 1] < 0. ? -1 : 0 );
+}
+
+//---------------------------------------------------------
+/** Returns 1 if d lies inside the circumcircle of the counter-clockwise triangle a, b, c, -1 if outside, 0 if on the circle. */
+static inline int SG_TIN_InCircle(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c, const TSG_Point &d)
+{
+	double adx = a.x - d.x, ady = a.y - d.y;
+	double bdx = b.x - d.x, bdy = b.y - d.y;
+	double cdx = c.x - d.x, cdy = c.y - d.y;
+
+	double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy, alift = adx * adx + ady * ady;
+	double cdxady = cdx * ady, adxcdy = adx * cdy, blift = bdx * bdx + bdy * bdy;
+	double adxbdy = adx * bdy, bdxady = bdx * ady, clift = cdx * cdx + cdy * cdy;
+
+	double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+	double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift
+	                 + (fabs(cdxady) + fabs(adxcdy)) * blift
+	                 + (fabs(adxbdy) + fabs(bdxady)) * clift;
+
+	if( fabs(det) > SG_TIN_Circle_Bound * permanent )
+	{
+		return( det > 0. ? 1 : -1 );
+	}
+
+	return( SG_TIN_InCircle_Exact(a, b, c, d) );
 }
 
 
 ///////////////////////////////////////////////////////////
 //														 //
+//					Delaunay Triangulation				 //
+//														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_TIN::_Triangulate(CSG_TIN_Node **Points, int nPoints, TTIN_Triangle *Triangles, int &nTriangles)
+class CSG_TIN_Delaunay
 {
-	if( nPoints >= 3 ) // Update extent...
+public:
+
+	CSG_TIN_Delaunay(const TSG_Point *Points, int nPoints) : m_Points(Points), m_nPoints(nPoints), m_Last(-1), m_Stamp(0) {}
+
+	bool							Triangulate			(void);
+
+	int								Get_Count			(void)	const	{	return( (int)m_Triangles.size() );	}
+	bool							Get_Triangle		(int i, int &a, int &b, int &c)	const
 	{
-		m_Extent.Assign(Points[0]->Get_Point(), Points[0]->Get_Point());
+		const TTriangle &t = m_Triangles[i];
 
-		for(int i=1; i<nPoints; i++)
+		if( t.V[0] < 0 || t.V[1] < 0 || t.V[2] < 0 ) // infinite (ghost) or deleted
 		{
-			m_Extent.Union(Points[i]->Get_Point());
+			return( false );
 		}
+
+		a = t.V[0]; b = t.V[1]; c = t.V[2];
+
+		return( true );
 	}
-	else
+
+
+private:
+
+	enum
 	{
-		return( false );
+		TIN_INFINITE	= -1,
+		TIN_DELETED		= -2
+	};
+
+	typedef struct
+	{
+		int							V[3], N[3];		// vertices (counter-clockwise) and neighbours (opposite to the vertex with the same index)
+	}
+	TTriangle;
+
+	typedef struct
+	{
+		int							Triangle, Vertex;
+	}
+	TLink;
+
+
+	const TSG_Point					*m_Points;
+
+	int								m_nPoints, m_Last, m_Stamp;
+
+	std::vector<int>				m_Mark, m_Free, m_Stack, m_Cavity, m_Boundary;
+
+	std::vector<TLink>				m_Links;
+
+	std::vector<TTriangle>			m_Triangles;
+
+
+	bool							_Get_Order			(std::vector<int> &Order);
+
+	int								_Add_Triangle		(int a, int b, int c);
+
+	bool							is_Ghost			(int t)	const	{	const TTriangle &T = m_Triangles[t]; return( T.V[0] == TIN_INFINITE || T.V[1] == TIN_INFINITE || T.V[2] == TIN_INFINITE );	}
+
+	bool							_is_Conflict		(int t, const TSG_Point &p)	const;
+	int								_Locate				(const TSG_Point &p)	const;
+	void							_Insert				(int p);
+
+};
+
+//---------------------------------------------------------
+/**
+* Sorts the points along a Hilbert curve, so that consecutively
+* inserted points are close to each other.
+*/
+//---------------------------------------------------------
+bool CSG_TIN_Delaunay::_Get_Order(std::vector<int> &Order)
+{
+	double xMin = m_Points[0].x, xMax = xMin, yMin = m_Points[0].y, yMax = yMin;
+
+	for(int i=1; i<m_nPoints; i++)
+	{
+		if( xMin > m_Points[i].x ) { xMin = m_Points[i].x; } else if( xMax < m_Points[i].x ) { xMax = m_Points[i].x; }
+		if( yMin > m_Points[i].y ) { yMin = m_Points[i].y; } else if( yMax < m_Points[i].y ) { yMax = m_Points[i].y; }
 	}
 
-	int status = 0, emax = 200, trimax = 4 * nPoints;
+	const unsigned int Size = 1 << 16; double dx = (Size - 1) / (xMax > xMin ? xMax - xMin : 1.), dy = (Size - 1) / (yMax > yMin ? yMax - yMin : 1.);
 
-	//-----------------------------------------------------	
-	int *complete = (int *)SG_Malloc(trimax * sizeof(int)); // Allocate memory for the completeness list, flag for each triangle
+	std::vector<uLong> Keys(m_nPoints);
 
-	if( complete == NULL )
+	#pragma omp parallel for
+	for(int i=0; i<m_nPoints; i++)
+	{
+		unsigned int x = (unsigned int)((m_Points[i].x - xMin) * dx), y = (unsigned int)((m_Points[i].y - yMin) * dy); uLong d = 0;
+
+		for(unsigned int s=Size/2; s>0; s/=2)
+		{
+			unsigned int rx = (x & s) > 0, ry = (y & s) > 0; d += (uLong)s * s * ((3 * rx) ^ ry);
+
+			if( ry == 0 )
+			{
+				if( rx == 1 ) { x = Size - 1 - x; y = Size - 1 - y; }
+
+				unsigned int t = x; x = y; y = t;
+			}
+		}
+
+		Keys[i] = (d << 32) | (uLong)i;
+	}
+
+	std::sort(Keys.begin(), Keys.end());
+
+	Order.resize(m_nPoints);
+
+	for(int i=0; i<m_nPoints; i++)
+	{
+		Order[i] = (int)(Keys[i] & 0xFFFFFFFF);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_TIN_Delaunay::Triangulate(void)
+{
+	if( m_nPoints < 3 )
 	{
 		return( false );
 	}
 
+	std::vector<int> Order; _Get_Order(Order);
+
 	//-----------------------------------------------------
-	TTIN_Edge *edges = (TTIN_Edge *)SG_Malloc(emax * sizeof(TTIN_Edge)); // Allocate memory for the edge list
+	int i = 2; while( i < m_nPoints && SG_TIN_Orient(m_Points[Order[0]], m_Points[Order[1]], m_Points[Order[i]]) == 0 ) { i++; }
 
-	if( edges == NULL )
+	if( i >= m_nPoints ) // all points are collinear
 	{
-		SG_Free(complete); return( false );
+		return( false );
 	}
 
-	//-----------------------------------------------------
-	//	Find the maximum and minimum vertex bounds.
-	//	This is to allow calculation of the bounding triangle
-	//	Set up the supertriangle
-	//	This is a triangle which encompasses all the sample points.
-	//	The supertriangle coordinates are added to the end of the
-	//	vertex list. The supertriangle is the first triangle in
-	//	the triangle list.
+	std::swap(Order[2], Order[i]);
+
+	int a = Order[0], b = Order[1], c = Order[2];
 
-	double dmax = m_Extent.Get_XRange() > m_Extent.Get_YRange() ? m_Extent.Get_XRange() : m_Extent.Get_YRange();
+	if( SG_TIN_Orient(m_Points[a], m_Points[b], m_Points[c]) < 0 )
+	{
+		std::swap(a, b);
+	}
 
-	Points[nPoints + 0]->m_Point.x = m_Extent.Get_XCenter() - 20 * dmax;
-	Points[nPoints + 1]->m_Point.x = m_Extent.Get_XCenter();
-	Points[nPoints + 2]->m_Point.x = m_Extent.Get_XCenter() + 20 * dmax;
+	m_Triangles.reserve(2 * (size_t)m_nPoints + 8);
 
-	Points[nPoints + 0]->m_Point.y = m_Extent.Get_YCenter() -      dmax;
-	Points[nPoints + 1]->m_Point.y = m_Extent.Get_YCenter() + 20 * dmax;
-	Points[nPoints + 2]->m_Point.y = m_Extent.Get_YCenter() -      dmax;
+	int t = _Add_Triangle(a, b, c);	// the first triangle and the three ghosts outside of its edges
+	int A = _Add_Triangle(c, b, TIN_INFINITE);
+	int B = _Add_Triangle(a, c, TIN_INFINITE);
+	int C = _Add_Triangle(b, a, TIN_INFINITE);
 
-	Triangles[0].p1 = nPoints;
-	Triangles[0].p2 = nPoints + 1;
-	Triangles[0].p3 = nPoints + 2;
+	TTriangle *T = &m_Triangles[0];
 
-	complete [0]    = false;
+	T[t].N[0] = A; T[t].N[1] = B; T[t].N[2] = C;
+	T[A].N[0] = C; T[A].N[1] = B; T[A].N[2] = t;
+	T[B].N[0] = A; T[B].N[1] = C; T[B].N[2] = t;
+	T[C].N[0] = B; T[C].N[1] = A; T[C].N[2] = t;
 
-	nTriangles      = 1;
+	m_Last = t;
 
 	//-----------------------------------------------------
-	//	Include each point one at a time into the existing mesh
-	for(int i=0; i<nPoints && SG_UI_Process_Set_Progress(i, nPoints); i++)
+	for(i=3; i<m_nPoints; i++)
+	{
+		if( i % 0x10000 == 0 && !SG_UI_Process_Set_Progress((double)i, (double)m_nPoints) )
+		{
+			return( false );
+		}
+
+		_Insert(Order[i]);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_TIN_Delaunay::_Add_Triangle(int a, int b, int c)
+{
+	TTriangle T; T.V[0] = a; T.V[1] = b; T.V[2] = c; T.N[0] = T.N[1] = T.N[2] = -1;
+
+	if( m_Free.size() > 0 )
 	{
-		double xp = Points[i]->Get_X();
-		double yp = Points[i]->Get_Y();
+		int t = m_Free.back(); m_Free.pop_back(); m_Triangles[t] = T;
+
+		return( t );
+	}
+
+	m_Triangles.push_back(T); m_Mark.push_back(0);
+
+	return( (int)m_Triangles.size() - 1 );
+}
 
-		int nedge = 0;
+//---------------------------------------------------------
+/**
+* A finite triangle is in conflict with point p if p lies inside
+* its circumcircle. A ghost triangle is in conflict if p lies on
+* the outer side of its hull edge or on the edge itself.
+*/
+//---------------------------------------------------------
+inline bool CSG_TIN_Delaunay::_is_Conflict(int t, const TSG_Point &p)	const
+{
+	const TTriangle &T = m_Triangles[t];
 
-		//-------------------------------------------------
-		//	Set up the edge buffer.
-		//	If the point (xp,yp) lies inside the circumcircle then the
-		//	three edges of that triangle are added to the edge buffer
-		//	and that triangle is removed.
-		for(int j=0; j<nTriangles; j++)
+	for(int k=0; k<3; k++)
+	{
+		if( T.V[k] == TIN_INFINITE )
 		{
-			if( complete[j] )
+			const TSG_Point &a = m_Points[T.V[(k + 1) % 3]], &b = m_Points[T.V[(k + 2) % 3]];
+
+			int o = SG_TIN_Orient(a, b, p);
+
+			if( o != 0 )
 			{
-				continue;
+				return( o > 0 );
 			}
 
-			double x1 = Points[Triangles[j].p1]->Get_X();
-			double y1 = Points[Triangles[j].p1]->Get_Y();
-			double x2 = Points[Triangles[j].p2]->Get_X();
-			double y2 = Points[Triangles[j].p2]->Get_Y();
-			double x3 = Points[Triangles[j].p3]->Get_X();
-			double y3 = Points[Triangles[j].p3]->Get_Y();
+			return( (p.x - a.x) * (b.x - a.x) + (p.y - a.y) * (b.y - a.y) > 0.
+				&&  (p.x - b.x) * (a.x - b.x) + (p.y - b.y) * (a.y - b.y) > 0. );
+		}
+	}
+
+	return( SG_TIN_InCircle(m_Points[T.V[0]], m_Points[T.V[1]], m_Points[T.V[2]], p) > 0 );
+}
 
-			double xc, yc, r; int inside = _CircumCircle(xp, yp, x1, y1, x2, y2, x3, y3, &xc, &yc, &r);
+//---------------------------------------------------------
+/**
+* Visibility walk from the last created triangle towards p.
+* Returns the finite triangle containing p or, if p is outside
+* of the convex hull, the ghost triangle behind the hull edge
+* that has been crossed.
+*/
+//---------------------------------------------------------
+int CSG_TIN_Delaunay::_Locate(const TSG_Point &p)	const
+{
+	int t = m_Last, from = -1;
 
-			if( xc + r < xp )
-			{
-				complete[j] = true;
-			}
+	for(int k=0; k<3 && is_Ghost(t); k++)
+	{
+		if( m_Triangles[t].V[k] == TIN_INFINITE ) { t = m_Triangles[t].N[k]; }
+	}
 
-			if( inside )
+	for(bool bMoved=true; bMoved; )
+	{
+		const TTriangle &T = m_Triangles[t]; bMoved = false;
+
+		for(int k=0; k<3 && !bMoved; k++)
+		{
+			if( T.N[k] != from && SG_TIN_Orient(m_Points[T.V[(k + 1) % 3]], m_Points[T.V[(k + 2) % 3]], p) < 0 )
 			{
-				if( nedge + 3 >= emax ) // Check that we haven't exceeded the edge list size
+				from = t; t = T.N[k]; bMoved = true;
+
+				if( is_Ghost(t) )
 				{
-					emax += 100; TTIN_Edge *_edges = (TTIN_Edge *)SG_Realloc(edges, emax * sizeof(TTIN_Edge));
+					return( t );
+				}
+			}
+		}
+	}
+
+	return( t );
+}
 
-					if( _edges == NULL )
-					{
-						SG_Free(edges); SG_Free(complete); return( false );
-					}
+//---------------------------------------------------------
+void CSG_TIN_Delaunay::_Insert(int iPoint)
+{
+	const TSG_Point &p = m_Points[iPoint];
 
-					edges = _edges;
-				}
+	int Stamp = ++m_Stamp, t = _Locate(p);
 
-				edges[nedge + 0].p1 = Triangles[j].p1;
-				edges[nedge + 0].p2 = Triangles[j].p2;
-				edges[nedge + 1].p1 = Triangles[j].p2;
-				edges[nedge + 1].p2 = Triangles[j].p3;
-				edges[nedge + 2].p1 = Triangles[j].p3;
-				edges[nedge + 2].p2 = Triangles[j].p1;
+	//-----------------------------------------------------
+	// collect the cavity, i.e. all triangles in conflict with p,
+	// and its boundary edges (triangle and opposite vertex)
 
-				nedge += 3;
+	m_Cavity.clear(); m_Boundary.clear(); m_Stack.clear();
 
-				Triangles[j] = Triangles[nTriangles - 1];
-				complete [j] = complete [nTriangles - 1];
+	m_Mark[t] = Stamp; m_Stack.push_back(t);
 
-				nTriangles--; j--;
-			}
-		}
+	while( m_Stack.size() > 0 )
+	{
+		t = m_Stack.back(); m_Stack.pop_back(); m_Cavity.push_back(t);
 
-		//-------------------------------------------------
-		//	Tag multiple edges
-		//	Note: if all triangles are specified anticlockwise then all
-		//	      interior edges are opposite pointing in direction.
-		for(int j=0; j<nedge-1; j++)
+		for(int k=0; k<3; k++)
 		{
-			for(int k=j+1; k<nedge; k++)
+			int n = m_Triangles[t].N[k];
+
+			if( m_Mark[n] != Stamp )
 			{
-				if( (edges[j].p1 == edges[k].p2) && (edges[j].p2 == edges[k].p1) )
+				if( m_Mark[n] != -Stamp && _is_Conflict(n, p) )
 				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
+					m_Mark[n] = Stamp; m_Stack.push_back(n);
 				}
-
-				// Shouldn't need the following, see note above
-				if( (edges[j].p1 == edges[k].p1) && (edges[j].p2 == edges[k].p2) )
+				else
 				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
+					m_Mark[n] = -Stamp; m_Boundary.push_back(3 * t + k);
 				}
 			}
 		}
+	}
 
-		//-------------------------------------------------
-		//	Form new triangles for the current point
-		//	Skipping over any tagged edges.
-		//	All edges are arranged in clockwise order.
-		for(int j=0; j<nedge; j++)
-		{
-			if( edges[j].p1 < 0 || edges[j].p2 < 0 )
-			{
-				continue;
-			}
+	//-----------------------------------------------------
+	// connect each boundary edge with p
 
-			if( nTriangles >= trimax )
-			{
-				SG_Free(edges); SG_Free(complete); return( false );
-			}
+	m_Links.clear();
+
+	for(size_t i=0; i<m_Boundary.size(); i++)
+	{
+		int c = m_Boundary[i] / 3, k = m_Boundary[i] % 3, n = m_Triangles[c].N[k];
+
+		TTriangle T = m_Triangles[c]; T.V[k] = iPoint;
+
+		int New = _Add_Triangle(T.V[0], T.V[1], T.V[2]);
+
+		TTriangle &N = m_Triangles[n], &NT = m_Triangles[New];
+
+		NT.N[k] = n; for(int j=0; j<3; j++) { if( N.N[j] == c ) { N.N[j] = New; break; } }
 
-			Triangles[nTriangles].p1 = edges[j].p1;
-			Triangles[nTriangles].p2 = edges[j].p2;
-			Triangles[nTriangles].p3 = i;
-			complete [nTriangles]    = false;
-			nTriangles++;
+		TLink Link; Link.Triangle = New; Link.Vertex = k; m_Links.push_back(Link);
+
+		if( !is_Ghost(New) )
+		{
+			m_Last = New;
 		}
 	}
 
 	//-----------------------------------------------------
-	//	Remove triangles with supertriangle vertices
-	//	These are triangles which have a vertex number greater than nPoints
-	for(int i=0; i<nTriangles; i++)
+	// link the new triangles among each other: the edge from p to
+	// vertex k+1 of one triangle is the edge from vertex k+2 to p
+	// of another one
+
+	for(size_t i=0; i<m_Links.size(); i++)
 	{
-		if(	Triangles[i].p1 >= nPoints
-		||	Triangles[i].p2 >= nPoints
-		||	Triangles[i].p3 >= nPoints )
+		TTriangle &A = m_Triangles[m_Links[i].Triangle]; int ka = m_Links[i].Vertex;
+
+		for(size_t j=0; j<m_Links.size(); j++)
 		{
-			Triangles[i] = Triangles[nTriangles - 1];
-			nTriangles--;
-			i--;
+			TTriangle &B = m_Triangles[m_Links[j].Triangle]; int kb = m_Links[j].Vertex;
+
+			if( i != j && A.V[(ka + 1) % 3] == B.V[(kb + 2) % 3] )
+			{
+				A.N[(ka + 2) % 3] = m_Links[j].Triangle;
+				B.N[(kb + 1) % 3] = m_Links[i].Triangle;
+
+				break;
+			}
 		}
 	}
 
 	//-----------------------------------------------------
-	return( true );
+	for(size_t i=0; i<m_Cavity.size(); i++)
+	{
+		m_Triangles[m_Cavity[i]].V[0] = TIN_DELETED; m_Free.push_back(m_Cavity[i]);
+	}
 }
 
 
 ///////////////////////////////////////////////////////////
 //														 //
+//														 //
+//														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-//	Return true if a point (xp,yp) is inside the circumcircle made up
-//	of the points (x1,y1), (x2,y2), (x3,y3)
-//	The circumcircle centre is returned in (xc,yc) and the radius r
-//	NOTE: A point on the edge is inside the circumcircle
-//
-
-//---------------------------------------------------------
-#define IS_IDENTICAL(a, b)	(a == b) // #define IS_IDENTICAL(a, b)	(fabs(a - b) < 0.0001)
-
-//---------------------------------------------------------
-int CSG_TIN::_CircumCircle(double xp, double yp, double x1, double y1, double x2, double y2, double x3, double y3, double *xc, double *yc, double *r)
+bool CSG_TIN::_Triangulate(void)
 {
-	double	m1, m2, mx1, mx2, my1, my2,
-			dx, dy, rsqr, drsqr;
+	_Destroy_Edges(); _Destroy_Triangles();
+
+	//-----------------------------------------------------
+	CSG_TIN_Node **Nodes = (CSG_TIN_Node **)SG_Malloc(Get_Node_Count() * sizeof(CSG_TIN_Node *));
 
-	// Check for coincident points
-	if( IS_IDENTICAL(y1, y2) && IS_IDENTICAL(y2, y3) )
+	for(sLong i=0; i<Get_Node_Count(); i++)
 	{
-		return( false );
+		Nodes[i] = Get_Node(i); Nodes[i]->_Del_Relations();
 	}
 
 	//-----------------------------------------------------
-	if( IS_IDENTICAL(y2, y1) )
+	qsort(Nodes, Get_Node_Count(), sizeof(CSG_TIN_Node *), SG_TIN_Compare);
+
+	for(sLong i=0, j=0, n=Get_Node_Count(); j<n; i++) // remove duplicates
 	{
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx2	=  (x2 + x3) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
-		*xc	=  (x2 + x1) / 2.0;
+		Nodes[i] = Nodes[j++];
 
-		*yc	= m2 * (*xc - mx2) + my2;
+		while( j < n
+			&& Nodes[i]->Get_X() == Nodes[j]->Get_X()
+			&& Nodes[i]->Get_Y() == Nodes[j]->Get_Y() )
+		{
+			Del_Node(Nodes[j++]->Get_Index(), false);
+		}
 	}
-	else if( IS_IDENTICAL(y3, y2) )
+
+	//-----------------------------------------------------
+	bool bResult = Get_Node_Count() >= 3;
+
+	if( bResult ) // Update extent...
 	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		mx1	=  (x1 + x2) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		*xc	=  (x3 + x2) / 2.0;
+		m_Extent.Assign(Nodes[0]->Get_Point(), Nodes[0]->Get_Point());
 
-		*yc	= m1 * (*xc - mx1) + my1;
+		for(sLong i=1; i<Get_Node_Count(); i++)
+		{
+			m_Extent.Union(Nodes[i]->Get_Point());
+		}
 	}
-	else
+
+	//-----------------------------------------------------
+	if( bResult )
 	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx1	=  (x1 + x2) / 2.0;
-		mx2	=  (x2 + x3) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
-
-		*xc	= (m1 * mx1 - m2 * mx2 + my2 - my1) / (m1 - m2);
-		*yc	= m1 * (*xc - mx1) + my1;
+		int nPoints = (int)Get_Node_Count(); std::vector<TSG_Point> Points(nPoints);
+
+		for(int i=0; i<nPoints; i++)
+		{
+			Points[i] = Nodes[i]->Get_Point();
+		}
+
+		CSG_TIN_Delaunay Delaunay(Points.data(), nPoints);
+
+		if( (bResult = Delaunay.Triangulate()) == true )
+		{
+			for(int i=0, a, b, c; i<Delaunay.Get_Count() && SG_UI_Process_Set_Progress(i, Delaunay.Get_Count()); i++)
+			{
+				if( Delaunay.Get_Triangle(i, a, b, c) )
+				{
+					_Add_Triangle(Nodes[a], Nodes[b], Nodes[c]);
+				}
+			}
+		}
 	}
 
 	//-----------------------------------------------------
-	dx		= x2 - *xc;
-	dy		= y2 - *yc;
-	rsqr	= dx*dx + dy*dy;
-	*r		= sqrt(rsqr);
+	SG_Free(Nodes);
 
-	dx		= xp - *xc;
-	dy		= yp - *yc;
-	drsqr	= dx*dx + dy*dy;
+	SG_UI_Process_Set_Ready();
 
-	return( drsqr <= rsqr ? 1 : 0 );
+	return( bResult );
 }
 
 
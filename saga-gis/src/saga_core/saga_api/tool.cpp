@@ -269,6 +269,8 @@ bool CSG_Tool::Execute(bool bAddHistory)
 
 	m_bError_Ignore	= false;
 
+	CSG_Profiler_Region Profile("tool", Get_Library() + ":" + Get_ID(), Get_Name());
+
 	bool bResult    = false;
 
 	m_Execution_Info.Clear();
@@ -87,6 +87,9 @@ void		Print_Version	(void);
 void		Create_Batch	(const CSG_String &File);
 void		Create_Docs		(const CSG_String &Directory);
 
+//---------------------------------------------------------
+CSG_String	g_Profile_File;	// profiling is enabled with a non-empty target file
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -192,12 +195,17 @@ bool		Run(int argc, char *argv[])
 	}
 
 	//-----------------------------------------------------
-	if( argc == 2 && SG_File_Exists(CSG_String(argv[1])) )
+	bool bResult = argc == 2 && SG_File_Exists(CSG_String(argv[1]))
+		? Execute_Script(argv[1])
+		: Execute(argc, argv);
+
+	//-----------------------------------------------------
+	if( !g_Profile_File.is_Empty() && !SG_Profiler_Save(g_Profile_File) )
 	{
-		return( Execute_Script(argv[1]) );
+		CMD_Print_Error(CSG_String::Format("%s: %s", _TL("failed to save profile"), g_Profile_File.c_str()));
 	}
 
-	return( Execute(argc, argv) );
+	return( bResult );
 }
 
 
@@ -549,6 +557,19 @@ bool		Check_Flags		(const CSG_String &Argument)
 		return( true );
 	}
 
+	//-----------------------------------------------------
+	else if( !s.Cmp("-m") || !s.Cmp("--memory") )
+	{
+		double	Budget;
+
+		if( CSG_String(Argument).AfterFirst('=').asDouble(Budget) )
+		{
+			SG_Grid_Cache_Set_Budget_MB(Budget);
+		}
+
+		return( true );
+	}
+
 	//-----------------------------------------------------
 	else if( !s.Cmp("-s") || !s.Cmp("--story") )
 	{
@@ -570,6 +591,21 @@ bool		Check_Flags		(const CSG_String &Argument)
 		return( true );
 	}
 
+	//-----------------------------------------------------
+	else if( !s.Cmp("-p") || !s.Cmp("--profile") )
+	{
+		g_Profile_File = CSG_String(Argument).AfterFirst('=');
+
+		if( g_Profile_File.is_Empty() )
+		{
+			g_Profile_File = "saga_cmd_profile.json";
+		}
+
+		SG_Profiler_Set_Enabled(true);
+
+		return( true );
+	}
+
 	//-----------------------------------------------------
 	else if( !s.Cmp("-u") || !s.Cmp("--utf8") )
 	{
@@ -741,14 +777,14 @@ void		Print_Help		(void)
 		"saga_cmd [-h, --help][<LIBRARY> <TOOL>]\n"
 		"saga_cmd [-v, --version]\n"
 #ifdef _OPENMP
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-m, --memory][=#][-p, --profile][=#][-f, --flags][=#]\n"
 		"  <LIBRARY> <TOOL> <OPTIONS>\n"
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-m, --memory][=#][-p, --profile][=#][-f, --flags][=#]\n"
 		"  <SCRIPT>\n"
 #else
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-m, --memory][=#][-p, --profile][=#][-f, --flags][=#]\n"
 		"  <LIBRARY> <TOOL> <OPTIONS>\n"
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-m, --memory][=#][-p, --profile][=#][-f, --flags][=#]\n"
 		"  <SCRIPT>\n"
 #endif
 		"\n"
@@ -764,6 +800,9 @@ void		Print_Help		(void)
 #ifdef _OPENMP
 		"[-c], [--cores]  : number of physical processors to use for computation\n"
 #endif
+		"[-m], [--memory] : memory budget [MB] for file cached grids (default is 0 = no limit)\n"
+		"[-p], [--profile]: write execution, load and save times to a Chrome trace JSON file\n"
+		"                   (default is 'saga_cmd_profile.json')\n"
 		"[-f], [--flags]  : various flags for general usage [qrsilx]\n"
 		"  q              : no progress report\n"
 		"  r              : no messages report\n"
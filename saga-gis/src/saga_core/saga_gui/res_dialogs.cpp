@@ -201,6 +201,7 @@ bool DLG_Get_FILE_Filter_GDAL_Read(int Type, wxString &Filter)
 	{
 		ADD_FILTER("sg-grd"  );
 		ADD_FILTER("sg-grd-z");
+		ADD_FILTER("sg-grd-t");
 		ADD_FILTER("sg-gds"  );
 		ADD_FILTER("sg-gds-z");
 		ADD_FILTER("sgrd"    );
@@ -251,7 +252,7 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 			"%s|%s|"
 			"%s (*.dll, *.so, *.xml)|*.dll;*.so;*.xml;*.dylib|"
 			"%s (*.sg-project, *.sprj)|*.sg-project;*.sprj|"
-			"%s (*.sgrd, *.sg-grd-z)|*.sgrd;*.sg-grd;*.sg-grd-z;*.dgm;*.grd|"
+			"%s (*.sgrd, *.sg-grd-z, *.sg-grd-t)|*.sgrd;*.sg-grd;*.sg-grd-z;*.sg-grd-t;*.dgm;*.grd|"
 			"%s (*.sg-gds, *.sg-gds-z)|*.sg-gds;*.sg-gds-z|"
 			"%s (*.shp)|*.shp|"
 			"%s (*.spc, *.sg-pts, *.sg-pts-z)|*.spc;*.sg-pts;*.sg-pts-z|"
@@ -304,7 +305,7 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 
 		return( wxString::Format(
 			"%s|%s|"
-			"%s (*.sgrd, *.sg-grd-z))|*.sg-grd;*.sg-grd-z;*.sgrd;*.dgm;*.grd|"
+			"%s (*.sgrd, *.sg-grd-z, *.sg-grd-t))|*.sg-grd;*.sg-grd-z;*.sg-grd-t;*.sgrd;*.dgm;*.grd|"
 			"%s|*.*",
 			_TL("Recognized Files"), Recognized.c_str(),
 			_TL("SAGA Grid Files"),
@@ -320,11 +321,13 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.sg-grd)|*.sg-grd|"
 				"%s (*.sgrd)|*.sgrd|"
 				"%s (*.tif)|*.tif;*.tiff|"
+				"%s (*.sg-grd-t)|*.sg-grd-t|"
 				"%s|*.*",
 				_TL("SAGA Compressed Grid Files"),
 				_TL("SAGA Grid Files"),
 				_TL("SAGA Grid Files (old extension)"),
 				_TL("GeoTIFF"),
+				_TL("SAGA Tiled Grid Files"),
 				_TL("All Files")
 			));
 
@@ -334,11 +337,13 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.sg-grd-z)|*.sg-grd-z|"
 				"%s (*.sgrd)|*.sgrd|"
 				"%s (*.tif)|*.tif;*.tiff|"
+				"%s (*.sg-grd-t)|*.sg-grd-t|"
 				"%s|*.*",
 				_TL("SAGA Grid Files"),
 				_TL("SAGA Compressed Grid Files"),
 				_TL("SAGA Grid Files (old extension)"),
 				_TL("GeoTIFF"),
+				_TL("SAGA Tiled Grid Files"),
 				_TL("All Files")
 			));
 
@@ -348,11 +353,13 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.sg-grd-z)|*.sg-grd-z|"
 				"%s (*.sg-grd)|*.sg-grd|"
 				"%s (*.tif)|*.tif;*.tiff|"
+				"%s (*.sg-grd-t)|*.sg-grd-t|"
 				"%s|*.*",
 				_TL("SAGA Grid Files (old extension)"),
 				_TL("SAGA Compressed Grid Files"),
 				_TL("SAGA Grid Files"),
 				_TL("GeoTIFF"),
+				_TL("SAGA Tiled Grid Files"),
 				_TL("All Files")
 			));
 
@@ -362,11 +369,29 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.sgrd)|*.sgrd|"
 				"%s (*.sg-grd-z)|*.sg-grd-z|"
 				"%s (*.sg-grd)|*.sg-grd|"
+				"%s (*.sg-grd-t)|*.sg-grd-t|"
 				"%s|*.*",
 				_TL("GeoTIFF"),
 				_TL("SAGA Grid Files (old extension)"),
 				_TL("SAGA Compressed Grid Files"),
 				_TL("SAGA Grid Files"),
+				_TL("SAGA Tiled Grid Files"),
+				_TL("All Files")
+			));
+
+		case GRID_FILE_FORMAT_Tiled:	// SAGA Tiled Grid File (*.sg-grd-t)
+			return( wxString::Format(
+				"%s (*.sg-grd-t)|*.sg-grd-t|"
+				"%s (*.sg-grd-z)|*.sg-grd-z|"
+				"%s (*.sg-grd)|*.sg-grd|"
+				"%s (*.sgrd)|*.sgrd|"
+				"%s (*.tif)|*.tif;*.tiff|"
+				"%s|*.*",
+				_TL("SAGA Tiled Grid Files"),
+				_TL("SAGA Compressed Grid Files"),
+				_TL("SAGA Grid Files"),
+				_TL("SAGA Grid Files (old extension)"),
+				_TL("GeoTIFF"),
 				_TL("All Files")
 			));
 		}
@@ -242,10 +242,11 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 	m_Parameters.Add_Choice("NODE_GRID",
 		"GRID_FMT_DEFAULT"		, _TL("Default Output Format"),
 		_TL(""),
-		CSG_String::Format("%s (*.sg-grd-z)|%s (*.sg-grd)|%s (*.tif)",
+		CSG_String::Format("%s (*.sg-grd-z)|%s (*.sg-grd)|%s (*.tif)|%s (*.sg-grd-t)",
 			_TL("SAGA Compressed Grid Files"),
 			_TL("SAGA Grid Files"),
-			_TL("GeoTIFF")
+			_TL("GeoTIFF"),
+			_TL("SAGA Tiled Grid Files")
 		), 0
 	);
 
@@ -334,6 +335,7 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 	default: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Compressed); break;
 	case  1: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Binary    ); break;
 	case  2: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_GeoTIFF   ); break;
+	case  3: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Tiled     ); break;
 	}
 
 	switch( m_Parameters("SHAPES_FMT_DEFAULT")->asInt() )
@@ -728,6 +730,7 @@ void CWKSP_Data_Manager::Parameters_Changed(void)
 	default: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Compressed); break;
 	case  1: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Binary    ); break;
 	case  2: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_GeoTIFF   ); break;
+	case  3: SG_Grid_Set_File_Format_Default(GRID_FILE_FORMAT_Tiled     ); break;
 	}
 
 	switch( m_Parameters("SHAPES_FMT_DEFAULT")->asInt() )
@@ -888,6 +891,7 @@ bool CWKSP_Data_Manager::Open(const wxString &File)
 	}
 
 	if(	SG_File_Cmp_Extension(&File, "sg-grd-z")
+	||	SG_File_Cmp_Extension(&File, "sg-grd-t")
 	||	SG_File_Cmp_Extension(&File, "sg-grd"  )
 	||	SG_File_Cmp_Extension(&File, "sgrd"    )
 	||  SG_File_Cmp_Extension(&File, "dgm"     )
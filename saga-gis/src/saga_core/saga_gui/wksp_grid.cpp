@@ -48,12 +48,15 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <wx/app.h>
 #include <wx/dc.h>
 #include <wx/dcmemory.h>
 #include <wx/image.h>
 #include <wx/filename.h>
 #include <wx/clipbrd.h>
 
+#include <chrono>
+
 #include <saga_gdi/sgdi_helper.h>
 
 #include "res_commands.h"
@@ -83,10 +86,19 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+static int	g_nGrid_Layers	= 0;	// number of grid layers sharing the tile cache budget
+
 //---------------------------------------------------------
 CWKSP_Grid::CWKSP_Grid(CSG_Grid *pGrid)
 	: CWKSP_Layer(pGrid)
 {
+	g_nGrid_Layers++;
+
+	m_Tiles_Used = 0;
+
+	m_Overview_ID = 0; m_Overview_Level = 0; m_Overview_Row = -1;
+
 	m_Edit_Attributes.Add_Field("ROW", SG_DATATYPE_Int);
 
 	On_Create_Parameters();
@@ -94,6 +106,14 @@ CWKSP_Grid::CWKSP_Grid(CSG_Grid *pGrid)
 	DataObject_Changed();
 }
 
+//---------------------------------------------------------
+CWKSP_Grid::~CWKSP_Grid(void)
+{
+	_Draw_Cache_Reset(true);
+
+	g_nGrid_Layers--;
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -525,12 +545,16 @@ void CWKSP_Grid::On_DataObject_Changed(void)
 	}
 
 	//-----------------------------------------------------
+	_Draw_Cache_Reset(true);
+
 	CWKSP_Layer::On_DataObject_Changed();
 }
 
 //---------------------------------------------------------
 void CWKSP_Grid::On_Parameters_Changed(void)
 {
+	_Draw_Cache_Reset(false);
+
 	CWKSP_Layer::On_Parameters_Changed();
 
 	//-----------------------------------------------------
@@ -1057,6 +1081,8 @@ bool CWKSP_Grid::Edit_Set_Attributes(void)
 			}
 		}
 
+		_Draw_Cache_Reset(true);
+
 		Update_Views();
 
 		return( true );
@@ -1102,6 +1128,8 @@ bool CWKSP_Grid::_Edit_Del_Selection(void)
 			}
 		}
 
+		_Draw_Cache_Reset(true);
+
 		g_pActive->Update_Attributes();
 
 		Update_Views();
@@ -1407,9 +1435,392 @@ void CWKSP_Grid::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 	}
 }
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define TILE_SIZE	256	// edge length of a cached tile in screen pixels
+#define TILE_COUNT	256	// number of cached tiles kept beyond the visible ones, shared by all grid layers
+#define TILE_COUNT_MIN	4	// ...but at least this number per layer
+
+//---------------------------------------------------------
+// A rendered block of TILE_SIZE x TILE_SIZE screen pixels.
+// Tiles are aligned to multiples of the pixel size in world
+// coordinates, so that panning at a constant zoom re-uses
+// them instead of resampling the grid again.
+//---------------------------------------------------------
+class CWKSP_Grid_Tile
+{
+public:
+	CWKSP_Grid_Tile(double Size, TSG_Grid_Resampling Resampling, sLong ix, sLong iy)
+		: m_Size(Size), m_Resampling(Resampling), m_ix(ix), m_iy(iy), m_Used(0)
+	{
+		m_Color.Create(TILE_SIZE * TILE_SIZE);
+		m_bColor.Create(sizeof(BYTE), TILE_SIZE * TILE_SIZE);
+	}
+
+	bool						is_Equal		(double Size, TSG_Grid_Resampling Resampling, sLong ix, sLong iy)	const
+	{
+		return( m_ix == ix && m_iy == iy && m_Size == Size && m_Resampling == Resampling );
+	}
+
+	double						m_Size;
+
+	TSG_Grid_Resampling			m_Resampling;
+
+	sLong						m_ix, m_iy, m_Used;
+
+	CSG_Array_Int				m_Color;
+
+	CSG_Array					m_bColor;
+
+};
+
+//---------------------------------------------------------
+void CWKSP_Grid::_Draw_Cache_Reset(bool bOverview)
+{
+	for(sLong i=0; i<m_Tiles.Get_Size(); i++)
+	{
+		delete((CWKSP_Grid_Tile *)m_Tiles[i]);
+	}
+
+	m_Tiles.Destroy();
+
+	if( bOverview )
+	{
+		for(sLong i=0; i<m_Overview.Get_Size(); i++)
+		{
+			delete((CSG_Grid *)m_Overview[i]);
+		}
+
+		m_Overview.Destroy();
+
+		m_Overview_ID = 0; m_Overview_Level = 0; m_Overview_Row = -1;	// a pending build step will find its id outdated
+	}
+}
+
+//---------------------------------------------------------
+CSG_Grid * CWKSP_Grid::_Get_Overview(double Cellsize)
+{
+	if( Cellsize < 2. * Get_Grid()->Get_Cellsize()	// mean values would falsify look-up table classes and rgb colours
+	||  m_pClassify->Get_Mode() == CLASSIFY_LUT
+	||  m_pClassify->Get_Mode() == CLASSIFY_RGB )
+	{
+		return( Get_Grid() );
+	}
+
+	if( m_Overview.Get_Size() < 1 )	// built once on demand in the background, see _Set_Overview()
+	{
+		static int ID = 0; m_Overview_ID = ++ID;
+
+		m_Overview_System = Get_Grid()->Get_System();
+
+		CSG_Grid *pLevel = SG_Create_Grid(SG_DATATYPE_Float,
+			(int)(1.5 + Get_Grid()->Get_XRange() / (2. * Get_Grid()->Get_Cellsize())),
+			(int)(1.5 + Get_Grid()->Get_YRange() / (2. * Get_Grid()->Get_Cellsize())),
+			2. * Get_Grid()->Get_Cellsize(), Get_Grid()->Get_XMin(), Get_Grid()->Get_YMin()
+		);
+
+		pLevel->Set_NoData_Value(Get_Grid()->Get_NoData_Value());
+
+		m_Overview += pLevel; m_Overview_Level = 0; m_Overview_Row = 0;
+
+		_Queue_Overview(m_Overview_ID);
+	}
+
+	CSG_Grid *pGrid = Get_Grid();	// the full resolution is drawn until the overview levels are ready
+
+	for(int i=0; m_Overview_Row < 0 && i<m_Overview.Get_Size() && ((CSG_Grid *)m_Overview[i])->Get_Cellsize() <= Cellsize; i++)
+	{
+		pGrid = (CSG_Grid *)m_Overview[i];
+	}
+
+	return( pGrid );
+}
+
+//---------------------------------------------------------
+// Builds the overview levels in small steps from the main
+// loop, so that a large grid does not block the user
+// interface. Each step aggregates the rows of the current
+// level for a limited time and then queues the next step.
+// Each level is the area weighted mean of its predecessor.
+// When all levels are ready, the views are updated.
+//---------------------------------------------------------
+void CWKSP_Grid::_Set_Overview(int ID)
+{
+	if( ID != m_Overview_ID || m_Overview_Row < 0 )	// outdated or finished
+	{
+		return;
+	}
+
+	if( !(Get_Grid()->Get_System() == m_Overview_System) )	// the grid has been changed in the meantime
+	{
+		_Draw_Cache_Reset(true);
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	CSG_Grid *pLevel  = (CSG_Grid *)m_Overview[m_Overview_Level];
+	CSG_Grid *pSource = m_Overview_Level > 0 ? (CSG_Grid *)m_Overview[m_Overview_Level - 1] : Get_Grid();
+
+	std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+
+	while( m_Overview_Row < pLevel->Get_NY() && std::chrono::steady_clock::now() - Start < std::chrono::milliseconds(40) )
+	{
+		int yLast = M_GET_MIN(m_Overview_Row + 16, pLevel->Get_NY());
+
+		#pragma omp parallel for if( !pSource->is_Cached() )
+		for(int y=m_Overview_Row; y<yLast; y++)
+		{
+			for(int x=0; x<pLevel->Get_NX(); x++)
+			{
+				double Sum = 0., Weights = 0.;	// a level cell covers its central source cell and half of each neighbour
+
+				for(int iy=2*y-1; iy<=2*y+1; iy++)
+				{
+					for(int ix=2*x-1; ix<=2*x+1; ix++)
+					{
+						if( pSource->is_InGrid(ix, iy) )
+						{
+							double w = (ix == 2*x ? 1. : 0.5) * (iy == 2*y ? 1. : 0.5);
+
+							Sum += w * pSource->asDouble(ix, iy); Weights += w;
+						}
+					}
+				}
+
+				if( Weights > 0. )
+				{
+					pLevel->Set_Value(x, y, Sum / Weights);
+				}
+				else
+				{
+					pLevel->Set_NoData(x, y);
+				}
+			}
+		}
+
+		m_Overview_Row = yLast;
+	}
+
+	//-----------------------------------------------------
+	if( m_Overview_Row >= pLevel->Get_NY() )	// level is ready, start the next one
+	{
+		double Cellsize = 2. * pLevel->Get_Cellsize();
+
+		int nx = (int)(1.5 + Get_Grid()->Get_XRange() / Cellsize);
+		int ny = (int)(1.5 + Get_Grid()->Get_YRange() / Cellsize);
+
+		if( nx > 1 || ny > 1 )
+		{
+			CSG_Grid *pNext = SG_Create_Grid(SG_DATATYPE_Float, nx, ny, Cellsize, Get_Grid()->Get_XMin(), Get_Grid()->Get_YMin());
+
+			pNext->Set_NoData_Value(Get_Grid()->Get_NoData_Value());
+
+			m_Overview += pNext; m_Overview_Level++; m_Overview_Row = 0;
+		}
+		else	// all levels are ready, tiles drawn from full resolution are replaced
+		{
+			m_Overview_Row = -1;
+
+			_Draw_Cache_Reset(false);
+
+			Update_Views(false);
+
+			return;
+		}
+	}
+
+	_Queue_Overview(ID);
+}
+
+//---------------------------------------------------------
+void CWKSP_Grid::_Queue_Overview(int ID)
+{
+	CSG_Grid *pGrid = Get_Grid();	// the layer might have been closed when the step is due, so look it up again
+
+	wxTheApp->CallAfter([pGrid, ID]()
+	{
+		CWKSP_Grid *pItem = g_pData ? (CWKSP_Grid *)g_pData->Get(pGrid) : NULL;
+
+		if( pItem )
+		{
+			pItem->_Set_Overview(ID);
+		}
+	});
+}
+
+//---------------------------------------------------------
+CWKSP_Grid_Tile * CWKSP_Grid::_Get_Tile(double Size, TSG_Grid_Resampling Resampling, sLong ix, sLong iy, bool &bCreated)
+{
+	CWKSP_Grid_Tile *pTile = NULL;
+
+	for(sLong i=0; !pTile && i<m_Tiles.Get_Size(); i++)
+	{
+		if( ((CWKSP_Grid_Tile *)m_Tiles[i])->is_Equal(Size, Resampling, ix, iy) )
+		{
+			pTile = (CWKSP_Grid_Tile *)m_Tiles[i];
+		}
+	}
+
+	if( (bCreated = pTile == NULL) == true )
+	{
+		m_Tiles.Add(pTile = new CWKSP_Grid_Tile(Size, Resampling, ix, iy));
+	}
+
+	pTile->m_Used = m_Tiles_Used;
+
+	return( pTile );
+}
+
+//---------------------------------------------------------
+void CWKSP_Grid::_Set_Tile(CWKSP_Grid_Tile *pTile, CSG_Grid *pGrid)
+{
+	int *Colors = pTile->m_Color.Get_Array(); BYTE *bColors = (BYTE *)pTile->m_bColor.Get_Array();
+
+	memset(bColors, 0, TILE_SIZE * TILE_SIZE);
+
+	double Size = pTile->m_Size, xMin = Size * pTile->m_ix * TILE_SIZE, yMin = Size * pTile->m_iy * TILE_SIZE;
+
+	CSG_Rect rTile(xMin, yMin, xMin + Size * (TILE_SIZE - 1), yMin + Size * (TILE_SIZE - 1));
+
+	if( rTile.Intersects(pGrid->Get_Extent(true)) == INTERSECTION_None )
+	{
+		return;
+	}
+
+	bool bRGB = m_pClassify->Get_Mode() == CLASSIFY_RGB;
+
+	#pragma omp parallel for if( !pGrid->is_Cached() )
+	for(int y=0; y<TILE_SIZE; y++)
+	{
+		double yWorld = yMin + Size * y;
+
+		for(int x=0, i=y*TILE_SIZE; x<TILE_SIZE; x++, i++)
+		{
+			double xWorld = xMin + Size * x, Value; int Color;
+
+			if( pGrid->Get_Value(xWorld, yWorld, Value, pTile->m_Resampling, false, bRGB)
+			&&  m_pClassify->Get_Class_Color_byValue(Value, Color) )
+			{
+				Colors[i] = _Get_Shading(pGrid, xWorld, yWorld, Color, pTile->m_Resampling); bColors[i] = 1;
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+bool CWKSP_Grid::_Draw_Grid_Tiles(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resampling)
+{
+	if( m_pAlpha || m_pClassify->Get_Mode() == CLASSIFY_OVERLAY	// depend on other grids, which might change unnoticed
+	|| (m_pClassify->Get_Mode() == CLASSIFY_RGB && m_Parameters("RGB_ALPHA")->asBool()) )
+	{
+		return( false );
+	}
+
+	CSG_Rect rMap(dc_Map.rWorld());	rMap.Intersect(Get_Grid()->Get_Extent(true));
+
+	int axDC = (int)dc_Map.xWorld2DC(rMap.Get_XMin()); if( axDC <  0                        ) { axDC = 0;                            }
+	int bxDC = (int)dc_Map.xWorld2DC(rMap.Get_XMax()); if( bxDC >= dc_Map.rDC().GetWidth () ) { bxDC = dc_Map.rDC().GetWidth () - 1; }
+	int ayDC = (int)dc_Map.yWorld2DC(rMap.Get_YMin()); if( ayDC >= dc_Map.rDC().GetHeight() ) { ayDC = dc_Map.rDC().GetHeight() - 1; }
+	int byDC = (int)dc_Map.yWorld2DC(rMap.Get_YMax()); if( byDC <  0                        ) { byDC = 0;                            }
+
+	if( axDC > bxDC || byDC > ayDC )
+	{
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// world aligned pixel indices of the lower left visible pixel
+
+	double Size = dc_Map.DC2World();
+
+	sLong ax = (sLong)floor(dc_Map.xDC2World(axDC) / Size + 0.5), bx = ax + (bxDC - axDC);
+	sLong ay = (sLong)floor(dc_Map.yDC2World(ayDC) / Size + 0.5), by = ay + (ayDC - byDC);
+
+	sLong atx = (sLong)floor(ax / (double)TILE_SIZE), btx = (sLong)floor(bx / (double)TILE_SIZE), ntx = 1 + btx - atx;
+	sLong aty = (sLong)floor(ay / (double)TILE_SIZE), bty = (sLong)floor(by / (double)TILE_SIZE), nty = 1 + bty - aty;
+
+	//-----------------------------------------------------
+	CSG_Grid *pGrid = _Get_Overview(Size);
+
+	CSG_Array_Pointer Tiles(ntx * nty);
+
+	m_Tiles_Used++;
+
+	for(sLong ty=0, i=0; ty<nty; ty++)
+	{
+		for(sLong tx=0; tx<ntx; tx++, i++)
+		{
+			bool bCreated; CWKSP_Grid_Tile *pTile = _Get_Tile(Size, Resampling, atx + tx, aty + ty, bCreated);
+
+			if( bCreated )
+			{
+				_Set_Tile(pTile, pGrid);
+			}
+
+			Tiles[i] = pTile;
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int yDC=byDC; yDC<=ayDC; yDC++)
+	{
+		sLong py = ay + (ayDC - yDC), ty = (sLong)floor(py / (double)TILE_SIZE), y = py - ty * TILE_SIZE;
+
+		for(int xDC=axDC; xDC<=bxDC; )
+		{
+			sLong px = ax + (xDC - axDC), tx = (sLong)floor(px / (double)TILE_SIZE), x = px - tx * TILE_SIZE;
+
+			CWKSP_Grid_Tile *pTile = (CWKSP_Grid_Tile *)Tiles[(ty - aty) * ntx + (tx - atx)];
+
+			int *Colors = pTile->m_Color.Get_Array() + y * TILE_SIZE; BYTE *bColors = (BYTE *)pTile->m_bColor.Get_Array() + y * TILE_SIZE;
+
+			for( ; x<TILE_SIZE && xDC<=bxDC; x++, xDC++)
+			{
+				if( bColors[x] )
+				{
+					dc_Map.Draw_Image_Pixel(xDC, yDC, Colors[x]);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	// drop the least recently used tiles
+
+	sLong nSpare = M_GET_MAX(TILE_COUNT_MIN, TILE_COUNT / M_GET_MAX(1, g_nGrid_Layers));
+
+	while( m_Tiles.Get_Size() > nSpare + ntx * nty )
+	{
+		sLong iOldest = 0;
+
+		for(sLong i=1; i<m_Tiles.Get_Size(); i++)
+		{
+			if( ((CWKSP_Grid_Tile *)m_Tiles[i])->m_Used < ((CWKSP_Grid_Tile *)m_Tiles[iOldest])->m_Used )
+			{
+				iOldest = i;
+			}
+		}
+
+		delete((CWKSP_Grid_Tile *)m_Tiles[iOldest]);
+
+		m_Tiles.Del(iOldest);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 void CWKSP_Grid::_Draw_Grid_Nodes(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resampling)
 {
+	if( _Draw_Grid_Tiles(dc_Map, Resampling) )
+	{
+		return;
+	}
+
 	CSG_Grid *pOverlay[2]; CSG_Scaler Scaler[2];
 
 	_Get_Overlay(pOverlay, Scaler);
@@ -1525,7 +1936,7 @@ void CWKSP_Grid::_Draw_Grid_Nodes(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resamp
 
 				if( m_pClassify->Get_Class_Color_byValue(Value, Color) )
 				{
-					dc_Map.Draw_Image_Pixel(xDC, yDC, _Get_Shading(xMap, yMap, Color, Resampling));
+					dc_Map.Draw_Image_Pixel(xDC, yDC, _Get_Shading(Get_Grid(), xMap, yMap, Color, Resampling));
 				}
 			}
 			else
@@ -1541,7 +1952,7 @@ void CWKSP_Grid::_Draw_Grid_Nodes(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resamp
 				Value = pOverlay[1] && pOverlay[1]->Get_Value(xMap, yMap, Value, Resampling) ? Scaler[1].to_Relative(Value) : 1.;
 				Color[Overlay[2]] = Value <= 0. ? 0 : Value >= 1. ? 255 : (BYTE)(255. * Value);
 
-				dc_Map.Draw_Image_Pixel(xDC, yDC, _Get_Shading(xMap, yMap, *(int *)Color, Resampling));
+				dc_Map.Draw_Image_Pixel(xDC, yDC, _Get_Shading(Get_Grid(), xMap, yMap, *(int *)Color, Resampling));
 			}
 		}
 	}
@@ -1633,13 +2044,13 @@ inline int CWKSP_Grid::_Get_Shading(int x, int y, int Color)
 }
 
 //---------------------------------------------------------
-inline int CWKSP_Grid::_Get_Shading(double x, double y, int Color, TSG_Grid_Resampling Resampling)
+inline int CWKSP_Grid::_Get_Shading(CSG_Grid *pGrid, double x, double y, int Color, TSG_Grid_Resampling Resampling)
 {
 	if( m_Shade_Mode )
 	{
 		double s, a;
 
-		if( Get_Grid()->Get_Gradient(x, y, s, a, Resampling) )
+		if( pGrid->Get_Gradient(x, y, s, a, Resampling) )
 		{
 			s = M_PI_090 - atan(m_Shade_Parms[0] * tan(s));
 
@@ -68,11 +68,15 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+class CWKSP_Grid_Tile;
+
 //---------------------------------------------------------
 class CWKSP_Grid : public CWKSP_Layer
 {
 public:
 	CWKSP_Grid(CSG_Grid *pGrid);
+	virtual ~CWKSP_Grid(void);
 
 	virtual TWKSP_Item			Get_Type				(void)	{	return( WKSP_ITEM_Grid );	}
 
@@ -127,6 +131,16 @@ private:
 
 	CSG_Grid					*m_pAlpha;
 
+	sLong						m_Tiles_Used;
+
+	CSG_Array_Pointer			m_Tiles;
+
+	int							m_Overview_ID, m_Overview_Level, m_Overview_Row;
+
+	CSG_Grid_System				m_Overview_System;
+
+	CSG_Array_Pointer			m_Overview;
+
 
 	void						_LUT_Create				(void);
 
@@ -138,12 +152,20 @@ private:
 
 	void						_Get_Overlay			(CSG_Grid *pOverlay[2], CSG_Scaler Scaler[2]);
 
+	void						_Draw_Cache_Reset		(bool bOverview);
+	CSG_Grid *					_Get_Overview			(double Cellsize);
+	void						_Set_Overview			(int ID);
+	void						_Queue_Overview			(int ID);
+	CWKSP_Grid_Tile *			_Get_Tile				(double Size, TSG_Grid_Resampling Resampling, sLong ix, sLong iy, bool &bCreated);
+	void						_Set_Tile				(CWKSP_Grid_Tile *pTile, CSG_Grid *pGrid);
+	bool						_Draw_Grid_Tiles		(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resampling);
+
 	void						_Draw_Grid_Nodes		(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resampling);
 	void						_Draw_Grid_Nodes		(CSG_Map_DC &dc_Map, TSG_Grid_Resampling Resampling, int yDC, int axDC, int bxDC, CSG_Grid *pOverlay[2], CSG_Scaler Scaler[2]);
 	void						_Draw_Grid_Cells		(CSG_Map_DC &dc_Map);
 
 	void						_Set_Shading			(double Shade, int &Color);
-	int							_Get_Shading			(double x, double y, int Color, TSG_Grid_Resampling Resampling);
+	int							_Get_Shading			(CSG_Grid *pGrid, double x, double y, int Color, TSG_Grid_Resampling Resampling);
 	int							_Get_Shading			(int    x, int    y, int Color);
 
 	void						_Draw_Values			(CSG_Map_DC &dc_Map);
@@ -27,6 +27,8 @@
 //---------------------------------------------------------
 #include "Cost_Isotropic.h"
 
+#include "cost_engine.h"
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -43,8 +45,27 @@ CCost_Accumulated::CCost_Accumulated(void)
 
 	Set_Description	(_TW(
 		"Calculation of accumulated cost, either isotropic or anisotropic, if direction of maximum cost is specified. "
+		"Costs are propagated with Dijkstra's algorithm using a monotone radix heap, so that each cell is settled once. "
+		"Alternatively the parallel delta-stepping variant returns the same result using all available processors, "
+		"while the isotropic fast marching method solves the eikonal equation and thus avoids the direction bias "
+		"of the eight neighbour graph. "
 	));
 
+	Add_Reference("Dijkstra, E.W.", "1959",
+		"A note on two problems in connexion with graphs",
+		"Numerische Mathematik, 1, 269-271."
+	);
+
+	Add_Reference("Meyer, U., Sanders, P.", "2003",
+		"Delta-stepping: a parallelizable shortest path algorithm",
+		"Journal of Algorithms, 49(1), 114-152."
+	);
+
+	Add_Reference("Sethian, J.A.", "1996",
+		"A fast marching level set method for monotonically advancing fronts",
+		"Proceedings of the National Academy of Sciences, 93(4), 1591-1595."
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("",
 		"DEST_TYPE"		, _TL("Destinations"),
@@ -126,6 +147,16 @@ CCost_Accumulated::CCost_Accumulated(void)
 		_TL(""),
 		0., 0., true
 	);
+
+	Parameters.Add_Choice("",
+		"METHOD"		, _TL("Method"),
+		_TL("Fast marching ignores the direction of maximum cost."),
+		CSG_String::Format("%s|%s|%s",
+			_TL("Dijkstra"),
+			_TL("fast marching (isotropic)"),
+			_TL("delta-stepping (parallel)")
+		), 0
+	);
 }
 
 
@@ -188,7 +219,10 @@ bool CCost_Accumulated::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	Get_Cost(Destinations);
+	if( !Get_Cost(Destinations) )
+	{
+		return( false );
+	}
 
 	Get_Allocation();
 
@@ -244,105 +278,21 @@ bool CCost_Accumulated::Get_Destinations(CSG_Points_Int &Destinations)
 //														 //
 ///////////////////////////////////////////////////////////
 
-//---------------------------------------------------------
-inline double CCost_Accumulated::Get_Cost(int x, int y)
-{
-	double	Cost	= m_pCost->asDouble(x, y);
-
-	return( Cost < m_Cost_Min ? m_Cost_Min : Cost );
-}
-
 //---------------------------------------------------------
 bool CCost_Accumulated::Get_Cost(CSG_Points_Int &Destinations)
 {
-	CSG_Points_Int Next_Point; CSG_Grid Next_Index(Get_System(), SG_DATATYPE_Int);
-
-	CSG_Grid *pDirection = Parameters("DIR_MAXCOST")->asGrid();
-	double     Dir_Unit  = Parameters("DIR_UNIT"   )->asInt() == 0 ? 1. : M_DEG_TO_RAD;
-	double     Dir_K     = Parameters("DIR_K"      )->asDouble();
+	CCost_Engine	Engine;
 
-	double	Threshold	= Parameters("THRESHOLD")->asDouble();
+	Engine.Set_Cost(m_pCost, m_Cost_Min);
 
-	sLong	nProcessed	= Destinations.Get_Count();
-
-	//-----------------------------------------------------
-	while( Destinations.Get_Count() > 0 && Set_Progress_Cells(nProcessed) )
-	{
-		Process_Set_Text("%s: %d", _TL("cells in process"), Destinations.Get_Count());
-
-		Next_Point.Clear();
-
-		for(int iPoint=0; iPoint<Destinations.Get_Count(); iPoint++)
-		{
-			TSG_Point_Int	p	= Destinations[iPoint];
-
-			double	Cost	= Get_Cost(p.x, p.y);
-			double	Accu	= m_pAccumulated->asDouble(p.x, p.y);
-
-			for(int i=0; i<8; i++)
-			{
-				int	ix	= Get_xTo(i, p.x);
-				int	iy	= Get_yTo(i, p.y);
-
-				if( m_pCost->is_InGrid(ix, iy) )
-				{
-					double	dCost	= Get_UnitLength(i);
-
-					if( pDirection )
-					{
-						static const double	Angle[8] = { 0., M_PI_045, M_PI_090, M_PI_135, M_PI_180, M_PI_225, M_PI_270, M_PI_315 };
-
-						double	d1	= pDirection->is_InGrid(p.x, p.y) ? pow(cos(fabs(Dir_Unit * pDirection->asDouble(p.x, p.y) - Angle[i])), Dir_K) : -1.;
-						double	d2	= pDirection->is_InGrid( ix,  iy) ? pow(cos(fabs(Dir_Unit * pDirection->asDouble( ix,  iy) - Angle[i])), Dir_K) : -1.;
-
-						if( d1 >= 0. && d2 >= 0. )
-						{
-							dCost	*= (d1 + d2) / 2.;
-						}
-						else if( d1 >= 0. )
-						{
-							dCost	*= d1;
-						}
-						else if( d2 >= 0. )
-						{
-							dCost	*= d2;
-						}
-					}
-
-					double	iAccu	= Accu + dCost * (Cost + Get_Cost(ix, iy)) / 2.;
-
-					//-------------------------------------
-					if( m_pAccumulated->asDouble(ix, iy) < 0.
-					||  m_pAccumulated->asDouble(ix, iy) > iAccu + Threshold )
-					{
-						if( m_pAccumulated->asDouble(ix, iy) < 0. )
-						{
-							nProcessed++;
-						}
-
-						Next_Index     .Set_Value(ix, iy, Next_Point.Get_Count());	// remember last point (least cost!) added at position ix/iy
-						Next_Point     .Add      (ix, iy);
-						m_pAccumulated->Set_Value(ix, iy, iAccu);
-					}
-				}
-			}
-		}
-
-		//-------------------------------------------------
-		Destinations.Clear();
-
-		for(int Index=0; Index<Next_Point.Get_Count(); Index++)
-		{
-			TSG_Point_Int	p	= Next_Point[Index];
+	Engine.Set_Anisotropy(Parameters("DIR_MAXCOST")->asGrid(),
+		Parameters("DIR_UNIT")->asInt() == 0 ? 1. : M_DEG_TO_RAD,
+		Parameters("DIR_K"   )->asDouble()
+	);
 
-			if( Next_Index.asInt(p.x, p.y) == Index )
-			{
-				Destinations.Add(p.x, p.y);
-			}
-		}
-	}
+	Engine.Set_Threshold(Parameters("THRESHOLD")->asDouble());
 
-	return( true );
+	return( Engine.Execute(Destinations, m_pAccumulated, Parameters("METHOD")->asInt()) );
 }
 
 
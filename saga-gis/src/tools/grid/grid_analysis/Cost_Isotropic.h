@@ -71,7 +71,6 @@ private:
 
 	bool					Get_Destinations		(CSG_Points_Int &Destinations);
 
-	double					Get_Cost				(int x, int y);
 	bool					Get_Cost				(CSG_Points_Int &Destinations);
 
 	int						Get_Allocation			(int x, int y);
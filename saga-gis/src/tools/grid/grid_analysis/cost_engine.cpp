@@ -0,0 +1,659 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     Grid_Analysis                     //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    cost_engine.cpp                    //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+#include "cost_engine.h"
+
+#include <atomic>
+#include <map>
+#include <vector>
+#include <float.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Monotone radix heap (Ahuja et al. 1990). Non-negative doubles
+// keep their order when compared as unsigned 64 bit integers,
+// which are distributed to 65 buckets by the highest bit in
+// which they differ from the last extracted key. Each entry is
+// moved at most 64 times, push and pop are amortized O(1).
+//---------------------------------------------------------
+class CCost_Heap
+{
+public:
+	CCost_Heap(void) : m_Last(0), m_Size(0)	{}
+
+	bool					is_Empty			(void)	const	{	return( m_Size == 0 );	}
+
+	//-----------------------------------------------------
+	void					Push				(double Cost, sLong Cell)
+	{
+		TEntry	Entry;	Entry.Cell	= Cell;	Entry.Key	= _Get_Key(Cost);
+
+		if( Entry.Key < m_Last )	// rounding, keys must not fall below the last extracted one
+		{
+			Entry.Key	= m_Last;
+		}
+
+		m_Bucket[_Get_Bucket(Entry.Key)].push_back(Entry); m_Size++;
+	}
+
+	//-----------------------------------------------------
+	double					Pop					(sLong &Cell)
+	{
+		if( m_Bucket[0].empty() )
+		{
+			int	i	= 1;	while( m_Bucket[i].empty() )	{	i++;	}
+
+			uint64_t	Min	= m_Bucket[i][0].Key;
+
+			for(size_t j=1; j<m_Bucket[i].size(); j++)
+			{
+				if( Min > m_Bucket[i][j].Key )
+				{
+					Min	= m_Bucket[i][j].Key;
+				}
+			}
+
+			m_Last	= Min;
+
+			for(size_t j=0; j<m_Bucket[i].size(); j++)
+			{
+				m_Bucket[_Get_Bucket(m_Bucket[i][j].Key)].push_back(m_Bucket[i][j]);
+			}
+
+			m_Bucket[i].clear();
+		}
+
+		TEntry	Entry	= m_Bucket[0].back();	m_Bucket[0].pop_back(); m_Size--;
+
+		Cell	= Entry.Cell;
+
+		double	Cost;	memcpy(&Cost, &Entry.Key, sizeof(Cost));
+
+		return( Cost );
+	}
+
+
+private:
+
+	typedef struct
+	{
+		uint64_t			Key;
+
+		sLong				Cell;
+	}
+	TEntry;
+
+	uint64_t				m_Last;
+
+	sLong					m_Size;
+
+	std::vector<TEntry>		m_Bucket[65];
+
+
+	static uint64_t			_Get_Key			(double Cost)
+	{
+		uint64_t	Key	= 0;	if( Cost > 0. )	{	memcpy(&Key, &Cost, sizeof(Key));	}
+
+		return( Key );
+	}
+
+	int						_Get_Bucket			(uint64_t Key)	const
+	{
+		uint64_t	d	= Key ^ m_Last;
+
+	#if defined(__GNUC__) || defined(__clang__)
+		return( d ? 64 - __builtin_clzll(d) : 0 );
+	#else
+		int	n	= 0;	while( d )	{	d >>= 1; n++;	}
+
+		return( n );
+	#endif
+	}
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CCost_Engine::CCost_Engine(void)
+{
+	m_pCost			= NULL;
+	m_pDirection	= NULL;
+
+	m_Cost_Min		= 0.;
+	m_Threshold		= 0.;
+	m_Delta			= 0.;
+	m_Dir_Unit		= 1.;
+	m_Dir_K			= 2.;
+}
+
+//---------------------------------------------------------
+CCost_Engine::~CCost_Engine(void)
+{}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCost_Engine::Set_Cost(CSG_Grid *pCost, double Cost_Min)
+{
+	m_pCost		= pCost && pCost->is_Valid() ? pCost : NULL;
+	m_Cost_Min	= Cost_Min;
+
+	return( m_pCost != NULL );
+}
+
+//---------------------------------------------------------
+bool CCost_Engine::Set_Anisotropy(CSG_Grid *pDirection, double Unit, double K)
+{
+	m_pDirection	= pDirection && pDirection->is_Valid() ? pDirection : NULL;
+	m_Dir_Unit		= Unit;
+	m_Dir_K			= K;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+double CCost_Engine::Get_Cost(int x, int y)	const
+{
+	double	Cost	= m_pCost->asDouble(x, y);
+
+	if( Cost < m_Cost_Min )
+	{
+		Cost	= m_Cost_Min;
+	}
+
+	return( Cost > 0. ? Cost : 0. );
+}
+
+//---------------------------------------------------------
+/**
+  * Cost of the step from cell (x, y) to its neighbour in direction i,
+  * i.e. the mean local cost of both cells times the step length in
+  * cells, weighted with the direction of maximum cost, if supplied.
+*/
+double CCost_Engine::Get_Edge_Cost(int x, int y, int i)	const
+{
+	int	ix	= CSG_Grid_System::Get_xTo(i, x);
+	int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+	double	dCost	= CSG_Grid_System::Get_UnitLength(i);
+
+	if( m_pDirection )
+	{
+		static const double	Angle[8] = { 0., M_PI_045, M_PI_090, M_PI_135, M_PI_180, M_PI_225, M_PI_270, M_PI_315 };
+
+		double	d1	= m_pDirection->is_InGrid(x , y ) ? pow(cos(fabs(m_Dir_Unit * m_pDirection->asDouble(x , y ) - Angle[i])), m_Dir_K) : -1.;
+		double	d2	= m_pDirection->is_InGrid(ix, iy) ? pow(cos(fabs(m_Dir_Unit * m_pDirection->asDouble(ix, iy) - Angle[i])), m_Dir_K) : -1.;
+
+		if( d1 >= 0. && d2 >= 0. )
+		{
+			dCost	*= (d1 + d2) / 2.;
+		}
+		else if( d1 >= 0. )
+		{
+			dCost	*= d1;
+		}
+		else if( d2 >= 0. )
+		{
+			dCost	*= d2;
+		}
+	}
+
+	return( dCost * (Get_Cost(x, y) + Get_Cost(ix, iy)) / 2. );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCost_Engine::Execute(const CSG_Points_Int &Sources, CSG_Grid *pAccumulated, int Method)
+{
+	if( !m_pCost || !pAccumulated || !pAccumulated->is_Compatible(m_pCost) )
+	{
+		return( false );
+	}
+
+	if( !m_Accumulated.Create(sizeof(double), m_pCost->Get_NCells()) )
+	{
+		return( false );
+	}
+
+	double	*Accumulated	= (double *)m_Accumulated.Get_Array();
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_pCost->Get_NCells(); i++)
+	{
+		Accumulated[i]	= -1.;
+	}
+
+	for(int i=0; i<Sources.Get_Count(); i++)
+	{
+		if( m_pCost->is_InGrid(Sources[i].x, Sources[i].y) )
+		{
+			Accumulated[(sLong)Sources[i].y * m_pCost->Get_NX() + Sources[i].x]	= 0.;
+		}
+	}
+
+	//-----------------------------------------------------
+	bool	bResult;
+
+	switch( Method )
+	{
+	default                       : bResult = _Dijkstra      (Sources); break;
+	case COST_ENGINE_FastMarching : bResult = _Fast_Marching (Sources); break;
+	case COST_ENGINE_DeltaStepping: bResult = _Delta_Stepping(Sources); break;
+	}
+
+	//-----------------------------------------------------
+	pAccumulated->Set_NoData_Value(-1.);
+
+	#pragma omp parallel for
+	for(int y=0; y<m_pCost->Get_NY(); y++)
+	{
+		for(int x=0; x<m_pCost->Get_NX(); x++)
+		{
+			pAccumulated->Set_Value(x, y, Accumulated[(sLong)y * m_pCost->Get_NX() + x]);
+		}
+	}
+
+	m_Accumulated.Destroy();
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCost_Engine::_Dijkstra(const CSG_Points_Int &Sources)
+{
+	const int	NX	= m_pCost->Get_NX();
+
+	double	*Accumulated	= (double *)m_Accumulated.Get_Array();
+
+	CSG_Array	Settled(sizeof(BYTE), m_pCost->Get_NCells());	BYTE *bSettled = (BYTE *)Settled.Get_Array();
+
+	memset(bSettled, 0, Settled.Get_uSize());
+
+	CCost_Heap	Heap;
+
+	for(int i=0; i<Sources.Get_Count(); i++)
+	{
+		if( m_pCost->is_InGrid(Sources[i].x, Sources[i].y) )
+		{
+			Heap.Push(0., (sLong)Sources[i].y * NX + Sources[i].x);
+		}
+	}
+
+	//-----------------------------------------------------
+	sLong	nSettled	= 0;
+
+	while( !Heap.is_Empty() )
+	{
+		sLong	Cell;	Heap.Pop(Cell);
+
+		if( bSettled[Cell] )	// outdated entry
+		{
+			continue;
+		}
+
+		bSettled[Cell]	= 1;
+
+		if( (++nSettled % 65536) == 0 && !SG_UI_Process_Set_Progress((double)nSettled, (double)m_pCost->Get_NCells()) )
+		{
+			return( false );
+		}
+
+		int	x	= (int)(Cell % NX);
+		int	y	= (int)(Cell / NX);
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( m_pCost->is_InGrid(ix, iy) )
+			{
+				sLong	iCell	= (sLong)iy * NX + ix;
+
+				if( !bSettled[iCell] )
+				{
+					double	iAccu	= Accumulated[Cell] + Get_Edge_Cost(x, y, i);
+
+					if( Accumulated[iCell] < 0. || Accumulated[iCell] > iAccu + m_Threshold )
+					{
+						Accumulated[iCell]	= iAccu;
+
+						Heap.Push(iAccu, iCell);
+					}
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * First order upwind solution of the eikonal equation |grad T| = F
+  * at cell (x, y), using the accepted values of its 4 neighbours.
+*/
+double CCost_Engine::_Get_Eikonal(int x, int y, const BYTE *bAccepted)	const
+{
+	const int	NX	= m_pCost->Get_NX();
+
+	const double	*Accumulated	= (const double *)m_Accumulated.Get_Array();
+
+	double	T[2]	= { -1., -1. };	// minimum of accepted neighbours in x and in y direction
+
+	for(int i=0; i<8; i+=2)
+	{
+		int	ix	= CSG_Grid_System::Get_xTo(i, x);
+		int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+		if( m_pCost->is_InGrid(ix, iy) && bAccepted[(sLong)iy * NX + ix] )
+		{
+			double	t	= Accumulated[(sLong)iy * NX + ix];	int	j	= (i / 2) % 2;
+
+			if( T[j] < 0. || T[j] > t )
+			{
+				T[j]	= t;
+			}
+		}
+	}
+
+	double	F	= Get_Cost(x, y);
+
+	if( T[0] < 0. )	{	return( T[1] + F );	}
+	if( T[1] < 0. )	{	return( T[0] + F );	}
+
+	double	d	= T[0] - T[1];
+
+	if( fabs(d) >= F )
+	{
+		return( (T[0] < T[1] ? T[0] : T[1]) + F );
+	}
+
+	return( (T[0] + T[1] + sqrt(2. * F*F - d*d)) / 2. );
+}
+
+//---------------------------------------------------------
+bool CCost_Engine::_Fast_Marching(const CSG_Points_Int &Sources)
+{
+	const int	NX	= m_pCost->Get_NX();
+
+	double	*Accumulated	= (double *)m_Accumulated.Get_Array();
+
+	CSG_Array	Accepted(sizeof(BYTE), m_pCost->Get_NCells());	BYTE *bAccepted = (BYTE *)Accepted.Get_Array();
+
+	memset(bAccepted, 0, Accepted.Get_uSize());
+
+	CCost_Heap	Heap;
+
+	for(int i=0; i<Sources.Get_Count(); i++)
+	{
+		if( m_pCost->is_InGrid(Sources[i].x, Sources[i].y) )
+		{
+			Heap.Push(0., (sLong)Sources[i].y * NX + Sources[i].x);
+		}
+	}
+
+	//-----------------------------------------------------
+	sLong	nAccepted	= 0;
+
+	while( !Heap.is_Empty() )
+	{
+		sLong	Cell;	Heap.Pop(Cell);
+
+		if( bAccepted[Cell] )	// outdated entry
+		{
+			continue;
+		}
+
+		bAccepted[Cell]	= 1;
+
+		if( (++nAccepted % 65536) == 0 && !SG_UI_Process_Set_Progress((double)nAccepted, (double)m_pCost->Get_NCells()) )
+		{
+			return( false );
+		}
+
+		int	x	= (int)(Cell % NX);
+		int	y	= (int)(Cell / NX);
+
+		for(int i=0; i<8; i+=2)
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( m_pCost->is_InGrid(ix, iy) )
+			{
+				sLong	iCell	= (sLong)iy * NX + ix;
+
+				if( !bAccepted[iCell] )
+				{
+					double	T	= _Get_Eikonal(ix, iy, bAccepted);
+
+					if( Accumulated[iCell] < 0. || Accumulated[iCell] > T + m_Threshold )
+					{
+						Accumulated[iCell]	= T;
+
+						Heap.Push(T, iCell);
+					}
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Delta-stepping (Meyer & Sanders 2003), simplified to a label
+  * correcting relaxation of whole buckets: all cells of the lowest
+  * non-empty bucket are relaxed in parallel, improved neighbours go
+  * to their bucket, those falling into the current one are relaxed
+  * again until it is empty. Accumulated costs are updated with an
+  * atomic compare-and-swap, so results equal Dijkstra's.
+*/
+bool CCost_Engine::_Delta_Stepping(const CSG_Points_Int &Sources)
+{
+	const int	NX	= m_pCost->Get_NX();
+
+	double	*Accumulated	= (double *)m_Accumulated.Get_Array();
+
+	double	Delta	= m_Delta;
+
+	if( Delta <= 0. )	// mean edge cost
+	{
+		Delta	= m_pCost->Get_Mean() > m_Cost_Min ? m_pCost->Get_Mean() : m_Cost_Min;
+
+		if( Delta <= 0. )
+		{
+			Delta	= 1.;
+		}
+	}
+
+	//-----------------------------------------------------
+	std::atomic<double>	*Distance	= new std::atomic<double>[m_pCost->Get_NCells()];
+
+	#pragma omp parallel for
+	for(sLong i=0; i<m_pCost->Get_NCells(); i++)
+	{
+		Distance[i]	= Accumulated[i] < 0. ? DBL_MAX : Accumulated[i];
+	}
+
+	std::map<sLong, std::vector<sLong> >	Buckets;
+
+	for(int i=0; i<Sources.Get_Count(); i++)
+	{
+		if( m_pCost->is_InGrid(Sources[i].x, Sources[i].y) )
+		{
+			Buckets[0].push_back((sLong)Sources[i].y * NX + Sources[i].x);
+		}
+	}
+
+	std::vector<std::vector<std::pair<sLong, sLong> > >	Pushed(SG_OMP_Get_Max_Num_Threads());
+
+	//-----------------------------------------------------
+	bool	bResult	= true;	sLong	nRelaxed	= 0;	// cells can be relaxed more than once, progress is capped at the cell count
+
+	while( !Buckets.empty() && bResult )
+	{
+		sLong	Bucket	= Buckets.begin()->first;
+
+		std::vector<sLong>	Frontier;	Frontier.swap(Buckets.begin()->second);	Buckets.erase(Buckets.begin());
+
+		while( !Frontier.empty() && (bResult = SG_UI_Process_Set_Progress((double)M_GET_MIN(nRelaxed, m_pCost->Get_NCells()), (double)m_pCost->Get_NCells())) == true )
+		{
+			nRelaxed	+= (sLong)Frontier.size();
+
+			#pragma omp parallel for schedule(dynamic, 256)
+			for(sLong k=0; k<(sLong)Frontier.size(); k++)
+			{
+				sLong	Cell	= Frontier[k];
+
+				int	x	= (int)(Cell % NX);
+				int	y	= (int)(Cell / NX);
+
+				double	Accu	= Distance[Cell].load();
+
+				std::vector<std::pair<sLong, sLong> >	&Push	= Pushed[SG_OMP_Get_Thread_Num()];
+
+				for(int i=0; i<8; i++)
+				{
+					int	ix	= CSG_Grid_System::Get_xTo(i, x);
+					int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+					if( m_pCost->is_InGrid(ix, iy) )
+					{
+						sLong	iCell	= (sLong)iy * NX + ix;
+
+						double	iAccu	= Accu + Get_Edge_Cost(x, y, i), Old = Distance[iCell].load();
+
+						while( iAccu + m_Threshold < Old )
+						{
+							if( Distance[iCell].compare_exchange_weak(Old, iAccu) )
+							{
+								Push.push_back(std::make_pair((sLong)(iAccu / Delta), iCell));
+
+								break;
+							}
+						}
+					}
+				}
+			}
+
+			//---------------------------------------------
+			Frontier.clear();
+
+			for(size_t i=0; i<Pushed.size(); i++)
+			{
+				for(size_t j=0; j<Pushed[i].size(); j++)
+				{
+					if( Pushed[i][j].first <= Bucket )
+					{
+						Frontier.push_back(Pushed[i][j].second);
+					}
+					else
+					{
+						Buckets[Pushed[i][j].first].push_back(Pushed[i][j].second);
+					}
+				}
+
+				Pushed[i].clear();
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(sLong i=0; i<m_pCost->Get_NCells(); i++)
+	{
+		double	d	= Distance[i].load();	Accumulated[i]	= d < DBL_MAX ? d : -1.;
+	}
+
+	delete[](Distance);
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
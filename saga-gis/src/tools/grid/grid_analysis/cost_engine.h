@@ -0,0 +1,127 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     Grid_Analysis                     //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     cost_engine.h                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__cost_engine_H
+#define HEADER_INCLUDED__cost_engine_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+enum
+{
+	COST_ENGINE_Dijkstra	= 0,	// exact, 8-neighbourhood, isotropic or anisotropic
+	COST_ENGINE_FastMarching,		// isotropic travel time, first order eikonal solution, 4-neighbourhood
+	COST_ENGINE_DeltaStepping		// same result as Dijkstra, parallel label correcting
+};
+
+//---------------------------------------------------------
+/**
+  * Accumulated cost engine. Cost accumulates from one or more
+  * source cells over a local cost (friction) surface. No-data cells
+  * of the cost grid are barriers, negative costs are treated as
+  * zero. Dijkstra and fast marching settle cells from a monotone
+  * radix heap, so each cell is finalized once. Delta-stepping
+  * relaxes all cells of a cost bucket of width Delta in parallel.
+*/
+//---------------------------------------------------------
+class CCost_Engine
+{
+public:
+	CCost_Engine(void);
+	virtual ~CCost_Engine(void);
+
+	bool					Set_Cost			(CSG_Grid *pCost, double Cost_Min = 0.);
+
+	/** Direction of maximum cost (Unit converts it to radians), effective friction = friction^f, with f = cos(angle difference)^K. */
+	bool					Set_Anisotropy		(CSG_Grid *pDirection, double Unit = 1., double K = 2.);
+
+	/** A cell is only updated, if its accumulated cost decreases by more than Threshold. */
+	void					Set_Threshold		(double Threshold)	{	m_Threshold	= Threshold > 0. ? Threshold : 0.;	}
+
+	/** Bucket width used by delta-stepping. Zero or less selects an average edge cost. */
+	void					Set_Delta			(double Delta)		{	m_Delta		= Delta;	}
+
+	/** Accumulates cost from the Sources cells. The contents of pAccumulated are overwritten, unreachable cells are set to no-data (-1). */
+	bool					Execute				(const CSG_Points_Int &Sources, CSG_Grid *pAccumulated, int Method = COST_ENGINE_Dijkstra);
+
+	double					Get_Cost			(int x, int y)			const;
+	double					Get_Edge_Cost		(int x, int y, int i)	const;
+
+
+private:
+
+	double					m_Cost_Min, m_Threshold, m_Delta, m_Dir_Unit, m_Dir_K;
+
+	CSG_Grid				*m_pCost, *m_pDirection;
+
+	CSG_Array				m_Accumulated;
+
+
+	bool					_Dijkstra			(const CSG_Points_Int &Sources);
+	bool					_Fast_Marching		(const CSG_Points_Int &Sources);
+	bool					_Delta_Stepping		(const CSG_Points_Int &Sources);
+
+	double					_Get_Eikonal		(int x, int y, const BYTE *bAccepted)	const;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__cost_engine_H
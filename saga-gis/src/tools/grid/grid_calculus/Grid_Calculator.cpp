@@ -468,20 +468,37 @@ bool CGrid_Calculator::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
+	// rows are evaluated in chunks of cells, the formula being
+	// applied to all cells of a chunk at once
+
+	const int nChunk = 1024;
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		for(int xChunk=0; xChunk<Get_NX(); xChunk+=nChunk)
 		{
-			double Result; CSG_Vector Values(m_nValues);
+			int nx = M_GET_MIN(nChunk, Get_NX() - xChunk);
+
+			CSG_Matrix Values(nx, m_nValues); CSG_Vector Result(nx); CSG_Array_Int bOkay(nx);
 
-			if( Get_Values(x, y, Values) && Get_Result(Values, Result) )
+			Get_Values(xChunk, y, nx, Values, bOkay);
+
+			if( !m_Formula.Get_Values((const double **)Values.Get_Data(), m_nValues, Result.Get_Data(), nx) )
 			{
-				pResult->Set_Value(x, y, Result);
+				bOkay.Assign(0);
 			}
-			else
+
+			for(int i=0, x=xChunk; i<nx; i++, x++)
 			{
-				pResult->Set_NoData(x, y);
+				if( bOkay[i] && _finite(Result[i]) )
+				{
+					pResult->Set_Value(x, y, Result[i]);
+				}
+				else
+				{
+					pResult->Set_NoData(x, y);
+				}
 			}
 		}
 	}
@@ -496,37 +513,49 @@ bool CGrid_Calculator::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_Calculator::Get_Values(int x, int y, CSG_Vector &Values)
+bool CGrid_Calculator::Get_Values(int xChunk, int y, int nx, CSG_Matrix &Values, CSG_Array_Int &bOkay)
 {
-	TSG_Point p = Get_System().Get_Grid_to_World(x, y);
+	int nGrids = m_pGrids->Get_Grid_Count(), nGrids_X = m_pGrids_X->Get_Grid_Count();
 
-	if( m_pGrids_X->Get_Grid_Count() > 0 )
+	for(int i=0, x=xChunk; i<nx; i++, x++)
 	{
-		for(int i=0, j=m_pGrids->Get_Grid_Count(); i<m_pGrids_X->Get_Grid_Count(); i++, j++)
+		bOkay[i] = 1;
+
+		for(int j=0; j<nGrids && bOkay[i]; j++)
 		{
-			if( !m_pGrids_X->Get_Grid(i)->Get_Value(p, Values[j], m_Resampling, m_bUseNoData) )
+			if( !m_bUseNoData && m_pGrids->Get_Grid(j)->is_NoData(x, y) )
 			{
-				return( false );
+				bOkay[i] = 0;
+			}
+			else
+			{
+				Values[j][i] = m_pGrids->Get_Grid(j)->asDouble(x, y);
 			}
 		}
-	}
 
-	for(int i=0; i<m_pGrids->Get_Grid_Count(); i++)
-	{
-		if( !m_bUseNoData && m_pGrids->Get_Grid(i)->is_NoData(x, y) )
+		if( bOkay[i] && (nGrids_X > 0 || m_bPosition[2] || m_bPosition[3]) )
 		{
-			return( false );
-		}
+			TSG_Point p = Get_System().Get_Grid_to_World(x, y);
 
-		Values[i] = m_pGrids->Get_Grid(i)->asDouble(x, y);
-	}
+			for(int j=0, k=nGrids; j<nGrids_X && bOkay[i]; j++, k++)
+			{
+				if( !m_pGrids_X->Get_Grid(j)->Get_Value(p, Values[k][i], m_Resampling, m_bUseNoData) )
+				{
+					bOkay[i] = 0;
+				}
+			}
 
-	int n = m_pGrids->Get_Grid_Count() + m_pGrids_X->Get_Grid_Count();
+			int k = nGrids + nGrids_X + (m_bPosition[0] ? 1 : 0) + (m_bPosition[1] ? 1 : 0);
 
-	if( m_bPosition[0] ) Values[n++] =   x; // col()
-	if( m_bPosition[1] ) Values[n++] =   y; // row()
-	if( m_bPosition[2] ) Values[n++] = p.x; // xpos()
-	if( m_bPosition[3] ) Values[n++] = p.y; // ypos()
+			if( m_bPosition[2] ) Values[k++][i] = p.x; // xpos()
+			if( m_bPosition[3] ) Values[k++][i] = p.y; // ypos()
+		}
+
+		int k = nGrids + nGrids_X;
+
+		if( m_bPosition[0] ) Values[k++][i] = x; // col()
+		if( m_bPosition[1] ) Values[k++][i] = y; // row()
+	}
 
 	return( true );
 }
@@ -120,7 +120,7 @@ private:
 	CSG_Parameter_Grid_List		*m_pGrids, *m_pGrids_X;
 
 
-	bool						Get_Values				(int x, int y, CSG_Vector &Values);
+	bool						Get_Values				(int xChunk, int y, int nx, CSG_Matrix &Values, CSG_Array_Int &bOkay);
 
 };
 
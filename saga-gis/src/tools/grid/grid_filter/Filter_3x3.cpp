@@ -180,36 +180,45 @@ bool CFilter_3x3::On_Execute(void)
 	//-----------------------------------------------------
 	bool bAbsolute = Parameters("ABSOLUTE")->asBool();
 
+	CSG_Grid_View<double> Input(pInput, Kernel.Get_NY()), Output(pResult);
+
+	CSG_Array_Pointer Rows(Kernel.Get_NY()); const double **pRows = (const double **)Rows.Get_Array();
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
+		for(int iy=0; iy<Kernel.Get_NY(); iy++)
+		{
+			pRows[iy] = Input.Get_Row(y - ny + iy);	// NULL if outside of grid
+		}
+
+		const double *pInput_y = Input.Get_Row(y); double *pOutput_y = Output.Get_Row(y, false);
+
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
 		{
 			CSG_Simple_Statistics s;
 
-			if( pInput->is_InGrid(x, y) )
+			if( !Input.is_NoData(pInput_y[x]) )
 			{
-				for(int iy=0, jy=y-ny; iy<Kernel.Get_NY(); iy++, jy++)
+				for(int iy=0; iy<Kernel.Get_NY(); iy++)
 				{
-					for(int ix=0, jx=x-nx; ix<Kernel.Get_NX(); ix++, jx++)
+					if( pRows[iy] )
 					{
-						if( pInput->is_InGrid(jx, jy) )
+						for(int ix=0, jx=x-nx; ix<Kernel.Get_NX(); ix++, jx++)
 						{
-							s.Add_Value(pInput->asDouble(jx, jy), Kernel[iy][ix]);
+							if( jx >= 0 && jx < Get_NX() && !Input.is_NoData(pRows[iy][jx]) )
+							{
+								s.Add_Value(pRows[iy][jx], Kernel[iy][ix]);
+							}
 						}
 					}
 				}
 			}
 
-			if( s.Get_Count() > 0 )
-			{
-				pResult->Set_Value(x, y, bAbsolute ? s.Get_Sum() : s.Get_Mean());
-			}
-			else
-			{
-				pResult->Set_NoData(x, y);
-			}
+			pOutput_y[x] = s.Get_Count() > 0 ? (bAbsolute ? s.Get_Sum() : s.Get_Mean()) : Output.Get_NoData_Value();
 		}
+
+		Output.Set_Row(y);
 	}
 
 	//-----------------------------------------------------
@@ -123,6 +123,44 @@ bool CGrid_Buffer::On_Execute(void)
 
 	int	Distance	= (int)(0.5 + Parameters("DISTANCE")->asDouble() / Get_Cellsize());
 
+	//-----------------------------------------------------
+	if( bFixed )	// exact distance transform, linear in the number of cells
+	{
+		CSG_Grid_Distance_Transform	Transform(Get_System());
+
+		for(int y=0; y<Get_NY(); y++)
+		{
+			for(int x=0; x<Get_NX(); x++)
+			{
+				if( !pFeatures->is_NoData(x, y) && pFeatures->asDouble(x, y) > 0.0 )
+				{
+					Transform.Set_Feature(x, y);
+				}
+			}
+		}
+
+		if( !Transform.Execute() )
+		{
+			return( false );
+		}
+
+		for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+		{
+			#pragma omp parallel for
+			for(int x=0; x<Get_NX(); x++)
+			{
+				double	d	= Transform.Get_Distance(x, y);
+
+				if( d >= 0. && d <= Distance )
+				{
+					pBuffer->Set_Value(x, y, Transform.is_Feature(x, y) ? FEATURE : BUFFER);
+				}
+			}
+		}
+
+		return( true );
+	}
+
 	//-----------------------------------------------------
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
@@ -78,7 +78,7 @@ CGrid_Proximity_Buffer::CGrid_Proximity_Buffer(void){
 		"reclassification of the distance grid using a user specified equidistance to create a set of discrete distance "
 		"buffers from source features. The buffer zones are coded with the maximum distance value of the corresponding buffer interval. " 
 		"The output value type for the distance grid is floating-point. The output values for the allocation and buffer "
-		"grid are of type integer. The duration of tool execution is dependent on the number of source cells and the buffer distance."));
+		"grid are of type integer. Distances are calculated with an exact euclidean distance transform, whose duration only depends on the number of grid cells."));
 
 	Parameters.Add_Grid(NULL, 
 						"SOURCE",
@@ -143,7 +143,7 @@ bool CGrid_Proximity_Buffer::On_Execute(void){
 	
 	CSG_Grid	*pSource, *pDistance, *pAlloc, *pBuffer;
 	double 		dBufDist, dDist, cellSize;
-	int 		x, y, i, j, imin, imax, jmin, jmax, iBufDist, alloc, ival;
+	int 		x, y, i, j, ival;
 
 	pSource 	= Parameters("SOURCE")->asGrid();
 	pDistance 	= Parameters("DISTANCE")->asGrid();
@@ -160,49 +160,36 @@ bool CGrid_Proximity_Buffer::On_Execute(void){
 	}
 
 	dBufDist = dBufDist / cellSize;
-	iBufDist = (int) (dBufDist + 2.0);
 	dBufDist = pow(dBufDist, 2);
 
 	pDistance->Assign_NoData();
 	pAlloc->Assign_NoData();
 	pBuffer->Assign_NoData();
 
-    for(y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
-	{		
-		for(x=0; x<Get_NX(); x++)
-		{			
- 			if( !pSource->is_NoData(x, y) )
-			{
-				alloc = pSource->asInt(x, y);
+	CSG_Grid_Distance_Transform	Transform(*pSource);	// exact nearest source cell for all cells
 
-				pAlloc->Set_Value(x, y, alloc);
-				pDistance->Set_Value(x, y, 0.0);
+	if( !Transform.is_Okay() )
+	{
+		return( false );
+	}
 
-				imin = M_GET_MAX(0, x-iBufDist);
-				imax = M_GET_MIN(x+iBufDist, Get_NX());
-				jmin = M_GET_MAX(0, y-iBufDist);
-				jmax = M_GET_MIN(y+iBufDist, Get_NY());
+	for(y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	{
+		#pragma omp parallel for private(i, j, dDist)
+		for(x=0; x<Get_NX(); x++)
+		{
+			if( Transform.Get_Nearest(x, y, i, j) )
+			{
+				dDist = (double)(x-i)*(x-i)+(double)(y-j)*(y-j);
 
-				for(i=imin; i<imax; i++)
+				if( dDist <= dBufDist )
 				{
-					for(j=jmin; j<jmax; j++)
-					{
-						if( pSource->is_NoData(i, j) )
-						{
-							dDist= (x-i)*(x-i)+(y-j)*(y-j);		
-						
-							if( dDist <= dBufDist && (pDistance->is_NoData(i, j) || pDistance->asDouble(i, j) > dDist) )
-							{
-								pDistance->Set_Value(i, j, dDist);
-								pAlloc->Set_Value(i, j, alloc);
-							}
-						}
-					}//for
-				}//for
-			}//if
-		}//for
-	}//for						
-
+					pDistance->Set_Value(x, y, dDist);
+					pAlloc->Set_Value(x, y, pSource->asInt(i, j));
+				}
+			}
+		}
+	}
 
 	for(y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{		
@@ -63,9 +63,16 @@ CGrid_Proximity::CGrid_Proximity(void)
 	Set_Author		("O.Conrad (c) 2010");
 
 	Set_Description	(_TW(
-		"Calculates a grid with euclidean distance to feature cells (not no-data cells)."
+		"Calculates a grid with euclidean distance to feature cells (not no-data cells). "
+		"Distances are exact and obtained with the linear time distance transform "
+		"of Meijster et al. (2000)."
 	));
 
+	Add_Reference("Meijster, A., Roerdink, J.B.T.M., Hesselink, W.H.", "2000",
+		"A general algorithm for computing distance transforms in linear time",
+		"In: Mathematical Morphology and its Applications to Image and Signal Processing, Computational Imaging and Vision, 18, 331-340."
+	);
+
 	Parameters.Add_Grid("", "FEATURES"  , _TL("Features"  ), _TL(""), PARAMETER_INPUT          );
 	Parameters.Add_Grid("", "DISTANCE"  , _TL("Distance"  ), _TL(""), PARAMETER_OUTPUT         );
 	Parameters.Add_Grid("", "DIRECTION" , _TL("Direction" ), _TL(""), PARAMETER_OUTPUT_OPTIONAL);
@@ -86,97 +93,47 @@ bool CGrid_Proximity::On_Execute(void)
 	CSG_Grid *pAllocation = Parameters("ALLOCATION")->asGrid();
 
 	//-----------------------------------------------------
-	Process_Set_Text(_TL("preparing distance calculation..."));
+	Process_Set_Text(_TL("performing distance calculation..."));
 
-	CSG_Shapes Points(SHAPE_TYPE_Point, NULL, NULL, SG_VERTEX_TYPE_XYZ);
+	CSG_Grid_Distance_Transform Transform(*pFeatures);
 
-	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	if( !Transform.is_Okay() )
 	{
-		for(int x=0; x<Get_NX(); x++)
-		{
-			if( pFeatures->is_NoData(x, y) )
-			{
-				pDistance->Set_Value(x, y, -1.);
-			}
-			else
-			{
-				pDistance->Set_Value(x, y,  0.);
-
-				if( pDirection )
-				{
-					pDirection->Set_NoData(x, y);
-				}
-
-				if( pAllocation )
-				{
-					pAllocation->Set_Value(x, y, pFeatures->asDouble(x, y));
-				}
-
-				//-----------------------------------------
-				bool bBorder = false;
-
-				for(int i=0; !bBorder && i<8; i++)
-				{
-					int ix = Get_xTo(i, x), iy = Get_yTo(i, y);
-
-					bBorder = is_InGrid(ix, iy) && pFeatures->is_NoData(ix, iy);
-				}
-
-				if( bBorder )
-				{
-					Points.Add_Shape()->Add_Point(CSG_Point_3D(x, y, pFeatures->asDouble(x, y)));
-				}
-			}
-		}
+		return( false );
 	}
 
-	if( Points.Get_Count() < 1 )
+	if( Transform.Get_Nearest(0, 0) < 0 )
 	{
 		Message_Add(_TL("no features to allocate."));
 
 		return( false );
 	}
 
-	CSG_KDTree_2D Search(&Points);
-
 	//-----------------------------------------------------
-	Process_Set_Text(_TL("performing distance calculation..."));
-
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
 		{
-			if( pDistance->asDouble(x, y) < 0. )
-			{
-				size_t Index; double Distance;
+			int ix, iy; Transform.Get_Nearest(x, y, ix, iy);
+
+			pDistance->Set_Value(x, y, Transform.Get_Map_Distance(x, y));
 
-				if( Search.Get_Nearest_Point(x, y, Index, Distance) )
+			if( pDirection )
+			{
+				if( ix != x || iy != y )
 				{
-					pDistance->Set_Value(x, y, Distance * Get_Cellsize());
-
-					CSG_Shape &Point = *Points.Get_Shape((sLong)Index);
-
-					if( pDirection )
-					{
-						if( Distance > 0. )
-						{
-							TSG_Point p = Point.Get_Point();
-
-							pDirection->Set_Value(x, y, SG_Get_Angle_Of_Direction(x, y, p.x, p.y) * M_RAD_TO_DEG);
-						}
-						else
-						{
-							pDirection->Set_NoData(x, y);
-						}
-					}
-
-					if( pAllocation )
-					{
-						pAllocation->Set_Value(x, y, Point.Get_Z(0));
-					}
+					pDirection->Set_Value(x, y, SG_Get_Angle_Of_Direction(x, y, ix, iy) * M_RAD_TO_DEG);
 				}
+				else
+				{
+					pDirection->Set_NoData(x, y);
+				}
+			}
+
+			if( pAllocation )
+			{
+				pAllocation->Set_Value(x, y, pFeatures->asDouble(ix, iy));
 			}
 		}
 	}
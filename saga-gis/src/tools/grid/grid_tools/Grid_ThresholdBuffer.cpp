@@ -79,7 +79,7 @@ bool CThresholdBuffer::On_Execute(void)
 		{
 			if( !m_pFeatures->is_NoData(x, y) && m_pFeatures->asDouble(x, y) != 0. )
 			{
-				BufferPoint(x, y);
+				BufferPoint(x, y);	// threshold controlled region growing, extent does not depend on distance
 			}
 		}
 	}
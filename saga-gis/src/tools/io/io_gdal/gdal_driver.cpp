@@ -313,6 +313,11 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const char *Driver
 
 	m_File_Name	= File_Name;
 
+	for(int i=0; Drivers && Drivers[i]; i++)	// re-opening for parallel reading requests the same drivers
+	{
+		m_Drivers	+= CSG_String(Drivers[i]);
+	}
+
 	m_Access	= SG_GDAL_IO_READ;
 
 	return( _Set_Transformation() );
@@ -401,9 +406,15 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const CSG_Grid_Sys
 }
 
 //---------------------------------------------------------
-bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const CSG_Rect &Extent)
+/**
+  * Opens the window of the dataset covering Extent (snapped to the
+  * dataset's cells). If Cellsize is coarser than the dataset's own
+  * resolution, the window is resampled to it while reading, which
+  * lets GDAL take the values from internal overviews if available.
+*/
+bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const CSG_Rect &Extent, double Cellsize)
 {
-	if( Extent.Get_Area() > 0. )
+	if( Extent.Get_Area() > 0. || Cellsize > 0. )
 	{
 		CSG_GDAL_DataSet DataSet;
 
@@ -415,12 +426,27 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const CSG_Rect &Ex
 		double   c = DataSet.Get_System().Get_Cellsize();
 		TSG_Rect r = DataSet.Get_System().Get_Extent(true);
 
-		r.xMin	= r.xMin + (floor((Extent.Get_XMin() - r.xMin) / c) + 0.5) * c;
-		r.xMax	= r.xMax + (ceil ((Extent.Get_XMax() - r.xMax) / c) - 0.5) * c;
-		r.yMin	= r.yMin + (floor((Extent.Get_YMin() - r.yMin) / c) + 0.5) * c;
-		r.yMax	= r.yMax + (ceil ((Extent.Get_YMax() - r.yMax) / c) - 0.5) * c;
+		if( Extent.Get_Area() > 0. )
+		{
+			r.xMin	= r.xMin + floor((Extent.Get_XMin() - r.xMin) / c) * c;
+			r.xMax	= r.xMax + ceil ((Extent.Get_XMax() - r.xMax) / c) * c;
+			r.yMin	= r.yMin + floor((Extent.Get_YMin() - r.yMin) / c) * c;
+			r.yMax	= r.yMax + ceil ((Extent.Get_YMax() - r.yMax) / c) * c;
+		}
+		else if( Cellsize <= c )
+		{
+			return( Open_Read(File_Name) );
+		}
+
+		if( Cellsize > c )
+		{
+			c	= Cellsize;
+		}
 
-		CSG_Grid_System	System(c, r);
+		int	nx	= (int)((r.xMax - r.xMin) / c + 0.5); if( nx < 1 ) nx = 1;
+		int	ny	= (int)((r.yMax - r.yMin) / c + 0.5); if( ny < 1 ) ny = 1;
+
+		CSG_Grid_System	System(c, r.xMin + 0.5 * c, r.yMin + 0.5 * c, nx, ny);
 
 		return( System.is_Valid() && System.Get_Extent(true).Intersects(DataSet.Get_System().Get_Extent(true)) && Open_Read(File_Name, System) );
 	}
@@ -621,6 +647,7 @@ bool CSG_GDAL_DataSet::Close(void)
 	}
 
 	m_File_Name.Clear();
+	m_Drivers  .Clear();
 
 	m_Access	= SG_GDAL_IO_CLOSED;
 
@@ -655,6 +682,27 @@ CSG_String CSG_GDAL_DataSet::Get_DriverID(void)	const
 	return( s ? s : "" );
 }
 
+//---------------------------------------------------------
+/**
+* Returns false, if the data is not read from a local file,
+* e.g. from a web service or through a virtual file system
+* like /vsicurl/.
+*/
+//---------------------------------------------------------
+bool CSG_GDAL_DataSet::_is_Local(void)	const
+{
+	GDALDatasetH pDataSet = m_pVrtSource ? m_pVrtSource : m_pDataSet;
+
+	const char *Driver = pDataSet ? GDALGetDescription(GDALGetDatasetDriver(pDataSet)) : NULL;
+
+	if( !Driver || !strcmp(Driver, "WMS") || !strcmp(Driver, "WMTS") || !strcmp(Driver, "WCS") || !strcmp(Driver, "HTTP") )
+	{
+		return( false );
+	}
+
+	return( SG_File_Exists(m_File_Name) );
+}
+
 //---------------------------------------------------------
 const char * CSG_GDAL_DataSet::Get_Projection(void)	const
 {
@@ -1035,34 +1083,106 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 	}
 
 	//-----------------------------------------------------
-	void *zLine; GDALDataType zType;
+	// Rows are read in strips of whole block rows, so that each
+	// block is decoded only once. Strips are distributed among
+	// threads, each of which re-opens the dataset (including a
+	// VRT window and with the drivers requested when opening),
+	// since GDAL handles must not be shared between threads.
+	// Datasets that are not local files are read by one thread.
+	// Values are copied directly into the grid's row memory, if
+	// data types match and the grid is not cached.
 
-	switch( Type )
+	GDALDataType zType = (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type);
+
+	bool bDirect = pGrid->Get_Row_Data(0) != NULL && gSG_GDAL_Drivers.Get_SAGA_Type(zType) == Type;
+
+	if( !bDirect )
+	{
+		zType = GDT_Float64;
+	}
+
+	int nBytes = bDirect ? pGrid->Get_nValueBytes() : (int)sizeof(double);
+
+	int nxBlock, nyBlock; GDALGetBlockSize(pBand, &nxBlock, &nyBlock);
+
+	int nRows = nyBlock < 1 ? 1 : nyBlock; while( nRows < 16 ) { nRows += nyBlock < 1 ? 1 : nyBlock; }	// at least 16 rows for scanline organized datasets
+
+	if( nRows > Get_NY() )
 	{
-	default                : zLine = SG_Malloc(Get_NX() * sizeof(   int)); zType = GDT_Int32  ; break;
-	case SG_DATATYPE_Float : zLine = SG_Malloc(Get_NX() * sizeof( float)); zType = GDT_Float32; break;
-	case SG_DATATYPE_Double: zLine = SG_Malloc(Get_NX() * sizeof(double)); zType = GDT_Float64; break;
+		nRows = Get_NY();
 	}
 
-	for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+	int nStrips = 1 + (Get_NY() - 1) / nRows;
+
+	//-----------------------------------------------------
+	int nThreads = _is_Local() ? M_GET_MIN(SG_OMP_Get_Max_Num_Threads(), nStrips) : 1;	// don't fetch network sources once per thread
+
+	CSG_Array_Pointer DataSets(nThreads); DataSets[0] = this;
+
+	CSG_Array_Pointer Drivers; for(int iDriver=0; iDriver<m_Drivers.Get_Count(); iDriver++) { Drivers += (void *)m_Drivers[iDriver].b_str(); }
+
+	Drivers += (void *)NULL;
+
+	for(int iThread=1; iThread<nThreads; iThread++)
 	{
-		int	yy	= m_bTransform ? y : Get_NY() - 1 - y;
+		CSG_GDAL_DataSet *pDataSet = new CSG_GDAL_DataSet;
+
+		if( !(m_pVrtSource ? pDataSet->Open_Read(m_File_Name, Get_System()) : pDataSet->Open_Read(m_File_Name, m_Drivers.Get_Count() > 0 ? (const char **)Drivers.Get_Array() : NULL)) )
+		{
+			delete(pDataSet);
 
-		if( GDALRasterIO(pBand, GF_Read, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, zType, 0, 0) == CE_None )
+			nThreads = iThread;
+		}
+		else
+		{
+			DataSets[iThread] = pDataSet;
+		}
+	}
+
+	//-----------------------------------------------------
+	CSG_Progress Progress(nStrips);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+	for(int iStrip=0; iStrip<nStrips; iStrip++)
+	{
+		if( !Progress.Step() )
 		{
-			for(int x=0; x<Get_NX(); x++)
+			continue;
+		}
+
+		GDALRasterBandH pStripBand = GDALGetRasterBand(((CSG_GDAL_DataSet *)DataSets[SG_OMP_Get_Thread_Num()])->m_pDataSet, i + 1);
+
+		int y = iStrip * nRows, ny = M_GET_MIN(nRows, Get_NY() - y);
+
+		CSG_Array Strip(nBytes, (sLong)Get_NX() * ny); char *zStrip = (char *)Strip.Get_Array();
+
+		if( pStripBand && zStrip && GDALRasterIO(pStripBand, GF_Read, 0, y, Get_NX(), ny, zStrip, Get_NX(), ny, zType, 0, 0) == CE_None )
+		{
+			for(int iy=0; iy<ny; iy++, zStrip+=(size_t)nBytes*Get_NX())
 			{
-				switch( Type )
+				int yy = m_bTransform ? y + iy : Get_NY() - 1 - (y + iy);
+
+				if( bDirect )
 				{
-				default                : pGrid->Set_Value(x, yy, ((int    *)zLine)[x], false); break;
-				case SG_DATATYPE_Float : pGrid->Set_Value(x, yy, ((float  *)zLine)[x], false); break;
-				case SG_DATATYPE_Double: pGrid->Set_Value(x, yy, ((double *)zLine)[x], false); break;
+					memcpy(pGrid->Get_Row_Data(yy), zStrip, (size_t)nBytes * Get_NX());
+				}
+				else for(int x=0; x<Get_NX(); x++)
+				{
+					pGrid->Set_Value(x, yy, ((double *)zStrip)[x], false);
 				}
 			}
 		}
 	}
 
-	SG_Free(zLine);
+	for(int iThread=1; iThread<nThreads; iThread++)
+	{
+		delete((CSG_GDAL_DataSet *)DataSets[iThread]);
+	}
+
+	if( bDirect )
+	{
+		pGrid->Set_Modified();
+	}
 
 	return( pGrid );
 }
@@ -127,7 +127,7 @@ public:
 
 	bool						Open_Read			(const CSG_String &File_Name, const char *Drivers[] = NULL);
 	bool						Open_Read			(const CSG_String &File_Name, const CSG_Grid_System &System);
-	bool						Open_Read			(const CSG_String &File_Name, const CSG_Rect &Extent);
+	bool						Open_Read			(const CSG_String &File_Name, const CSG_Rect &Extent, double Cellsize = 0.);
 	bool						Open_Write			(const CSG_String &File_Name, const CSG_String &Driver, const CSG_String &Options, TSG_Data_Type Type, int NBands, const CSG_Grid_System &System, const CSG_Projection &Projection);
 	bool						Close				(void);
 
@@ -190,6 +190,8 @@ private:
 
 	CSG_String					m_File_Name;
 
+	CSG_Strings					m_Drivers;
+
 	CSG_Vector					m_TF_A;
 
 	CSG_Matrix					m_TF_B, m_TF_BInv;
@@ -198,6 +200,8 @@ private:
 
 
 	bool						_Get_Transformation	(double Transform[6]);
+
+	bool						_is_Local			(void)	const;
 	bool						_Set_Transformation	(void);
 
 
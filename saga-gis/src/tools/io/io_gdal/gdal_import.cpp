@@ -210,6 +210,12 @@ CGDAL_Import::CGDAL_Import(void)
 		_TL(""),
 		0., 0., true
 	);
+
+	Parameters.Add_Double("",
+		"CELLSIZE"		, _TL("Cellsize"),
+		_TL("If greater than zero and coarser than the dataset's resolution, the data is resampled (nearest neighbour) to this cellsize while reading, taking values from the dataset's internal overviews, if available."),
+		0., 0., true
+	);
 }
 
 
@@ -349,7 +355,11 @@ bool CGDAL_Import::Load(const CSG_String &File, TSG_Grid_Resampling Resampling,
 		return( Load_Subsets(DataSet, Resampling, Extent, Projection) );
 	}
 
-	if( Extent.Get_Area() > 0. && !DataSet.Open_Read(File, Extent) )
+	double Cellsize = Parameters("CELLSIZE")->asDouble();
+
+	bool bSubset = Extent.Get_Area() > 0. || Cellsize > DataSet.Get_Cellsize();
+
+	if( bSubset && !DataSet.Open_Read(File, Extent, Cellsize) )
 	{
 		Message_Add(_TL("failed: there is no intersection of dataset's extent and targeted extent."));
 
@@ -460,7 +470,7 @@ bool CGDAL_Import::Load(const CSG_String &File, TSG_Grid_Resampling Resampling,
 					DataSet.Get_Transformation(&pGrid, Resampling, true);
 				}
 
-				if( !Extent.Get_Area() ) // don't associate it with the original file if it's only a subset!
+				if( !bSubset ) // don't associate it with the original file if it's only a subset!
 				{
 					pGrid->Set_File_Name(DataSet.Get_File_Name());
 				}
@@ -491,7 +501,7 @@ bool CGDAL_Import::Load(const CSG_String &File, TSG_Grid_Resampling Resampling,
 	{
 		CSG_Grids	*pCollection	= SG_Create_Grids();
 
-		if( !Extent.Get_Area() ) // don't associate it with the original file if it's only a subset!
+		if( !bSubset ) // don't associate it with the original file if it's only a subset!
 		{
 			pCollection->Set_File_Name(DataSet.Get_File_Name());
 		}
@@ -214,44 +214,61 @@ bool CPC_Attribute_Calculator::On_Execute(void)
 
 
 	//---------------------------------------------------------
-	CSG_Vector	Values(nFields);
+	// points are processed in chunks, the attribute values of a
+	// chunk being read column-wise and the formula being applied
+	// to all points of a chunk at once
 
-	for(sLong i=0; i<pPC_in->Get_Count() && Set_Progress(i, pPC_in->Get_Count()); i++ )
+	const sLong	nChunk	= 65536;
+
+	pPC_out->Reserve(pPC_in->Get_Count());
+
+	CSG_Matrix		Values(nChunk, nFields);
+	CSG_Vector		Result(nChunk);
+	CSG_Array_Int	bOkay (nChunk);
+
+	for(sLong iPoint=0; iPoint<pPC_in->Get_Count() && Set_Progress(iPoint, pPC_in->Get_Count()); iPoint+=nChunk)
 	{
-		bool	bOkay	= true;
+		sLong	n	= M_GET_MIN(nChunk, pPC_in->Get_Count() - iPoint);
 
-		pPC_out->Add_Point(pPC_in->Get_X(i), pPC_in->Get_Y(i), pPC_in->Get_Z(i));
+		for(int iField=0; iField<nFields; iField++)
+		{
+			pPC_in->Get_Field_Values(pFields[iField], Values[iField], iPoint, n);
+		}
 
-		for (int j=0; j<pPC_in->Get_Attribute_Count(); j++)
+		#pragma omp parallel for
+		for(sLong i=0; i<n; i++)
 		{
-			switch (pPC_in->Get_Attribute_Type(j))
+			bOkay[i]	= 1;
+
+			for(int iField=0; iField<nFields && !bUseNoData; iField++)
 			{
-			default:					pPC_out->Set_Attribute(i, j, pPC_in->Get_Attribute(i, j));		break;
-			case SG_DATATYPE_Date:
-			case SG_DATATYPE_String:	CSG_String sAttr; pPC_in->Get_Attribute(i, j, sAttr); pPC_out->Set_Attribute(i, j, sAttr);		break;
+				if( pPC_in->is_NoData_Value(Values[iField][i]) )
+				{
+					bOkay[i]	= 0;
+
+					break;
+				}
 			}
 		}
 
-		for( int iField=0; iField<nFields && bOkay; iField++ )
+		if( !Formula.Get_Values((const double **)Values.Get_Data(), nFields, Result.Get_Data(), n) )
+		{
+			bOkay.Assign(0);
+		}
+
+		for(sLong i=0, j=iPoint; i<n; i++, j++)
 		{
-			if( !pPC_in->is_NoData(i, pFields[iField]) || bUseNoData )
+			pPC_out->Add_Point(pPC_in, j);
+
+			if( bOkay[i] )
 			{
-				Values[iField]	= pPC_in->Get_Value(i, pFields[iField]);
+				pPC_out->Set_Value(j, pPC_in->Get_Field_Count(), Result[i]);
 			}
 			else
 			{
-				bOkay = false;
+				pPC_out->Set_NoData(j, pPC_in->Get_Field_Count());
 			}
 		}
-
-		if( bOkay )
-		{
-			pPC_out->Set_Value(i, pPC_in->Get_Field_Count(), Formula.Get_Value(Values.Get_Data(), nFields));
-		}
-		else
-		{
-			pPC_out->Set_NoData(i, pPC_in->Get_Field_Count());
-		}
 	}
 
 
@@ -165,9 +165,11 @@ bool CPC_Thinning_Simple::On_Execute(void)
 
 		pResult->Fmt_Name("%s [%.1f%%]", pPoints->Get_Name(), Parameters("PERCENT")->asDouble());
 
+		pResult->Reserve(n);
+
 		for(sLong i=0; i<n && Set_Progress(i, n); i++)
 		{
-			pResult->Add_Record(pPoints->Get_Record((sLong)(i * d)));
+			pResult->Add_Point(pPoints, (sLong)(i * d));
 		}
 	}
 
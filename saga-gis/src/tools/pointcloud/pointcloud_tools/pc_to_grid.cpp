@@ -174,23 +174,43 @@ bool CPC_To_Grid::On_Execute(void)
 	m_pCount	->Set_NoData_Value(0.0);
 
 	//-----------------------------------------------------
-	for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Set_Progress(iPoint, pPoints->Get_Count()); iPoint++)
+	// coordinates and attributes are read column-wise in chunks of points
+
+	const sLong nChunk = 65536; int nFields = 3 + pGrids->Get_Grid_Count();
+
+	CSG_Vector Values(nChunk * nFields);
+
+	for(sLong iChunk=0; iChunk<pPoints->Get_Count() && Set_Progress(iChunk, pPoints->Get_Count()); iChunk+=nChunk)
 	{
-		pPoints->Set_Cursor(iPoint);
+		sLong nPoints = M_GET_MIN(nChunk, pPoints->Get_Count() - iChunk);
+
+		pPoints->Get_Field_Values(0, Values.Get_Data() + 0, iChunk, nPoints, nFields);
+		pPoints->Get_Field_Values(1, Values.Get_Data() + 1, iChunk, nPoints, nFields);
+		pPoints->Get_Field_Values(2, Values.Get_Data() + 2, iChunk, nPoints, nFields);
 
-		if( System.Get_World_to_Grid(x, y, pPoints->Get_X(), pPoints->Get_Y()) )
+		for(iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
 		{
-			int		n	= m_pCount->asInt(x, y);
-			double	z	= pPoints->Get_Z();
+			pPoints->Get_Field_Values(iGrid + 3, Values.Get_Data() + iGrid + 3, iChunk, nPoints, nFields);
+		}
+
+		const double *Point = Values.Get_Data();
 
-			for(iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
+		for(sLong iPoint=0; iPoint<nPoints; iPoint++, Point+=nFields)
+		{
+			if( System.Get_World_to_Grid(x, y, Point[0], Point[1]) )
 			{
-				Set_Value(x, y, z, n, pPoints->Get_Value(iGrid + 3), pGrids->Get_Grid(iGrid));
-			}
+				int		n	= m_pCount->asInt(x, y);
+				double	z	= Point[2];
 
-			Set_Value(x, y, z, n, z, m_pGrid);
+				for(iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
+				{
+					Set_Value(x, y, z, n, Point[iGrid + 3], pGrids->Get_Grid(iGrid));
+				}
+
+				Set_Value(x, y, z, n, z, m_pGrid);
 
-			m_pCount->Add_Value(x, y, 1);
+				m_pCount->Add_Value(x, y, 1);
+			}
 		}
 	}
 
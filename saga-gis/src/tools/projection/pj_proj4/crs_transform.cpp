@@ -578,6 +578,85 @@ bool CSG_CRSProjector::Get_Projection(CSG_Point_3D &Point)	const
 	return( false );
 }
 
+//---------------------------------------------------------
+/**
+* Projects n coordinates in one call to PROJ. Coordinates
+* that cannot be projected are set to HUGE_VAL. Returns the
+* number of successfully projected coordinates.
+*/
+int CSG_CRSProjector::Get_Projection(double *x, double *y, int n)	const
+{
+	if( !m_pSource || !m_pTarget || n < 1 )
+	{
+		return( 0 );
+	}
+
+	#if PROJ_VERSION_MAJOR < 6
+	if( pj_is_latlong((PJ *)m_pSource) )
+	#else
+	if( proj_angular_output((PJ *)m_pSource, PJ_FWD) )
+	#endif
+	{
+		for(int i=0; i<n; i++)
+		{
+			x[i]	*= M_DEG_TO_RAD;
+			y[i]	*= M_DEG_TO_RAD;
+		}
+	}
+
+	#if PROJ_VERSION_MAJOR < 6
+	bool	bOkay;
+
+	if( m_pGCS )	// precise datum conversion
+	{
+		bOkay	= pj_transform((PJ *)m_pSource, (PJ *)m_pGCS   , n, 1, x, y, NULL) == 0
+			&&    pj_transform((PJ *)m_pGCS   , (PJ *)m_pTarget, n, 1, x, y, NULL) == 0;
+	}
+	else			// direct projection
+	{
+		bOkay	= pj_transform((PJ *)m_pSource, (PJ *)m_pTarget, n, 1, x, y, NULL) == 0;
+	}
+
+	if( !bOkay )
+	{
+		for(int i=0; i<n; i++)	// failed points are not reported individually, so none is trusted
+		{
+			x[i]	= y[i]	= HUGE_VAL;
+		}
+
+		return( 0 );
+	}
+	#else
+	proj_trans_generic((PJ *)m_pSource, PJ_INV, x, sizeof(double), n, y, sizeof(double), n, NULL, 0, 0, NULL, 0, 0); proj_errno_reset((PJ *)m_pSource);
+	proj_trans_generic((PJ *)m_pTarget, PJ_FWD, x, sizeof(double), n, y, sizeof(double), n, NULL, 0, 0, NULL, 0, 0); proj_errno_reset((PJ *)m_pTarget);
+	#endif
+
+	#if PROJ_VERSION_MAJOR < 6
+	double	Scale	= pj_is_latlong((PJ *)m_pTarget) ? M_RAD_TO_DEG : 1.;
+	#else
+	double	Scale	= proj_angular_output((PJ *)m_pTarget, PJ_FWD) ? M_RAD_TO_DEG : 1.;
+	#endif
+
+	int	nOkay	= 0;
+
+	for(int i=0; i<n; i++)
+	{
+		if( x[i] == HUGE_VAL || y[i] == HUGE_VAL )
+		{
+			x[i]	= y[i]	= HUGE_VAL;
+		}
+		else
+		{
+			x[i]	*= Scale;
+			y[i]	*= Scale;
+
+			nOkay++;
+		}
+	}
+
+	return( nOkay );
+}
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -115,6 +115,8 @@ public:
 	bool					Get_Projection				(TSG_Point_3D &Point)				const;
 	bool					Get_Projection				(CSG_Point_3D &Point)				const;
 
+	int						Get_Projection				(double *x, double *y, int n)		const;
+
 
 private:
 
@@ -125,6 +125,12 @@ CCRS_Transform_Grid::CCRS_Transform_Grid(bool bList)
 		SG_DATATYPES_Numeric, SG_DATATYPE_Undefined, _TL("Preserve")
 	);
 
+	Parameters.Add_Double("TARGET_NODE",
+		"APPROXIMATION"	, _TL("Approximation Error"),
+		_TL("Maximum error, measured in source grid cells, of the linear interpolation of source coordinates between adaptively refined control points along each row. Set to zero to project each cell's coordinate exactly."),
+		0.125, 0., true
+	);
+
 	Parameters.Add_Bool("TARGET_NODE",
 		"TARGET_AREA"	, _TL("Use Target Area Polygon"),
 		_TL("Restricts targeted grid cells to area of the projected bounding rectangle. Useful with certain projections for global data."),
@@ -357,28 +363,20 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	m_Approximation	= Parameters("APPROXIMATION")->asDouble() * pGrid->Get_Cellsize();
+
+	CSG_Vector	xSources(pTarget->Get_NX()), ySources(pTarget->Get_NX());
+
 	for(int y=0; y<pTarget->Get_NY() && Set_Progress(y, pTarget->Get_NY()); y++)
 	{
-		double	yTarget	= pTarget->Get_YMin() + y * pTarget->Get_Cellsize();
+		Get_Coordinates(pTarget->Get_System(), y, xSources.Get_Data(), ySources.Get_Data());
 
-		#if PROJ_VERSION_MAJOR >= 6	// proj.4 is not parallelizable?!
 		#pragma omp parallel for
-		#endif
 		for(int x=0; x<pTarget->Get_NX(); x++)
 		{
-			if( !is_In_Target_Area(x, y) )
-			{
-				continue;
-			}
-
-			double	z, ySource, xSource	= pTarget->Get_XMin() + x * pTarget->Get_Cellsize();
+			double	z, ySource = ySources[x], xSource = xSources[x];
 
-			//---------------------------------------------------------
-			#if PROJ_VERSION_MAJOR >= 6
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
-			#else
-			if( !m_Projector.Get_Projection(xSource, ySource = yTarget) )
-			#endif
+			if( !is_In_Target_Area(x, y) || xSource == HUGE_VAL )
 			{
 				continue;
 			}
@@ -517,27 +515,20 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	m_Approximation = Parameters("APPROXIMATION")->asDouble() * Source_System.Get_Cellsize();
+
+	CSG_Vector xSources(Target_System.Get_NX()), ySources(Target_System.Get_NX());
+
 	for(int y=0; y<Target_System.Get_NY() && Set_Progress(y, Target_System.Get_NY()); y++)
 	{
-		double yTarget = Target_System.Get_YMin() + y * Target_System.Get_Cellsize();
+		Get_Coordinates(Target_System, y, xSources.Get_Data(), ySources.Get_Data());
 
-		#if PROJ_VERSION_MAJOR >= 6	// proj.4 is not parallelizable?!
 		#pragma omp parallel for
-		#endif
 		for(int x=0; x<Target_System.Get_NX(); x++)
 		{
-			if( !is_In_Target_Area(x, y) )
-			{
-				continue;
-			}
+			double z, ySource = ySources[x], xSource = xSources[x];
 
-			double z, ySource, xSource = Target_System.Get_XMin() + x * Target_System.Get_Cellsize();
-
-			#if PROJ_VERSION_MAJOR >= 6
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
-			#else
-			if( !m_Projector.Get_Projection(xSource, ySource = yTarget) )
-			#endif
+			if( !is_In_Target_Area(x, y) || xSource == HUGE_VAL )
 			{
 				continue;
 			}
@@ -696,6 +687,122 @@ bool CCRS_Transform_Grid::Transform(CSG_Parameter_Grid_List *pGrids, CSG_Shapes
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Source coordinates for all cells of the target row y.
+// The row is split into one segment per thread, each using
+// its own projector copy. Coordinates that could not be
+// projected are set to HUGE_VAL.
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Coordinates(const CSG_Grid_System &Target, int y, double *xSource, double *ySource)
+{
+	#if PROJ_VERSION_MAJOR >= 6	// proj.4 is not parallelizable?!
+	int	nSegments	= SG_OMP_Get_Max_Num_Threads();
+	#else
+	int	nSegments	= 1;
+	#endif
+
+	#if PROJ_VERSION_MAJOR >= 6
+	#pragma omp parallel for
+	#endif
+	for(int i=0; i<nSegments; i++)
+	{
+		int	a	= (int)(((sLong)Target.Get_NX() *  i     ) / nSegments);
+		int	b	= (int)(((sLong)Target.Get_NX() * (i + 1)) / nSegments) - 1;
+
+		if( a <= b )
+		{
+			#if PROJ_VERSION_MAJOR >= 6
+			const CSG_CRSProjector	&Projector	= m_Projector[SG_OMP_Get_Thread_Num()];
+			#else
+			const CSG_CRSProjector	&Projector	= m_Projector;
+			#endif
+
+			if( m_Approximation > 0. && b - a > 1 )
+			{
+				Get_Coordinates_Exact (Projector, Target, y, a, a, xSource, ySource);
+				Get_Coordinates_Exact (Projector, Target, y, b, b, xSource, ySource);
+				Get_Coordinates_Approx(Projector, Target, y, a, b, xSource, ySource);
+			}
+			else
+			{
+				Get_Coordinates_Exact (Projector, Target, y, a, b, xSource, ySource);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+// Projects the cells a to b (inclusive) with one call.
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Coordinates_Exact(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int a, int b, double *xSource, double *ySource)
+{
+	for(int x=a; x<=b; x++)
+	{
+		xSource[x]	= Target.Get_XMin() + x * Target.Get_Cellsize();
+		ySource[x]	= Target.Get_YMin() + y * Target.Get_Cellsize();
+	}
+
+	Projector.Get_Projection(xSource + a, ySource + a, 1 + b - a);
+}
+
+//---------------------------------------------------------
+// Expects the exact coordinates of cells a and b. Projects
+// the cell in the middle and, if its coordinate deviates
+// less than the tolerance from the linear interpolation
+// between a and b, interpolates the remaining cells, else
+// subdivides. Short spans are projected exactly.
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Coordinates_Approx(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int a, int b, double *xSource, double *ySource)
+{
+	if( b - a < 2 )
+	{
+		return;
+	}
+
+	if( b - a < 8 )
+	{
+		Get_Coordinates_Exact(Projector, Target, y, a + 1, b - 1, xSource, ySource);
+
+		return;
+	}
+
+	int	m	= (a + b) / 2;
+
+	Get_Coordinates_Exact(Projector, Target, y, m, m, xSource, ySource);
+
+	if( xSource[a] != HUGE_VAL && xSource[m] != HUGE_VAL && xSource[b] != HUGE_VAL )
+	{
+		double	d	= (m - a) / (double)(b - a);
+		double	dx	= xSource[a] + d * (xSource[b] - xSource[a]) - xSource[m];
+		double	dy	= ySource[a] + d * (ySource[b] - ySource[a]) - ySource[m];
+
+		if( dx*dx + dy*dy <= m_Approximation*m_Approximation )
+		{
+			double	dxSource	= (xSource[b] - xSource[a]) / (b - a);
+			double	dySource	= (ySource[b] - ySource[a]) / (b - a);
+
+			for(int x=a+1; x<b; x++)
+			{
+				if( x != m )
+				{
+					xSource[x]	= xSource[a] + (x - a) * dxSource;
+					ySource[x]	= ySource[a] + (x - a) * dySource;
+				}
+			}
+
+			return;
+		}
+	}
+
+	Get_Coordinates_Approx(Projector, Target, y, a, m, xSource, ySource);
+	Get_Coordinates_Approx(Projector, Target, y, m, b, xSource, ySource);
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
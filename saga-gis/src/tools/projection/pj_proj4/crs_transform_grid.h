@@ -87,6 +87,8 @@ private:
 
 	bool						m_bList, m_bByteWise;
 
+	double						m_Approximation;
+
 	TSG_Grid_Resampling			m_Resampling;
 
 	CSG_Parameters_Grid_Target	m_Grid_Target;
@@ -100,6 +102,10 @@ private:
 	bool						Transform					(CSG_Grid                *pGrid , CSG_Shapes *pPoints);
 	bool						Transform					(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPoints);
 
+	void						Get_Coordinates				(const CSG_Grid_System &Target, int y, double *xSource, double *ySource);
+	void						Get_Coordinates_Exact		(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int a, int b, double *xSource, double *ySource);
+	void						Get_Coordinates_Approx		(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int a, int b, double *xSource, double *ySource);
+
 	void						Get_MinMax					(TSG_Rect &r, double x, double y);
 	bool						Get_Target_System			(const CSG_Grid_System &System, bool bEdge);
 
@@ -77,17 +77,21 @@ bool CCountPoints::On_Execute(void)
 
 	pPolygons->Add_Field(_TL("Points"), SG_DATATYPE_Int);
 
+	CSG_Array_sLong	Candidates;
+
 	for(sLong iPolygon=0; iPolygon<pPolygons->Get_Count() && Set_Progress(iPolygon, pPolygons->Get_Count()); iPolygon++)
 	{
 		CSG_Shape_Polygon	*pPolygon	= (CSG_Shape_Polygon *)pPolygons->Get_Shape(iPolygon);
 
 		int	nPoints	= 0;
 
-		for(sLong iPoint=0; iPoint<pPoints->Get_Count(); iPoint++)
+		pPoints->Get_Intersecting(pPolygon->Get_Extent(), Candidates);	// points within the polygon's extent
+
+		for(sLong i=0; i<Candidates.Get_Size(); i++)
 		{
-			CSG_Shape	*pPoint	= pPoints->Get_Shape(iPoint);
+			CSG_Shape	*pPoint	= pPoints->Get_Shape(Candidates[i]);
 
-			if( pPolygon->Contains(pPoint->Get_Point(iPoint)) )
+			if( pPolygon->Contains(pPoint->Get_Point()) )
 			{
 				nPoints++;
 			}
@@ -156,23 +156,18 @@ bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 	m_pA	= pA;
 	m_pB	= pB;
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	return( _Get_Overlay(false) );
+}
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+//---------------------------------------------------------
+bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+{
+	m_bInvert	= bInvert;
 
-	//-----------------------------------------------------
-	for(sLong id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
-	{
-		for(sLong id_B=0; id_B<m_pB->Get_Count(); id_B++)
-		{
-			if( SG_Shape_Get_Intersection(m_pA->Get_Shape(id_A), m_pB->Get_Shape(id_B)->asPolygon(), pResult) )
-			{
-				_Add_Polygon(pResult, id_A, id_B);
-			}
-		}
-	}
+	m_pA	= pA;
+	m_pB	= pB;
 
-	return( true );
+	return( _Get_Overlay(true) );
 }
 
 
@@ -181,45 +176,160 @@ bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+#define OVERLAY_CHUNK	1024
+
+//---------------------------------------------------------
+// Layer A polygons are only clipped with those layer B
+// polygons, whose bounding boxes intersect, as found with
+// an R-tree. Layer A polygons are processed in parallel,
+// collecting the results in thread-local layers, which are
+// then merged in the order of layer A, so that the output
+// does not depend on the number of threads.
+//---------------------------------------------------------
+bool CPolygon_Overlay::_Get_Overlay(bool bDifference)
 {
-	m_bInvert	= bInvert;
+	CSG_RTree	Index;
 
-	m_pA	= pA;
-	m_pB	= pB;
+	for(sLong id_B=0; id_B<m_pB->Get_Count(); id_B++)	// update cached extents, areas and lake flags before concurrent read access
+	{
+		CSG_Shape_Polygon	*pPolygon	= m_pB->Get_Shape(id_B)->asPolygon();
+
+		for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+		{
+			pPolygon->is_Lake(iPart); pPolygon->Get_Area(iPart);
+		}
+	}
+
+	Index.Create(m_pB);
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	//-----------------------------------------------------
+	int	nThreads	= SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Shapes	*Results	= new CSG_Shapes[nThreads];
+
+	for(int i=0; i<nThreads; i++)
+	{
+		Results[i].Create(SHAPE_TYPE_Polygon);
+		Results[i].Add_Field("ID_B", SG_DATATYPE_Long);
+	}
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+	CSG_Array_Int	Thread(OVERLAY_CHUNK);	CSG_Array_sLong	First(OVERLAY_CHUNK), Count(OVERLAY_CHUNK);
 
 	//-----------------------------------------------------
-	for(sLong id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+	for(sLong iChunk=0; iChunk<m_pA->Get_Count() && Set_Progress(iChunk, m_pA->Get_Count()); iChunk+=OVERLAY_CHUNK)
 	{
-		pResult->Assign(m_pA->Get_Shape(id_A), false);
+		sLong	nChunk	= M_GET_MIN(OVERLAY_CHUNK, m_pA->Get_Count() - iChunk);
 
-		for(sLong id_B=0; id_B<m_pB->Get_Count() && pResult->is_Valid(); id_B++)
+		#pragma omp parallel for schedule(dynamic)
+		for(sLong i=0; i<nChunk; i++)
 		{
-			switch( pResult->Intersects(m_pB->Get_Shape(id_B)) )
+			int	iThread	= SG_OMP_Get_Thread_Num();
+
+			Thread[i]	= iThread;
+			First [i]	= Results[iThread].Get_Count();
+
+			if( bDifference )
 			{
-			case INTERSECTION_None:
-				break;
-
-			case INTERSECTION_Identical:
-			case INTERSECTION_Contained:
-				pResult->Del_Parts();
-				break;
-
-			case INTERSECTION_Contains:
-			case INTERSECTION_Overlaps:
-				SG_Shape_Get_Difference(pResult, m_pB->Get_Shape(id_B)->asPolygon());
-				break;
+				_Get_Difference  (iChunk + i, Index, Results[iThread]);
 			}
+			else
+			{
+				_Get_Intersection(iChunk + i, Index, Results[iThread]);
+			}
+
+			Count [i]	= Results[iThread].Get_Count() - First[i];
 		}
 
-		if( pResult->is_Valid() )
+		//-------------------------------------------------
+		for(sLong i=0; i<nChunk; i++)
 		{
-			_Add_Polygon(pResult, id_A);
+			for(sLong j=First[i]; j<First[i]+Count[i]; j++)
+			{
+				CSG_Shape	*pResult	= Results[Thread[i]].Get_Shape(j);
+
+				_Add_Polygon(pResult->asPolygon(), iChunk + i, bDifference ? -1 : pResult->asLong(0));
+			}
 		}
+
+		for(int i=0; i<nThreads; i++)
+		{
+			Results[i].Del_Shapes();
+		}
+	}
+
+	delete[](Results);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CPolygon_Overlay::_Get_Intersection(sLong id_A, const CSG_RTree &Index, CSG_Shapes &Results)
+{
+	CSG_Shape	*pA	= m_pA->Get_Shape(id_A);
+
+	CSG_Array_sLong	Candidates;
+
+	if( Index.Get_Intersecting(pA->Get_Extent(), Candidates) < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Shape	*pResult	= Results.Add_Shape();
+
+	for(sLong i=0; i<Candidates.Get_Size(); i++)
+	{
+		if( SG_Shape_Get_Intersection(pA, m_pB->Get_Shape(Candidates[i])->asPolygon(), pResult) )
+		{
+			pResult->Set_Value(0, Candidates[i]);
+
+			pResult	= Results.Add_Shape();
+		}
+	}
+
+	Results.Del_Shape(pResult);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CPolygon_Overlay::_Get_Difference(sLong id_A, const CSG_RTree &Index, CSG_Shapes &Results)
+{
+	CSG_Shape	*pA	= m_pA->Get_Shape(id_A);
+
+	CSG_Array_sLong	Candidates;
+
+	Index.Get_Intersecting(pA->Get_Extent(), Candidates);
+
+	CSG_Shape_Polygon	*pResult	= Results.Add_Shape()->asPolygon();
+
+	pResult->Assign(pA, false);
+
+	for(sLong i=0; i<Candidates.Get_Size() && pResult->is_Valid(); i++)
+	{
+		CSG_Shape	*pB	= m_pB->Get_Shape(Candidates[i]);
+
+		switch( pResult->Intersects(pB) )
+		{
+		case INTERSECTION_None:
+			break;
+
+		case INTERSECTION_Identical:
+		case INTERSECTION_Contained:
+			pResult->Del_Parts();
+			break;
+
+		case INTERSECTION_Contains:
+		case INTERSECTION_Overlaps:
+			SG_Shape_Get_Difference(pResult, pB->asPolygon());
+			break;
+		}
+	}
+
+	if( !pResult->is_Valid() )
+	{
+		Results.Del_Shape(pResult);
+
+		return( false );
 	}
 
 	return( true );
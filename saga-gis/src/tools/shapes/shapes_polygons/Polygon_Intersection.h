@@ -95,6 +95,10 @@ private:
 	CSG_Shapes				*m_pA, *m_pB, *m_pAB;
 
 
+	bool					_Get_Overlay		(bool bDifference);
+	bool					_Get_Intersection	(sLong id_A, const CSG_RTree &Index, CSG_Shapes &Results);
+	bool					_Get_Difference		(sLong id_A, const CSG_RTree &Index, CSG_Shapes &Results);
+
 	CSG_Shape_Polygon *		_Add_Polygon		(sLong id_A, sLong id_B);
 	bool					_Add_Polygon		(CSG_Shape_Polygon *pPolygon, sLong id_A, sLong id_B = -1);
 	bool					_Fit_Polygon		(CSG_Shape_Polygon *pPolygon);
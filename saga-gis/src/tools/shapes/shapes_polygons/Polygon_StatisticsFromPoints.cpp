@@ -159,10 +159,14 @@ bool CPolygonStatisticsFromPoints::On_Execute(void)
 	//-----------------------------------------------------
 	CSG_Simple_Statistics *Statistics = new CSG_Simple_Statistics[pFields->Get_Count()];
 
+	CSG_Array_sLong Candidates;
+
 	for(sLong iPolygon=0; iPolygon<pPolygons->Get_Count() && Set_Progress(iPolygon, pPolygons->Get_Count()); iPolygon++)
 	{
 		CSG_Shape_Polygon *pPolygon = pPolygons->Get_Shape(iPolygon)->asPolygon();
 
+		pPoints->Get_Intersecting(pPolygon->Get_Extent(), Candidates); // points within the polygon's extent
+
 		//-------------------------------------------------
 		for(int i=0; i<pFields->Get_Count(); i++)
 		{
@@ -170,9 +174,9 @@ bool CPolygonStatisticsFromPoints::On_Execute(void)
 		}
 
 		//-------------------------------------------------
-		for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Process_Get_Okay(); iPoint++)
+		for(sLong i=0; i<Candidates.Get_Size() && Process_Get_Okay(); i++)
 		{
-			CSG_Shape *pPoint = pPoints->Get_Shape(iPoint);
+			CSG_Shape *pPoint = pPoints->Get_Shape(Candidates[i]);
 
 			if( pPolygon->Contains(pPoint->Get_Point()) )
 			{
@@ -191,14 +191,18 @@ bool CAdd_Point_Attributes::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
+	CSG_Array_sLong	Candidates;
+
 	for(sLong iPolygon=0; iPolygon<pOutput->Get_Count() && Set_Progress(iPolygon, pOutput->Get_Count()); iPolygon++)
 	{
 		CSG_Shape_Polygon	*pPolygon	= (CSG_Shape_Polygon *)pOutput->Get_Shape(iPolygon);
 
+		pPoints->Get_Intersecting(pPolygon->Get_Extent(), Candidates);	// points within the polygon's extent
+
 		//-------------------------------------------------
-		for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Process_Get_Okay(); iPoint++)
+		for(sLong i=0; i<Candidates.Get_Size() && Process_Get_Okay(); i++)
 		{
-			CSG_Shape	*pPoint	= pPoints->Get_Shape(iPoint);
+			CSG_Shape	*pPoint	= pPoints->Get_Shape(Candidates[i]);
 
 			if( pPolygon->Contains(pPoint->Get_Point()) )
 			{
@@ -49,6 +49,138 @@
 
 #include "kriging_base.h"
 
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define KRIGING_CACHE_SIZE	16
+
+//---------------------------------------------------------
+// A local kriging system, i.e. the neighbour points and the
+// inverted covariance matrix, identified by the sorted
+// indices of the points it has been built from.
+//---------------------------------------------------------
+class CKriging_Neighbourhood
+{
+public:
+	CKriging_Neighbourhood(void) : m_bOkay(false), m_Used(0) {}
+
+	bool				m_bOkay;
+
+	sLong				m_Used;
+
+	CSG_Array_sLong		m_Index;
+
+	CSG_Matrix			m_Points, m_W;
+
+
+	bool				is_Equal		(const CSG_Array_sLong &Index)	const
+	{
+		if( m_Index.Get_Size() != Index.Get_Size() )
+		{
+			return( false );
+		}
+
+		for(sLong i=0; i<Index.Get_Size(); i++)
+		{
+			if( m_Index[i] != Index[i] )
+			{
+				return( false );
+			}
+		}
+
+		return( true );
+	}
+
+};
+
+//---------------------------------------------------------
+// Each thread keeps its own small set of recently used
+// kriging systems, so that neighbouring cells sharing the
+// same neighbour points do not have to invert the same
+// matrix again. The tile system is used for all cells of
+// a tile with the block-wise solver.
+//---------------------------------------------------------
+class CKriging_Cache
+{
+public:
+	CKriging_Cache(void) : m_Tick(0), m_bTile(false) {}
+
+	~CKriging_Cache(void)
+	{
+		Clear();
+	}
+
+	void						Clear		(void)
+	{
+		for(sLong i=0; i<m_Items.Get_Size(); i++)
+		{
+			delete((CKriging_Neighbourhood *)m_Items[i]);
+		}
+
+		m_Items.Destroy(); m_Tick = 0; m_bTile = false;
+	}
+
+	CKriging_Neighbourhood *	Get			(const CSG_Array_sLong &Index)
+	{
+		for(sLong i=0; i<m_Items.Get_Size(); i++)
+		{
+			CKriging_Neighbourhood *pItem = (CKriging_Neighbourhood *)m_Items[i];
+
+			if( pItem->is_Equal(Index) )
+			{
+				pItem->m_Used = ++m_Tick;
+
+				return( pItem );
+			}
+		}
+
+		return( NULL );
+	}
+
+	CKriging_Neighbourhood *	Add			(const CSG_Array_sLong &Index)
+	{
+		CKriging_Neighbourhood *pItem = NULL;
+
+		if( m_Items.Get_Size() < KRIGING_CACHE_SIZE )
+		{
+			m_Items.Add(pItem = new CKriging_Neighbourhood);
+		}
+		else // replace least recently used
+		{
+			pItem = (CKriging_Neighbourhood *)m_Items[0];
+
+			for(sLong i=1; i<m_Items.Get_Size(); i++)
+			{
+				if( pItem->m_Used > ((CKriging_Neighbourhood *)m_Items[i])->m_Used )
+				{
+					pItem = (CKriging_Neighbourhood *)m_Items[i];
+				}
+			}
+		}
+
+		pItem->m_Index.Create(Index);
+		pItem->m_Used = ++m_Tick;
+
+		return( pItem );
+	}
+
+	sLong						m_Tick;
+
+	bool						m_bTile;
+
+	CKriging_Neighbourhood		m_Tile, m_Single;
+
+	CSG_Array_Pointer			m_Items;
+
+};
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -135,6 +267,25 @@ CKriging_Base::CKriging_Base(void)
 		100., 0., true
 	);
 
+	Parameters.Add_Choice("NODE_KRG",
+		"SOLVER"		, _TL("Solver"),
+		_TL("Only affects local search. 'cell by cell' sets up and inverts the kriging system for each target cell. "
+			"'reuse systems' keeps recently used systems and reuses them for all cells sharing the same neighbour points, the results equal those of 'cell by cell' up to floating point rounding. "
+			"'tile-wise' sets up one system per tile from the neighbour points nearest to the tile centre and applies it to all cells of the tile, "
+			"which is fastest but only an approximation of the cell by cell solution."),
+		CSG_String::Format("%s|%s|%s",
+			_TL("cell by cell"),
+			_TL("reuse systems"),
+			_TL("tile-wise")
+		), 1
+	);
+
+	Parameters.Add_Int("SOLVER",
+		"SOLVER_TILE"	, _TL("Tile Size"),
+		_TL("Edge length of the tiles processed as one unit [cells]."),
+		16, 1, true
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("NODE_KRG",
 		"CV_METHOD"		, _TL("Cross Validation"),
@@ -186,6 +337,8 @@ CKriging_Base::CKriging_Base(void)
 //---------------------------------------------------------
 CKriging_Base::~CKriging_Base(void)
 {
+	_Del_Caches();
+
 	if( m_pVariogram && has_GUI() && SG_UI_Get_Window_Main() ) // don't destroy dialog, if gui is closing (i.e. main window == NULL)
 	{
 		#ifdef WITH_GUI
@@ -236,6 +389,16 @@ int CKriging_Base::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Paramet
 		pParameters->Set_Enabled("CV_SAMPLES"  , pParameter->asInt() == 3);	// k-fold
 	}
 
+	if(	pParameter->Cmp_Identifier("SEARCH_RANGE") || pParameter->Cmp_Identifier("SEARCH_POINTS_ALL") )
+	{
+		CSG_Parameter *pRange = (*pParameters)("SEARCH_RANGE"), *pAll = (*pParameters)("SEARCH_POINTS_ALL");
+
+		bool bLocal = !pRange || !pAll || pRange->asInt() == 0 || pAll->asInt() == 0;	// a global search uses one system for all cells
+
+		pParameters->Set_Enabled("SOLVER"      , bLocal);
+		pParameters->Set_Enabled("SOLVER_TILE" , bLocal);
+	}
+
 	m_Search_Options.On_Parameters_Enable(pParameters, pParameter);
 	m_Grid_Target   .On_Parameters_Enable(pParameters, pParameter);
 
@@ -266,6 +429,8 @@ bool CKriging_Base::On_Execute(void)
 
 	m_Block = Parameters("BLOCK")->asBool() ? Parameters("DBLOCK")->asDouble() / 2. : 0.;
 
+	m_Solver = Parameters("SOLVER")->asInt();
+
 	//-----------------------------------------------------
 	bool bResult = Init_Points(pPoints, Field, bLog);	
 
@@ -323,36 +488,61 @@ bool CKriging_Base::On_Execute(void)
 
 		Message_Fmt("\n%s: %s", _TL("Variogram Model"), m_Model.Get_Formula(SG_TREND_STRING_Formula_Parameters).c_str());
 
-		for(int y=0; y<m_pValue->Get_NY() && Set_Progress(y, m_pValue->Get_NY()); y++)
+		int Size = Parameters("SOLVER_TILE")->asInt();
+
+		int nx = 1 + (m_pValue->Get_NX() - 1) / Size;
+		int ny = 1 + (m_pValue->Get_NY() - 1) / Size;
+
+		CSG_Progress Progress((sLong)nx * ny);
+
+		#ifndef _DEBUG
+		#pragma omp parallel for schedule(dynamic)
+		#endif // !_DEBUG
+		for(int iTile=0; iTile<nx*ny; iTile++)
 		{
-			double py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
+			if( !Progress.Step() )
+			{
+				continue;
+			}
 
-			#ifndef _DEBUG
-			#pragma omp parallel for
-			#endif // !_DEBUG
-			for(int x=0; x<m_pValue->Get_NX(); x++)
+			int xa = Size * (iTile % nx), xb = M_GET_MIN(xa + Size, m_pValue->Get_NX());
+			int ya = Size * (iTile / nx), yb = M_GET_MIN(ya + Size, m_pValue->Get_NY());
+
+			bool bTile = m_Solver == 2 && _Set_Tile(xa, ya, xb, yb);
+
+			for(int y=ya; y<yb; y++)
 			{
-				double v, e, px = m_pValue->Get_XMin() + x * m_pValue->Get_Cellsize();
+				double py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
 
-				if( Get_Value(px, py, v, e) )
+				for(int x=xa; x<xb; x++)
 				{
-					if( bLog )
+					double v, e, px = m_pValue->Get_XMin() + x * m_pValue->Get_Cellsize();
+
+					if( Get_Value(px, py, v, e) )
 					{
-						v = exp(v) - 1. + pPoints->Get_Minimum(Field);
-					}
+						if( bLog )
+						{
+							v = exp(v) - 1. + pPoints->Get_Minimum(Field);
+						}
+
+						if( bStdDev )
+						{
+							e = sqrt(e);
+						}
 
-					if( bStdDev )
+						Set_Value(x, y, v, e);
+					}
+					else
 					{
-						e = sqrt(e);
+						Set_NoData(x, y);
 					}
-
-					Set_Value(x, y, v, e);
-				}
-				else
-				{
-					Set_NoData(x, y);
 				}
 			}
+
+			if( bTile )
+			{
+				_Del_Tile();
+			}
 		}
 
 		_Get_Cross_Validation();
@@ -361,6 +551,8 @@ bool CKriging_Base::On_Execute(void)
 	//-----------------------------------------------------
 	m_Model.Clr_Data();
 
+	_Del_Caches();
+
 	m_Search.Destroy();
 	m_W     .Destroy();
 	m_Points.Destroy();
@@ -426,40 +618,170 @@ bool CKriging_Base::Init_Points(CSG_Shapes *pPoints, int Field, bool bLog)
 //---------------------------------------------------------
 bool CKriging_Base::_Init_Search(bool bUpdate)
 {
+	_Del_Caches();	// indices refer to the current point set
+
 	if( m_Search_Options.Do_Use_All(bUpdate) )	// global
 	{
 		return( Get_Weights(m_Points, m_W) );
 	}
 
+	for(int i=0; i<SG_OMP_Get_Max_Num_Threads(); i++)
+	{
+		m_Caches.Add(new CKriging_Cache);
+	}
+
 	return( m_Search.Create(m_Points) );	// local
 }
 
+//---------------------------------------------------------
+void CKriging_Base::_Del_Caches(void)
+{
+	for(sLong i=0; i<m_Caches.Get_Size(); i++)
+	{
+		delete((CKriging_Cache *)m_Caches[i]);
+	}
+
+	m_Caches.Destroy();
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CKriging_Base::Get_Points(double x, double y, CSG_Matrix &Points)
+bool CKriging_Base::_Get_System(const CSG_Array_sLong &Index, CSG_Matrix &Points, CSG_Matrix &W)
+{
+	if( Index.Get_Size() >= (sLong)m_Search_Options.Get_Min_Points() && Points.Create(3, Index.Get_Size()) )
+	{
+		for(sLong i=0; i<Index.Get_Size(); i++)
+		{
+			Points.Set_Row(i, m_Points[Index[i]]);
+		}
+
+		return( Get_Weights(Points, W) );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+/**
+  * Sets up the kriging system for all cells of the tile
+  * spanning the columns xa to xb - 1 and rows ya to yb - 1,
+  * using the neighbour points of the tile's centre. The
+  * search radius is extended by half the tile diagonal, so
+  * that the tile's corner cells see the points they would
+  * have seen with cell by cell search.
+*/
+bool CKriging_Base::_Set_Tile(int xa, int ya, int xb, int yb)
 {
-	if( m_Search.is_Okay() )
+	int Thread = SG_OMP_Get_Thread_Num();
+
+	if( !m_Search.is_Okay() || Thread >= m_Caches.Get_Size() )
+	{
+		return( false );
+	}
+
+	CKriging_Cache &Cache = *(CKriging_Cache *)m_Caches[Thread];
+
+	double Cellsize = m_pValue->Get_Cellsize();
+
+	double x = m_pValue->Get_XMin() + Cellsize * (xa + xb - 1) / 2.;
+	double y = m_pValue->Get_YMin() + Cellsize * (ya + yb - 1) / 2.;
+
+	double Radius = m_Search_Options.Get_Radius();
+
+	if( Radius > 0. )
+	{
+		Radius += Cellsize * sqrt(SG_Get_Square(xb - xa - 1) + SG_Get_Square(yb - ya - 1)) / 2.;
+	}
+
+	CSG_Array_sLong Index; CSG_Vector Distance;
+
+	m_Search.Get_Nearest_Points(x, y, m_Search_Options.Get_Max_Points(), Radius, Index, Distance);
+
+	Cache.m_Tile.m_bOkay = _Get_System(Index, Cache.m_Tile.m_Points, Cache.m_Tile.m_W);
+
+	return( Cache.m_bTile = true );
+}
+
+//---------------------------------------------------------
+void CKriging_Base::_Del_Tile(void)
+{
+	int Thread = SG_OMP_Get_Thread_Num();
+
+	if( Thread < m_Caches.Get_Size() )
+	{
+		((CKriging_Cache *)m_Caches[Thread])->m_bTile = false;
+	}
+}
+
+//---------------------------------------------------------
+/**
+  * Provides the kriging system to be used for the
+  * prediction at the given location. The returned matrices
+  * are owned by the tool and stay valid until the next
+  * request from the same thread.
+*/
+bool CKriging_Base::Get_Neighbourhood(double x, double y, sLong &n, double **&P, double **&W)
+{
+	n = 0;
+
+	if( !m_Search.is_Okay() )	// global
+	{
+		n = m_Points.Get_NRows();
+		P = m_Points.Get_Data ();
+		W = m_W     .Get_Data ();
+
+		return( n > 0 );
+	}
+
+	//-----------------------------------------------------
+	int Thread = SG_OMP_Get_Thread_Num();
+
+	if( Thread >= m_Caches.Get_Size() )
+	{
+		return( false );
+	}
+
+	CKriging_Cache &Cache = *(CKriging_Cache *)m_Caches[Thread];
+
+	CKriging_Neighbourhood *pSystem = &Cache.m_Tile;
+
+	if( !Cache.m_bTile )
 	{
 		CSG_Array_sLong Index; CSG_Vector Distance;
 
 		m_Search.Get_Nearest_Points(x, y, m_Search_Options.Get_Max_Points(), m_Search_Options.Get_Radius(), Index, Distance);
-		
-		if( Index.Get_Size() >= (sLong)m_Search_Options.Get_Min_Points() && Points.Create(3, Index.Get_Size()) )
+
+		if( m_Solver == 0 )	// cell by cell
+		{
+			pSystem = &Cache.m_Single;
+
+			pSystem->m_bOkay = _Get_System(Index, pSystem->m_Points, pSystem->m_W);
+		}
+		else				// reuse systems
 		{
-			for(sLong i=0; i<Index.Get_Size(); i++)
+			std::sort(Index.Get_Array(), Index.Get_Array() + Index.Get_Size());
+
+			if( (pSystem = Cache.Get(Index)) == NULL )
 			{
-				Points.Set_Row(i, m_Points[Index[i]]);
-			}
+				pSystem = Cache.Add(Index);
 
-			return( true );
+				pSystem->m_bOkay = _Get_System(Index, pSystem->m_Points, pSystem->m_W);
+			}
 		}
 	}
 
-	return( false );
+	if( pSystem->m_bOkay )
+	{
+		n = pSystem->m_Points.Get_NRows();
+		P = pSystem->m_Points.Get_Data ();
+		W = pSystem->m_W     .Get_Data ();
+	}
+
+	return( n > 0 );
 }
 
 
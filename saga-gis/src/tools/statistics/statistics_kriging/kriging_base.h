@@ -89,7 +89,7 @@ protected:
 
 	virtual bool					Init_Points				(CSG_Shapes *pPoints, int Field, bool bLog);
 
-	bool							Get_Points				(double x, double y, CSG_Matrix &Points);
+	bool							Get_Neighbourhood		(double x, double y, sLong &n, double **&P, double **&W);
 
 	virtual bool					Get_Weights				(const CSG_Matrix &Points, CSG_Matrix &W)	= 0;
 
@@ -130,8 +130,12 @@ protected:
 
 private:
 
+	int								m_Solver;
+
 	double							m_Block;
 
+	CSG_Array_Pointer				m_Caches;
+
 	CSG_Trend						m_Model;
 
 	CSG_Parameters_Grid_Target		m_Grid_Target;
@@ -144,6 +148,11 @@ private:
 	bool							_Init_Grids				(void);
 
 	bool							_Init_Search			(bool bUpdate = false);
+	void							_Del_Caches				(void);
+
+	bool							_Get_System				(const CSG_Array_sLong &Index, CSG_Matrix &Points, CSG_Matrix &W);
+	bool							_Set_Tile				(int xa, int ya, int xb, int yb);
+	void							_Del_Tile				(void);
 
 	bool							_Get_Cross_Validation	(void);
 
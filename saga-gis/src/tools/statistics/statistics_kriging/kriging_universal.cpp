@@ -212,22 +212,9 @@ bool CKriging_Universal::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 //---------------------------------------------------------
 bool CKriging_Universal::Get_Value(double x, double y, double &v, double &e)
 {
-	CSG_Matrix __Points, __W; double **P, **W; sLong n = 0; v = e = 0.;
+	double **P, **W; sLong n; v = e = 0.;
 
-	if( !m_Search.is_Okay() )
-	{	// global
-		n = m_Points.Get_NRows();
-		P = m_Points.Get_Data ();
-		W = m_W     .Get_Data ();
-	}
-	else if( Get_Points(x, y, __Points) && Get_Weights(__Points, __W) )
-	{	// local
-		n = __Points.Get_NRows();
-		P = __Points.Get_Data ();
-		W = __W     .Get_Data ();
-	}
-
-	if( n < 1 )
+	if( !Get_Neighbourhood(x, y, n, P, W) )
 	{
 		return( false );
 	}
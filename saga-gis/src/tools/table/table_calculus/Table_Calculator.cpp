@@ -301,19 +301,22 @@ bool CTable_Field_Calculator::On_Execute(void)
 	g_NoData_loValue = pTable->Get_NoData_Value(false);
 	g_NoData_hiValue = pTable->Get_NoData_Value(true );
 
-	if( pTable->Get_Selection_Count() > 0 && Parameters("SELECTION")->asBool() )
-	{
-		for(sLong i=0; i<pTable->Get_Selection_Count() && Set_Progress(i, pTable->Get_Selection_Count()); i++)
-		{
-			Get_Value(pTable->Get_Selection(i));
-		}
-	}
-	else
+	bool bSelection = pTable->Get_Selection_Count() > 0 && Parameters("SELECTION")->asBool();
+
+	sLong nRecords = bSelection ? pTable->Get_Selection_Count() : pTable->Get_Count();
+
+	const sLong nChunk = 4096; CSG_Array_Pointer Records;
+
+	for(sLong iRecord=0; iRecord<nRecords && Set_Progress(iRecord, nRecords); iRecord+=nChunk)
 	{
-		for(sLong i=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i++)
+		Records.Set_Array(M_GET_MIN(nChunk, nRecords - iRecord));
+
+		for(sLong i=0; i<Records.Get_Size(); i++)
 		{
-			Get_Value(pTable->Get_Record(i));
+			Records[i] = bSelection ? pTable->Get_Selection(iRecord + i) : pTable->Get_Record(iRecord + i);
 		}
+
+		Get_Values((CSG_Table_Record **)Records.Get_Array(), Records.Get_Size());
 	}
 
 	//-----------------------------------------------------
@@ -331,32 +334,43 @@ bool CTable_Field_Calculator::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CTable_Field_Calculator::Get_Value(CSG_Table_Record *pRecord)
+bool CTable_Field_Calculator::Get_Values(CSG_Table_Record **pRecords, sLong nRecords)
 {
-	CSG_Vector Values(m_Values.Get_uSize());
-
-	bool bNoData = false;
+	CSG_Matrix Values(nRecords, m_Values.Get_Size()); CSG_Vector Result(nRecords); CSG_Array_Int bOkay(nRecords);
 
-	for(sLong i=0; i<m_Values.Get_Size(); i++)
+	for(sLong i=0; i<nRecords; i++)
 	{
-		Values[i] = pRecord->asDouble(m_Values[i]);
+		bOkay[i] = 1;
 
-		if( !m_bNoData && pRecord->is_NoData(m_Values[i]) )
+		for(sLong j=0; j<m_Values.Get_Size(); j++)
 		{
-			bNoData = true;
+			Values[j][i] = pRecords[i]->asDouble(m_Values[j]);
+
+			if( !m_bNoData && pRecords[i]->is_NoData(m_Values[j]) )
+			{
+				bOkay[i] = 0;
+			}
 		}
 	}
 
-	if( bNoData == false )
+	if( !m_Formula.Get_Values((const double **)Values.Get_Data(), (int)m_Values.Get_Size(), Result.Get_Data(), nRecords) )
 	{
-		pRecord->Set_Value(m_Result, m_Formula.Get_Value(Values));
-
-		return( true );
+		bOkay.Assign(0);
 	}
 
-	pRecord->Set_NoData(m_Result);
+	for(sLong i=0; i<nRecords; i++)
+	{
+		if( bOkay[i] )
+		{
+			pRecords[i]->Set_Value(m_Result, Result[i]);
+		}
+		else
+		{
+			pRecords[i]->Set_NoData(m_Result);
+		}
+	}
 
-	return( false );
+	return( true );
 }
 
 
@@ -95,7 +95,7 @@ private:
 	CSG_Formula				m_Formula;
 
 
-	bool					Get_Value				(CSG_Table_Record *pRecord);
+	bool					Get_Values				(CSG_Table_Record **pRecords, sLong nRecords);
 
 	CSG_String				Get_Formula				(CSG_String Formula, CSG_Table *pTable, CSG_Array_Int &Values);
 
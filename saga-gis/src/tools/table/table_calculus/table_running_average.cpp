@@ -197,6 +197,10 @@ bool CTable_Running_Average::On_Execute(void)
 
 	#undef GET_FIELD
 
+	CSG_Table_Column Values(pTable, fValue);	// each value is visited Length times, so take them from a column snapshot
+
+	bool bSnapshot = Values.is_Valid() && !Values.is_String();	// text and date fields have no numeric snapshot, read these from the records
+
 	//-----------------------------------------------------
 	for(sLong i=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i++)
 	{
@@ -208,11 +212,18 @@ bool CTable_Running_Average::On_Execute(void)
 			{
 				if( j >= 0 && j < pTable->Get_Count() )
 				{
-					CSG_Table_Record *pRecord = pTable->Get_Record(Index.is_Okay() ? Index[j] : j);
+					sLong k = Index.is_Okay() ? Index[j] : j;
 
-					if( pRecord && !pRecord->is_NoData(fValue) )
+					if( bSnapshot )
+					{
+						if( !Values.is_NoData(k) )
+						{
+							s += Values.asDouble(k);
+						}
+					}
+					else if( !pTable->Get_Record(k)->is_NoData(fValue) )
 					{
-						s += pRecord->asDouble(fValue);
+						s += pTable->Get_Record(k)->asDouble(fValue);
 					}
 				}
 			}
@@ -48,6 +48,8 @@
 //---------------------------------------------------------
 #include "Flow_Length.h"
 
+#include "flow_graph.h"
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -115,9 +117,11 @@ bool CFlow_Length::On_Execute(void)
 	CSG_Grid *pWeights  = Parameters("WEIGHTS"  )->asGrid();
 	CSG_Grid *pDistance = Parameters("DISTANCE" )->asGrid();
 
-	if( !pDEM->Set_Index() )
+	CFlow_Graph Graph;
+
+	if( !Graph.Create(pDEM) )
 	{
-		Error_Set(_TL("index creation failed"));
+		Error_Set(_TL("flow graph creation failed"));
 
 		return( false );
 	}
@@ -126,18 +130,22 @@ bool CFlow_Length::On_Execute(void)
 	pDistance->Assign_NoData();
 
 	//-----------------------------------------------------
+	// cells are visited along the topological levels of the
+	// flow graph, cells of one level being processed in parallel
+
 	if( Parameters("DIRECTION")->asInt() == 0 )	// downstream
 	{
 		pDistance->Fmt_Name("%s [%s]", _TL("Flow Path Length"), _TL("downstream"));
 
 		DataObject_Set_Colors(pDistance, 11, SG_COLORS_RAINBOW);
 
-		for(sLong iCell=0; iCell<Get_NCells() && Set_Progress_Cells(iCell); iCell++)
+		for(int iLevel=Graph.Get_Level_Count()-1; iLevel>=0 && Set_Progress(Graph.Get_Level_Count() - iLevel, Graph.Get_Level_Count()); iLevel--)
 		{
-			int x, y;
-
-			if( pDEM->Get_Sorted(iCell, x, y, false) )
+			#pragma omp parallel for
+			for(sLong iCell=Graph.Get_Level_First(iLevel); iCell<Graph.Get_Level_Last(iLevel); iCell++)
 			{
+				int x, y; Graph.Get_Cell(iCell, x, y);
+
 				double Distance = 0.; int i = pDEM->Get_Gradient_NeighborDir(x, y, true, false);
 
 				if( i >= 0 )
@@ -163,34 +171,34 @@ bool CFlow_Length::On_Execute(void)
 
 		DataObject_Set_Colors(pDistance, 11, SG_COLORS_WHITE_BLUE);
 
-		for(sLong iCell=0; iCell<Get_NCells() && Set_Progress_Cells(iCell); iCell++)
+		for(int iLevel=0; iLevel<Graph.Get_Level_Count() && Set_Progress(iLevel, Graph.Get_Level_Count()); iLevel++)
 		{
-			int x, y;
-
-			if( pDEM->Get_Sorted(iCell, x, y, true) )
+			#pragma omp parallel for
+			for(sLong iCell=Graph.Get_Level_First(iLevel); iCell<Graph.Get_Level_Last(iLevel); iCell++)
 			{
-				if( pDistance->is_NoData(x, y) )
-				{
-					pDistance->Set_Value(x, y, 0.);
-				}
+				int x, y; Graph.Get_Cell(iCell, x, y);
 
-				int i = pDEM->Get_Gradient_NeighborDir(x, y, true, false);
+				double Distance = 0.;
 
-				if( i >= 0 )
+				for(int i=0; i<8; i++)
 				{
-					int	ix	= Get_xTo(i, x);
-					int	iy	= Get_yTo(i, y);
-
-					if( pDEM->is_InGrid(ix, iy) )
+					if( Graph.is_Donor(x, y, i) )
 					{
-						double	Distance	= pDistance->asDouble(x, y) + Get_Length(i) * (pWeights ? pWeights->asDouble(x, y) : 1.0);
+						int ix = Get_xTo(i, x), iy = Get_yTo(i, y);
 
-						if( pDistance->is_NoData(ix, iy) || pDistance->asDouble(ix, iy) < Distance )
+						if( pDEM->Get_Gradient_NeighborDir(ix, iy, true, false) == (i + 4) % 8 )
 						{
-							pDistance->Set_Value(ix, iy, Distance);
+							double	d	= pDistance->asDouble(ix, iy) + Get_Length(i) * (pWeights ? pWeights->asDouble(ix, iy) : 1.0);
+
+							if( Distance < d )
+							{
+								Distance	= d;
+							}
 						}
 					}
 				}
+
+				pDistance->Set_Value(x, y, Distance);
 			}
 		}
 	}
@@ -278,13 +278,6 @@ bool CFlow_Parallel::Calculate(int x, int y)
 //---------------------------------------------------------
 bool CFlow_Parallel::Set_Flow(void)
 {
-	//-----------------------------------------------------
-	if( !m_pDTM->Set_Index() )
-	{
-		return( false );
-	}
-
-	//-----------------------------------------------------
 	int Method	= Parameters("METHOD")->asInt();
 
 	if( Method == 2 )
@@ -308,6 +301,22 @@ bool CFlow_Parallel::Set_Flow(void)
 		pLoss->Assign_NoData();
 	}
 
+	//-----------------------------------------------------
+	if( !m_pRoute && !pLinear_Dir && !m_pAccu_Target && (Method == 0 || Method == 3 || Method == 4 || Method == 6) )
+	{
+		CFlow_Graph Graph;
+
+		if( Graph.Create(m_pDTM) )
+		{
+			return( Set_Flow(Graph, Method, dLinear, pLinear_Val, bNoNegatives, pLoss) );
+		}
+	}
+
+	if( !m_pDTM->Set_Index() )
+	{
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	for(sLong n=0; n<Get_NCells() && Set_Progress_Cells(n); n++)
 	{
@@ -365,6 +374,75 @@ bool CFlow_Parallel::Set_Flow(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Accumulation along the topological levels of the flow graph.
+// Each cell pulls its inflow from its donors, whose outflow
+// fractions are evaluated on demand, so cells of one level can
+// be processed in parallel without write conflicts.
+//---------------------------------------------------------
+bool CFlow_Parallel::Set_Flow(const CFlow_Graph &Graph, int Method, double dLinear, CSG_Grid *pLinear_Val, bool bNoNegatives, CSG_Grid *pLoss)
+{
+	for(int iLevel=0; iLevel<Graph.Get_Level_Count() && Set_Progress(iLevel, Graph.Get_Level_Count()); iLevel++)
+	{
+		#pragma omp parallel for
+		for(sLong iCell=Graph.Get_Level_First(iLevel); iCell<Graph.Get_Level_Last(iLevel); iCell++)
+		{
+			int x, y; Graph.Get_Cell(iCell, x, y);
+
+			for(int i=0; i<8; i++)
+			{
+				if( Graph.is_Donor(x, y, i) )
+				{
+					int ix = Get_xTo(i, x), iy = Get_yTo(i, y), Direction = (i + 4) % 8; double Fraction[8];
+
+					if( dLinear > 0. && dLinear <= (pLinear_Val && !pLinear_Val->is_NoData(ix, iy) ? pLinear_Val->asDouble(ix, iy) : m_pFlow->asDouble(ix, iy)) )
+					{
+						Get_D8(ix, iy, Fraction);
+					}
+					else switch( Method )
+					{
+					default: Get_D8    (ix, iy, Fraction); break;
+					case  3: Get_DInf  (ix, iy, Fraction); break;
+					case  4: Get_MFD   (ix, iy, Fraction); break;
+					case  6: Get_MMDGFD(ix, iy, Fraction); break;
+					}
+
+					if( Fraction[Direction] > 0. )
+					{
+						double f = Fraction[Direction];
+
+						                      m_pFlow       ->Add_Value(x, y, f *  m_pFlow       ->asDouble(ix, iy));
+						if( m_pFlow_Length ) { m_pFlow_Length->Add_Value(x, y, f * (m_pFlow_Length->asDouble(ix, iy) + Get_Length(Direction))); }
+						if( m_pVal_Mean    ) { m_pVal_Mean   ->Add_Value(x, y, f *  m_pVal_Mean   ->asDouble(ix, iy)); }
+						if( m_pAccu_Total  ) { m_pAccu_Total ->Add_Value(x, y, f *  m_pAccu_Total ->asDouble(ix, iy)); }
+						if( m_pAccu_Left   ) { m_pAccu_Left  ->Add_Value(x, y, f *  m_pAccu_Left  ->asDouble(ix, iy)); }
+						if( m_pAccu_Right  ) { m_pAccu_Right ->Add_Value(x, y, f *  m_pAccu_Right ->asDouble(ix, iy)); }
+					}
+				}
+			}
+
+			if( bNoNegatives && m_pFlow->asDouble(x, y) < 0. )
+			{
+				if( pLoss )
+				{
+					pLoss->Set_Value(x, y, fabs(m_pFlow->asDouble(x, y)));
+				}
+
+				m_pFlow->Set_Value(x, y, 0.);
+			}
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -433,6 +511,19 @@ void CFlow_Parallel::Set_D8(int x, int y, int Direction)
 	Add_Fraction(x, y, Direction >= 0 ? Direction : m_pDTM->Get_Gradient_NeighborDir(x, y));
 }
 
+//---------------------------------------------------------
+bool CFlow_Parallel::Get_D8(int x, int y, double Fraction[8])
+{
+	int Direction = m_pDTM->Get_Gradient_NeighborDir(x, y);
+
+	for(int i=0; i<8; i++)
+	{
+		Fraction[i] = i == Direction ? 1. : 0.;
+	}
+
+	return( Direction >= 0 );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -518,6 +609,23 @@ void CFlow_Parallel::Set_Rho8(int x, int y)
 
 //---------------------------------------------------------
 void CFlow_Parallel::Set_DInf(int x, int y)
+{
+	double Fraction[8];
+
+	if( Get_DInf(x, y, Fraction) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0. )
+			{
+				Add_Fraction(x, y, i, Fraction[i]);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+bool CFlow_Parallel::Get_DInf(int x, int y, double Fraction[8])
 {
 	double	s, a;
 
@@ -532,14 +640,19 @@ void CFlow_Parallel::Set_DInf(int x, int y)
 		if( m_pDTM->is_InGrid(ix = Get_xTo(i + 0, x), iy = Get_yTo(i + 0, y)) && m_pDTM->asDouble(ix, iy) < s
 		&&  m_pDTM->is_InGrid(ix = Get_xTo(i + 1, x), iy = Get_yTo(i + 1, y)) && m_pDTM->asDouble(ix, iy) < s )
 		{
-			Add_Fraction(x, y,  i         , 1. - a);
-			Add_Fraction(x, y, (i + 1) % 8,      a);
+			for(int j=0; j<8; j++)
+			{
+				Fraction[j]	= 0.;
+			}
 
-			return;
+			Fraction[ i         ]	= 1. - a;
+			Fraction[(i + 1) % 8]	+=     a;
+
+			return( true );
 		}
 	}
 
-	Set_D8(x, y);
+	return( Get_D8(x, y, Fraction) );
 }
 
 
@@ -552,7 +665,24 @@ void CFlow_Parallel::Set_DInf(int x, int y)
 //---------------------------------------------------------
 void CFlow_Parallel::Set_MFD(int x, int y)
 {
-	double	dz[8], dzSum = 0., z = m_pDTM->asDouble(x, y);
+	double Fraction[8];
+
+	if( Get_MFD(x, y, Fraction) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0. )
+			{
+				Add_Fraction(x, y, i, Fraction[i]);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+bool CFlow_Parallel::Get_MFD(int x, int y, double dz[8])
+{
+	double	dzSum = 0., z = m_pDTM->asDouble(x, y);
 
 	//-----------------------------------------------------
 	for(int i=0, ix, iy; i<8; i++)
@@ -567,16 +697,12 @@ void CFlow_Parallel::Set_MFD(int x, int y)
 	}
 
 	//-----------------------------------------------------
-	if( dzSum > 0. )
+	for(int i=0; i<8; i++)
 	{
-		for(int i=0; i<8; i++)
-		{
-			if( dz[i] > 0. )
-			{
-				Add_Fraction(x, y, i, dz[i] / dzSum);
-			}
-		}
+		dz[i]	= dzSum > 0. && dz[i] > 0. ? dz[i] / dzSum : 0.;
 	}
+
+	return( dzSum > 0. );
 }
 
 
@@ -589,7 +715,24 @@ void CFlow_Parallel::Set_MFD(int x, int y)
 //---------------------------------------------------------
 void CFlow_Parallel::Set_MMDGFD(int x, int y)
 {
-	double	dz[8], dzMax = 0., z = m_pDTM->asDouble(x, y);
+	double Fraction[8];
+
+	if( Get_MMDGFD(x, y, Fraction) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0. )
+			{
+				Add_Fraction(x, y, i, Fraction[i]);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+bool CFlow_Parallel::Get_MMDGFD(int x, int y, double dz[8])
+{
+	double	dzMax = 0., dzSum = 0., z = m_pDTM->asDouble(x, y);
 
 	//-----------------------------------------------------
 	for(int i=0, ix, iy; i<8; i++)
@@ -606,7 +749,7 @@ void CFlow_Parallel::Set_MMDGFD(int x, int y)
 	//-----------------------------------------------------
 	if( dzMax > 0. )
 	{
-		double dzSum = 0.; dzMax = dzMax < 1. ? 8.9 * dzMax + 1.1 : 10.;
+		dzMax = dzMax < 1. ? 8.9 * dzMax + 1.1 : 10.;
 
 		for(int i=0; i<8; i++)
 		{
@@ -615,15 +758,14 @@ void CFlow_Parallel::Set_MMDGFD(int x, int y)
 				dzSum	+= (dz[i] = pow(dz[i], dzMax) * (m_MFD_bContour && i % 2 ? sqrt(2.) / 2. : 1.));
 			}
 		}
+	}
 
-		for(int i=0; i<8; i++)
-		{
-			if( dz[i] > 0. )
-			{
-				Add_Fraction(x, y, i, dz[i] / dzSum);
-			}
-		}
+	for(int i=0; i<8; i++)
+	{
+		dz[i]	= dzSum > 0. && dz[i] > 0. ? dz[i] / dzSum : 0.;
 	}
+
+	return( dzSum > 0. );
 }
 
 
@@ -69,6 +69,7 @@
 
 //---------------------------------------------------------
 #include "Flow.h"
+#include "flow_graph.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -97,6 +98,7 @@ protected:
 private:
 
 	bool					Set_Flow		(void);
+	bool					Set_Flow		(const CFlow_Graph &Graph, int Method, double dLinear, CSG_Grid *pLinear_Val, bool bNoNegatives, CSG_Grid *pLoss);
 
 	void					Check_Route		(int x, int y);
 
@@ -108,6 +110,11 @@ private:
 	void					Set_MDInf		(int x, int y);	
 	void					Set_BRM			(int x, int y);
 
+	bool					Get_D8			(int x, int y, double Fraction[8]);
+	bool					Get_DInf		(int x, int y, double Fraction[8]);
+	bool					Get_MFD			(int x, int y, double Fraction[8]);
+	bool					Get_MMDGFD		(int x, int y, double Fraction[8]);
+
 	//-----------------------------------------------------
 	int						BRM_kgexp[8], BRM_idreh[8];
 
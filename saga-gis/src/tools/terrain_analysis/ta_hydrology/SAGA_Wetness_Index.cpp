@@ -197,16 +197,14 @@ bool CSAGA_Wetness_Index::On_Execute(void)
 
 	m_pSlope->Set_Unit(_TL("radians"));
 
-	if( !m_pDEM->Set_Index() )
+	//-----------------------------------------------------
+	if( !Get_Area() )
 	{
-		Error_Set(_TL("index creation failed"));
+		Error_Set(_TL("flow graph creation failed"));
 
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	Get_Area();
-
 	Get_Modified();
 
 	Get_TWI();
@@ -246,74 +244,111 @@ double CSAGA_Wetness_Index::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
 // wird der Winkel (atan(dz / dx)) und nicht das Gefaelle
 // (dz / dx) fuer die Gewichtung der Abfluszanteile benutzt!
 //---------------------------------------------------------
-bool CSAGA_Wetness_Index::Get_Area(void)
+bool CSAGA_Wetness_Index::Get_Fractions(int x, int y, double dz[8])
 {
 	const double MFD_Converge = 1.1;
 
+	double	d, dzSum = 0., z = m_pDEM->asDouble(x, y);
+
+	for(int i=0, ix, iy; i<8; i++)
+	{
+		if( Get_System().Get_Neighbor_Pos(i, x, y, ix, iy) && !m_pDEM->is_NoData(ix, iy) && (d = z - m_pDEM->asDouble(ix, iy)) > 0. )
+		{
+			dzSum	+= (dz[i] = pow(atan(d / Get_Length(i)), MFD_Converge));
+		}
+		else
+		{
+			dz[i]	= 0.;
+		}
+	}
+
+	for(int i=0; i<8; i++)
+	{
+		dz[i]	= dzSum > 0. ? dz[i] / dzSum : 0.;
+	}
+
+	return( dzSum > 0. );
+}
+
+//---------------------------------------------------------
+// Cells are visited along the topological levels of the flow
+// graph, each cell collecting the catchment area and slope
+// sums from its donors, which all belong to lower levels.
+//---------------------------------------------------------
+bool CSAGA_Wetness_Index::Get_Area(void)
+{
+	Process_Set_Text(_TL("flow graph..."));
+
+	CFlow_Graph Graph;
+
+	if( !Graph.Create(m_pDEM) )
+	{
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("catchment area and slope..."));
 
 	m_Suction.Create(Get_System());
-	m_Suction.Assign(0.);
-	m_pArea ->Assign(0.);
-	m_pSlope->Assign(0.);
 
 	CSG_Grid *pWeight = Parameters("WEIGHT")->asGrid();
 
 	double    Suction = Parameters("SUCTION"     )->asDouble();
 	double    wSlope  = Parameters("SLOPE_WEIGHT")->asDouble();
 
-	//-----------------------------------------------------
-	for(sLong n=0; n<Get_NCells() && Set_Progress_Cells(n); n++)
+	#pragma omp parallel for
+	for(sLong n=0; n<Get_NCells(); n++)
 	{
-		int	x, y; m_pDEM->Get_Sorted(n, x, y, true, false);
-
-		if( m_pDEM->is_NoData(x, y) )
+		if( m_pDEM->is_NoData(n) )
 		{
-			m_pArea ->Set_NoData(x, y);
-			m_pSlope->Set_NoData(x, y);
-			m_Suction.Set_NoData(x, y);
+			m_pArea ->Set_NoData(n);
+			m_pSlope->Set_NoData(n);
+			m_Suction.Set_NoData(n);
 		}
-		else
-		{
-			double	Area, Slope, Aspect; m_pDEM->Get_Gradient(x, y, Slope, Aspect);
-
-		//	m_Suction.Set_Value(x, y, pow(1. / Suction, wSlope * Slope * exp(pow(Suction, wSlope * Slope)))); // original formula (boehner & selige 2006) is equivalent to following expression
-			double t = pow(Suction, wSlope * Slope); m_Suction.Set_Value(x, y, pow(1. / t, exp(t)));
-
-			Area	= m_pArea ->asDouble(x, y) + (!pWeight ? 1. : pWeight->is_NoData(x, y) ? 0. : pWeight->asDouble(x, y));
-			Slope	= m_pSlope->asDouble(x, y) + Slope;
+	}
 
-			m_pArea ->Set_Value(x, y, Area);
-			m_pSlope->Set_Value(x, y, Slope / Area);
+	//-----------------------------------------------------
+	for(int iLevel=0; iLevel<Graph.Get_Level_Count() && Set_Progress(iLevel, Graph.Get_Level_Count()); iLevel++)
+	{
+		#pragma omp parallel for
+		for(sLong iCell=Graph.Get_Level_First(iLevel); iCell<Graph.Get_Level_Last(iLevel); iCell++)
+		{
+			int x, y; Graph.Get_Cell(iCell, x, y);
 
-			//---------------------------------------------
-			double	d, dz[8], dzSum = 0., z = m_pDEM->asDouble(x, y);
+			double Area = 0., Slope = 0., Aspect;
 
-			for(int i=0, ix, iy; i<8; i++)
+			for(int i=0; i<8; i++)
 			{
-				if( Get_System().Get_Neighbor_Pos(i, x, y, ix, iy) && !m_pDEM->is_NoData(ix, iy) && (d = z - m_pDEM->asDouble(ix, iy)) > 0. )
-				{
-					dzSum	+= (dz[i] = pow(atan(d / Get_Length(i)), MFD_Converge));
-				}
-				else
+				if( Graph.is_Donor(x, y, i) )
 				{
-					dz[i]	= 0.;
-				}
-			}
+					int ix = Get_xTo(i, x), iy = Get_yTo(i, y); double Fraction[8];
 
-			//---------------------------------------------
-			if( dzSum > 0. )
-			{
-				for(int i=0, ix, iy; i<8; i++)
-				{
-					if( dz[i] > 0. && Get_System().Get_Neighbor_Pos(i, x, y, ix, iy) )
+					if( Get_Fractions(ix, iy, Fraction) && Fraction[(i + 4) % 8] > 0. )
 					{
-						m_pArea ->Add_Value(ix, iy, Area  * dz[i] / dzSum);
-						m_pSlope->Add_Value(ix, iy, Slope * dz[i] / dzSum);
+						double a = Fraction[(i + 4) % 8] * m_pArea->asDouble(ix, iy);
+
+						if( a <= 0. )	// zero weighted donor, its stored slope mean is undefined
+						{
+							continue;
+						}
+
+						Area	+= a;
+						Slope	+= a * m_pSlope->asDouble(ix, iy);	// donor slope is stored as mean, sum = mean * area
 					}
 				}
 			}
+
+			//---------------------------------------------
+			double Local; m_pDEM->Get_Gradient(x, y, Local, Aspect);
+
+		//	m_Suction.Set_Value(x, y, pow(1. / Suction, wSlope * Local * exp(pow(Suction, wSlope * Local)))); // original formula (boehner & selige 2006) is equivalent to following expression
+			double t = pow(Suction, wSlope * Local); m_Suction.Set_Value(x, y, pow(1. / t, exp(t)));
+
+			Area	+= !pWeight ? 1. : pWeight->is_NoData(x, y) ? 0. : pWeight->asDouble(x, y);
+			Slope	+= Local;
+
+			m_pArea ->Set_Value(x, y, Area);
+			m_pSlope->Set_Value(x, y, Area > 0. ? Slope / Area : Local);
 		}
 	}
 
@@ -59,7 +59,7 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#include <saga_api/saga_api.h>
+#include "flow_graph.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -89,6 +89,8 @@ private:
 
 	double					Get_Local_Maximum	(CSG_Grid *pGrid, int x, int y);
 
+	bool					Get_Fractions		(int x, int y, double Fraction[8]);
+
 	bool					Get_Area			(void);
 	bool					Get_Modified		(void);
 	bool					Get_TWI				(void);
@@ -0,0 +1,211 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     ta_hydrology                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    flow_graph.cpp                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "flow_graph.h"
+
+#include <atomic>
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CFlow_Graph::CFlow_Graph(void)
+{
+	m_pDEM = NULL;
+}
+
+//---------------------------------------------------------
+bool CFlow_Graph::Destroy(void)
+{
+	m_pDEM = NULL;
+
+	m_Receivers.Destroy();
+	m_Order    .Destroy();
+	m_Levels   .Destroy();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CFlow_Graph::Create(CSG_Grid *pDEM)
+{
+	Destroy();
+
+	if( !pDEM || !pDEM->is_Valid() )
+	{
+		return( false );
+	}
+
+	const int nx = pDEM->Get_NX(), ny = pDEM->Get_NY();
+
+	if( !m_Receivers.Create(sizeof(BYTE), pDEM->Get_NCells())
+	||  !m_Order.Create(pDEM->Get_NCells() - pDEM->Get_NoData_Count()) )
+	{
+		return( false );
+	}
+
+	BYTE *Receivers = (BYTE *)m_Receivers.Get_Array();
+
+	std::atomic<BYTE> *nDonors = new std::atomic<BYTE>[pDEM->Get_NCells()];	// decremented concurrently while levels are collected
+
+	//-----------------------------------------------------
+	// receivers: all lower neighbours
+
+	#pragma omp parallel for
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++)
+		{
+			BYTE Mask = 0;
+
+			if( !pDEM->is_NoData(x, y) )
+			{
+				double z = pDEM->asDouble(x, y);
+
+				for(int i=0; i<8; i++)
+				{
+					int ix = CSG_Grid_System::Get_xTo(i, x), iy = CSG_Grid_System::Get_yTo(i, y);
+
+					if( pDEM->is_InGrid(ix, iy) && pDEM->asDouble(ix, iy) < z )
+					{
+						Mask |= 1 << i;
+					}
+				}
+			}
+
+			Receivers[(sLong)y * nx + x] = Mask;
+		}
+	}
+
+	//-----------------------------------------------------
+	// donors: number of higher neighbours draining to a cell
+
+	m_pDEM = pDEM;
+
+	#pragma omp parallel for
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++)
+		{
+			BYTE n = 0;
+
+			if( !pDEM->is_NoData(x, y) )
+			{
+				for(int i=0; i<8; i++)
+				{
+					if( is_Donor(x, y, i) )
+					{
+						n++;
+					}
+				}
+			}
+
+			nDonors[(sLong)y * nx + x] = n;
+		}
+	}
+
+	//-----------------------------------------------------
+	// first level: cells without donors
+
+	std::atomic<sLong> nCells(0);
+
+	for(sLong n=0; n<pDEM->Get_NCells(); n++)
+	{
+		if( !pDEM->is_NoData(n) && nDonors[n] == 0 )
+		{
+			m_Order[nCells++] = n;
+		}
+	}
+
+	//-----------------------------------------------------
+	// next levels: cells whose donors all have been visited
+
+	for(sLong First=0, Last=nCells; First<Last; First=Last, Last=nCells)
+	{
+		m_Levels += First;
+
+		#pragma omp parallel for if(Last - First > 1024)
+		for(sLong i=First; i<Last; i++)
+		{
+			sLong n = m_Order[i]; int x = (int)(n % nx), y = (int)(n / nx); BYTE Mask = Receivers[n];
+
+			for(int j=0; Mask; j++, Mask>>=1)
+			{
+				if( Mask & 1 )
+				{
+					sLong k = (sLong)CSG_Grid_System::Get_yTo(j, y) * nx + CSG_Grid_System::Get_xTo(j, x);
+
+					if( nDonors[k].fetch_sub(1) == 1 )	// last donor visited
+					{
+						m_Order[nCells.fetch_add(1)] = k;
+					}
+				}
+			}
+		}
+	}
+
+	delete[](nDonors);
+
+	m_Levels += nCells;
+
+	if( nCells < m_Order.Get_Size() )	// should not happen, flow only goes to lower cells
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
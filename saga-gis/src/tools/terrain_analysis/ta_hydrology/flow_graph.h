@@ -0,0 +1,127 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     ta_hydrology                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     flow_graph.h                      //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__flow_graph_H
+#define HEADER_INCLUDED__flow_graph_H
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The flow graph links each cell of a DEM to its lower
+// neighbours (its potential receivers) and arranges all cells
+// in topological levels: all donors of a cell belong to lower
+// levels than the cell itself. Cells of the same level do not
+// exchange flow and can be processed in parallel. Traversing
+// the levels in ascending order visits each cell after all of
+// its donors (downstream accumulation), in descending order
+// after all of its receivers (upstream propagation).
+//
+// The graph is built without sorting the cells by elevation.
+// Any flow routing that only passes flow to strictly lower
+// neighbours (D8, DInf, MFD and variants) is consistent with
+// the graph. Accumulation is done by 'pulling' the inflow
+// from the donors, so that each thread writes to its own cell
+// only.
+//---------------------------------------------------------
+class CFlow_Graph
+{
+public:
+	CFlow_Graph(void);
+
+	bool					Create				(CSG_Grid *pDEM);
+	bool					Destroy				(void);
+
+	bool					is_Valid			(void)	const	{	return( m_pDEM != NULL );	}
+
+	int						Get_Level_Count		(void)	const	{	return( (int)m_Levels.Get_Size() - 1 );	}
+	sLong					Get_Level_First		(int Level)	const	{	return( m_Levels[Level    ] );	}
+	sLong					Get_Level_Last		(int Level)	const	{	return( m_Levels[Level + 1] );	}
+
+	sLong					Get_Cell_Count		(void)	const	{	return( m_Order.Get_Size() );	}
+	void					Get_Cell			(sLong i, int &x, int &y)	const
+	{
+		sLong n = m_Order[i]; x = (int)(n % m_pDEM->Get_NX()); y = (int)(n / m_pDEM->Get_NX());
+	}
+
+	// bit mask of the lower neighbours of cell (x, y), bit i being set if neighbour i is lower
+	BYTE					Get_Receivers		(int x, int y)	const	{	return( ((BYTE *)m_Receivers.Get_Array())[(sLong)y * m_pDEM->Get_NX() + x] );	}
+
+	// true if the neighbour in direction i is a potential donor of cell (x, y)
+	bool					is_Donor			(int x, int y, int i)	const
+	{
+		int ix = CSG_Grid_System::Get_xTo(i, x), iy = CSG_Grid_System::Get_yTo(i, y);
+
+		return( m_pDEM->is_InGrid(ix, iy) && (Get_Receivers(ix, iy) & (1 << ((i + 4) % 8))) != 0 );
+	}
+
+
+private:
+
+	CSG_Array				m_Receivers;
+
+	CSG_Array_sLong			m_Order, m_Levels;
+
+	CSG_Grid				*m_pDEM;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__flow_graph_H
@@ -335,16 +335,22 @@ bool CHillShade::Get_Shading(bool bDelimit, bool bCombine)
 	double Scale = Parameters("EXAGGERATION")->asDouble();
 
 	//-----------------------------------------------------
+	CSG_Grid_View<double> DEM(m_pDEM, 3), Shade(m_pShade);
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
+		const double *z[3] = { DEM.Get_Row(y - 1), DEM.Get_Row(y), DEM.Get_Row(y + 1) };
+
+		double *pShade = Shade.Get_Row(y, false);
+
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
 		{
 			double Slope, Aspect;
 
-			if( !m_pDEM->Get_Gradient(x, y, Slope, Aspect) )
+			if( !Get_Gradient(DEM, z, x, Slope, Aspect) )
 			{
-				m_pShade->Set_NoData(x, y);
+				pShade[x] = Shade.Get_NoData_Value();
 			}
 			else
 			{
@@ -367,14 +373,47 @@ bool CHillShade::Get_Shading(bool bDelimit, bool bCombine)
 					d *= Slope / M_PI_090;
 				}
 
-				m_pShade->Set_Value(x, y, d);
+				pShade[x] = d;
 			}
 		}
+
+		Shade.Set_Row(y);
 	}
 
 	return( true );
 }
 
+//---------------------------------------------------------
+// Same as CSG_Grid::Get_Gradient(x, y, Slope, Aspect), but
+// operating on the rows y - 1, y and y + 1 of a grid view.
+//---------------------------------------------------------
+bool CHillShade::Get_Gradient(const CSG_Grid_View<double> &DEM, const double *z[3], int x, double &Slope, double &Aspect)
+{
+	#define IS_VALID(row, x)	(row && x >= 0 && x < Get_NX() && !DEM.is_NoData(row[x]))
+
+	if( !IS_VALID(z[1], x) )
+	{
+		return( false );
+	}
+
+	double c = z[1][x], dz[4];
+
+	dz[0] = IS_VALID(z[2], x    ) ? z[2][x    ] - c : IS_VALID(z[0], x    ) ? c - z[0][x    ] : 0.; // north
+	dz[1] = IS_VALID(z[1], x + 1) ? z[1][x + 1] - c : IS_VALID(z[1], x - 1) ? c - z[1][x - 1] : 0.; // east
+	dz[2] = IS_VALID(z[0], x    ) ? z[0][x    ] - c : IS_VALID(z[2], x    ) ? c - z[2][x    ] : 0.; // south
+	dz[3] = IS_VALID(z[1], x - 1) ? z[1][x - 1] - c : IS_VALID(z[1], x + 1) ? c - z[1][x + 1] : 0.; // west
+
+	#undef IS_VALID
+
+	double G = (dz[0] - dz[2]) / (2. * Get_Cellsize());
+	double H = (dz[1] - dz[3]) / (2. * Get_Cellsize());
+
+	Slope  = atan(sqrt(G*G + H*H));
+	Aspect = G != 0. ? M_PI_180 + atan2(H, G) : H > 0. ? M_PI_270 : H < 0. ? M_PI_090 : -1.;
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
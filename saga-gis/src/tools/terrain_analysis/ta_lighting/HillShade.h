@@ -94,6 +94,7 @@ private:
 	bool				Get_Position			(double &Azimuth, double &Decline);
 
 	bool				Get_Shading				(bool bDelimit, bool bCombine);
+	bool				Get_Gradient			(const CSG_Grid_View<double> &DEM, const double *z[3], int x, double &Slope, double &Aspect);
 
 	bool				Get_Shadows				(bool bMask);
 	void				Set_Shadow_Trace		(double x, double y, double z, double dx, double dy, double dz, int Shadowing);
@@ -90,6 +90,7 @@ CSG_String Get_Info(int i)
 #include "topographic_openness.h"
 #include "Visibility_Point.h"
 #include "geomorphons.h"
+#include "horizon_angles.h"
 
 
 //---------------------------------------------------------
@@ -107,9 +108,10 @@ CSG_Tool * Create_Tool(int i)
 	case  5: return( new CTopographic_Openness );
 	case  6: return( new CVisibility_Points );
 	case  8: return( new CGeomorphons );
+	case  9: return( new CHorizon_Angles );
 
 	//-----------------------------------------------------
-	case  9: return( NULL );
+	case 10: return( NULL );
 	default: return( TLB_INTERFACE_SKIP_TOOL );
 	}
 
@@ -47,6 +47,7 @@
 
 //---------------------------------------------------------
 #include "SolarRadiation.h"
+#include "horizon_angles.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -130,14 +131,28 @@ CSolarRadiation::CSolarRadiation(void)
 
 	Parameters.Add_Choice("",
 		"SHADOW"		, _TL("Shadow"),
-		_TL("Choose 'slim' to trace grid node's shadow, 'fat' to trace the whole cell's shadow, or ignore shadowing effects. The first is slightly faster but might show some artifacts."),
-		CSG_String::Format("%s|%s|%s",
+		_TL("Choose 'slim' to trace grid node's shadow, 'fat' to trace the whole cell's shadow, or ignore shadowing effects. The first is slightly faster but might show some artifacts. "
+			"The 'horizon' option calculates the horizon angles for a number of azimuth sectors only once and then looks up the shading for each sun position, which is much faster for longer time periods."),
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("slim"),
 			_TL("fat"),
-			_TL("none")
+			_TL("none"),
+			_TL("horizon")
 		), 1
 	);
 
+	Parameters.Add_Grids("SHADOW",
+		"GRD_HORIZON"	, _TL("Horizon Angles"),
+		_TL("Precomputed horizon angles as created by the 'Horizon Angles' tool. Calculated on the fly if not supplied."),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
+	Parameters.Add_Int("SHADOW",
+		"HORIZON_SECTORS", _TL("Number of Sectors"),
+		_TL("Number of azimuth sectors used to calculate the horizon angles."),
+		36, 4, true
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("",
 		"LOCATION"		, _TL("Location"),
@@ -301,6 +316,12 @@ int CSolarRadiation::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Param
 		pParameters->Set_Enabled("UPDATE_STRETCH", pParameter->asInt() == 2);
 	}
 
+	if(	pParameter->Cmp_Identifier("SHADOW") || pParameter->Cmp_Identifier("GRD_HORIZON") )
+	{
+		pParameters->Set_Enabled("GRD_HORIZON"    , (*pParameters)("SHADOW")->asInt() == 3);
+		pParameters->Set_Enabled("HORIZON_SECTORS", (*pParameters)("SHADOW")->asInt() == 3 && (*pParameters)("GRD_HORIZON")->asGrids() == NULL);
+	}
+
 	if(	pParameter->Cmp_Identifier("LOCATION") )
 	{
 		pParameters->Set_Enabled("LATITUDE"      , pParameter->asInt() == 0);
@@ -399,6 +420,23 @@ bool CSolarRadiation::On_Execute(void)
 		Message_Fmt("\n%s: %f <-> %f", _TL("Latitude" ), M_RAD_TO_DEG * m_Lat.Get_Min(), M_RAD_TO_DEG * m_Lat.Get_Max());
 	}
 
+	//-----------------------------------------------------
+	m_pHorizon = NULL;
+
+	if( Parameters("SHADOW")->asInt() == 3 ) // horizon
+	{
+		if( (m_pHorizon = Parameters("GRD_HORIZON")->asGrids()) == NULL )
+		{
+			SG_RUN_TOOL_ExitOnError("ta_lighting", 9,	// horizon angles
+				   SG_TOOL_PARAMETER_SET("DEM"     , m_pDEM)
+				&& SG_TOOL_PARAMETER_SET("HORIZON" , &m_Horizon)
+				&& SG_TOOL_PARAMETER_SET("NSECTORS", Parameters("HORIZON_SECTORS"))
+			)
+
+			m_pHorizon = &m_Horizon;
+		}
+	}
+
 	//-----------------------------------------------------
 	if( Parameters("GRD_FLAT")->asGrid() )
 	{
@@ -499,6 +537,7 @@ bool CSolarRadiation::Finalize(void)
 	m_Lon        .Destroy();
 	m_Sun_Height .Destroy();
 	m_Sun_Azimuth.Destroy();
+	m_Horizon    .Destroy();
 
 	//-----------------------------------------------------
 	return( true );
@@ -680,9 +719,14 @@ bool CSolarRadiation::Get_Insolation(CSG_DateTime Date, double Hour)
 	{
 		bool bIsDay = false;
 
-		for(int y=0; y<Get_NY() && Process_Get_Okay(); y++)
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
 		{
-			#pragma omp parallel for
+			if( !Process_Get_Okay() )
+			{
+				continue;
+			}
+
 			for(int x=0; x<Get_NX(); x++)
 			{
 				double Sun_Height, Sun_Azimuth;
@@ -733,9 +777,14 @@ bool CSolarRadiation::Get_Insolation(double Sun_Height, double Sun_Azimuth, doub
 
 	double dHour = Parameters("HOUR_STEP")->asDouble();
 
-	for(int y=0; y<Get_NY() && Process_Get_Okay(); y++)
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
 	{
-		#pragma omp parallel for
+		if( !Process_Get_Okay() )
+		{
+			continue;
+		}
+
 		for(int x=0; x<Get_NX(); x++)
 		{
 			if( m_pDEM->is_NoData(x, y) )
@@ -1008,9 +1057,16 @@ bool CSolarRadiation::Get_Slope_Gradient(void)
 	m_Slope .Create(Get_System());
 	m_Aspect.Create(Get_System());
 
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	CSG_Progress Progress(Get_NY());
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int y=0; y<Get_NY(); y++)
 	{
-		#pragma omp parallel for
+		if( !Progress.Step() )
+		{
+			continue;
+		}
+
 		for(int x=0; x<Get_NX(); x++)
 		{
 			double Slope, Aspect;
@@ -1086,6 +1142,12 @@ bool CSolarRadiation::Get_Shade(double Sun_Height, double Sun_Azimuth)
 
 	m_Shade.Assign(0.);
 
+	//-----------------------------------------------------
+	if( Shadowing == 3 ) // horizon
+	{
+		return( Get_Shade_Horizon(Sun_Height, Sun_Azimuth) );
+	}
+
 	//-----------------------------------------------------
 	if( m_Location == 1 ) // variable latitude
 	{
@@ -1117,6 +1179,32 @@ bool CSolarRadiation::Get_Shade(double Sun_Height, double Sun_Azimuth)
 	return( true );
 }
 
+//---------------------------------------------------------
+bool CSolarRadiation::Get_Shade_Horizon(double Sun_Height, double Sun_Azimuth)
+{
+	if( !m_pHorizon )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	{
+		if( !m_pDEM->is_NoData(x, y) )
+		{
+			double Height  = m_Location ? m_Sun_Height .asDouble(x, y) : Sun_Height ;
+			double Azimuth = m_Location ? m_Sun_Azimuth.asDouble(x, y) : Sun_Azimuth, Horizon;
+
+			if( Height > 0. && CHorizon_Angles::Get_Angle(m_pHorizon, x, y, Azimuth, Horizon) && Height < Horizon )
+			{
+				m_Shade.Set_Value(x, y, 1);
+			}
+		}
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 void CSolarRadiation::Set_Shade(double x, double y, double z, double dx, double dy, double dz, int Shadowing)
 {
@@ -92,6 +92,8 @@ private:
 	CSG_Grid				*m_pDEM, *m_pSVF, *m_pLinke, *m_pVapour, *m_pDirect, *m_pDiffus, *m_pTotal, *m_pDuration, *m_pSunrise, *m_pSunset,
 							m_Slope, m_Aspect, m_Shade, m_Lat, m_Lon, m_Sun_Height, m_Sun_Azimuth;
 
+	CSG_Grids				*m_pHorizon, m_Horizon;
+
 
 	bool					Finalize				(void);
 
@@ -111,6 +113,7 @@ private:
 
 	bool					Get_Shade_Direction		(double Sun_Height, double Sun_Azimuth, double &dx, double &dy, double &dz);
 	bool					Get_Shade				(double Sun_Height, double Sun_Azimuth);
+	bool					Get_Shade_Horizon		(double Sun_Height, double Sun_Azimuth);
 	void					Set_Shade				(double x, double y, double z, double dx, double dy, double dz, int Shadowing);
 	void					Set_Shade_Bended		(double x, double y, double z                                 , int Shadowing);
 
@@ -114,6 +114,47 @@ CSolarRadiationYear::CSolarRadiationYear(void)
 		_TL(""),
 		2000
 	);
+
+	Parameters.Add_Choice("",
+		"SHADOW"	, _TL("Shadow"),
+		_TL("Choose 'slim' to trace grid node's shadow, 'fat' to trace the whole cell's shadow, or ignore shadowing effects. "
+			"The 'horizon' option calculates the horizon angles only once and uses these for all time steps, which is much faster."),
+		CSG_String::Format("%s|%s|%s|%s",
+			_TL("slim"),
+			_TL("fat"),
+			_TL("none"),
+			_TL("horizon")
+		), 1
+	);
+
+	Parameters.Add_Grids("SHADOW",
+		"HORIZON"	, _TL("Horizon Angles"),
+		_TL("Precomputed horizon angles as created by the 'Horizon Angles' tool. If not supplied, these are calculated once and used for all time steps."),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
+	Parameters.Add_Int("SHADOW",
+		"HORIZON_SECTORS", _TL("Number of Sectors"),
+		_TL("Number of azimuth sectors used to calculate the horizon angles."),
+		36, 4, true
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CSolarRadiationYear::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
+{
+	if( pParameter->Cmp_Identifier("SHADOW") )
+	{
+		pParameters->Set_Enabled("HORIZON"        , pParameter->asInt() == 3);
+		pParameters->Set_Enabled("HORIZON_SECTORS", pParameter->asInt() == 3);
+	}
+
+	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
 }
 
 
@@ -146,6 +187,22 @@ bool CSolarRadiationYear::On_Execute(void)
 
 	CSG_Grid	Direct(Get_System()), Diffus(Get_System());
 
+	//-----------------------------------------------------
+	int	Shadow	= Parameters("SHADOW")->asInt();
+
+	CSG_Grids	Horizon, *pHorizon	= Parameters("HORIZON")->asGrids();
+
+	if( Shadow == 3 && !pHorizon )
+	{
+		SG_RUN_TOOL_ExitOnError("ta_lighting", 9,	// horizon angles
+			   SG_TOOL_PARAMETER_SET("DEM"     , pDEM)
+			&& SG_TOOL_PARAMETER_SET("HORIZON" , &Horizon)
+			&& SG_TOOL_PARAMETER_SET("NSECTORS", Parameters("HORIZON_SECTORS"))
+		)
+
+		pHorizon	= &Horizon;
+	}
+
 	//-----------------------------------------------------
 	for(int iStep=0; iStep<=nSteps && Process_Get_Okay(); iStep++, Day+=dDays)
 	{
@@ -161,6 +218,8 @@ bool CSolarRadiationYear::On_Execute(void)
 			&&  SG_TOOL_PARAMETER_SET("DAY"       , Day    )
 			&&  SG_TOOL_PARAMETER_SET("HOUR_STEP" , Parameters("HOUR_STEP"))
 			&&  SG_TOOL_PARAMETER_SET("UNITS"     , Parameters("UNITS"    ))
+			&&  SG_TOOL_PARAMETER_SET("SHADOW"    , Shadow )
+			&& (Shadow != 3 || SG_TOOL_PARAMETER_SET("GRD_HORIZON", pHorizon))
 		)
 
 		if( !bResult )
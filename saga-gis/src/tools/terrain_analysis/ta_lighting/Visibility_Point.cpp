@@ -48,6 +48,10 @@
 //---------------------------------------------------------
 #include "Visibility_Point.h"
 
+#include <float.h>
+
+#include <atomic>
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -106,8 +110,6 @@ bool CVisibility::Initialize(const CSG_Parameters &Parameters)
 	m_bDegree       = Parameters("UNIT"      )->asInt () == 1;
 	m_bCumulative   = Parameters("CUMULATIVE")->asBool();
 
-	m_pDEM->Set_Max_Samples(m_pDEM->Get_NCells());	// we use max z (queried by Get_Max()) as a breaking condition in ray tracing
-
 	Reset();
 
 	CSG_Colors Colors; CSG_String Unit;
@@ -169,17 +171,28 @@ bool CVisibility::Finalize(bool bShow)
 
 //---------------------------------------------------------
 bool CVisibility::Reset(void)
+{
+	return( _Reset(m_pVisibility) );
+}
+
+//---------------------------------------------------------
+bool CVisibility::_Reset(CSG_Grid *pVisibility)
 {
 	switch( m_Method )
 	{
-	case  0: m_pVisibility->Assign(      0.); break; // Visibility
-	case  1: m_pVisibility->Assign(M_PI_090); break; // Shade
-	default: m_pVisibility->Assign_NoData( ); break; // Distance, Size
+	case  0: pVisibility->Assign(      0.); break; // Visibility
+	case  1: pVisibility->Assign(M_PI_090); break; // Shade
+	default: pVisibility->Assign_NoData( ); break; // Distance, Size
 	}
 
 	return( true );
 }
 
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
 bool CVisibility::Set_Visibility(int xOrigin, int yOrigin, double Height, bool bReset)
 {
@@ -193,147 +206,355 @@ bool CVisibility::Set_Visibility(int xOrigin, int yOrigin, double Height, bool b
 		Reset();
 	}
 
-	double zOrigin = m_pDEM->asDouble(xOrigin, yOrigin) + Height;
-	double zMax    = m_pDEM->Get_Max();
+	_Set_Viewshed(m_pVisibility, xOrigin, yOrigin, Height, true);
+
+	_Set_NoData();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+#define PARTIAL_BUDGET	((sLong)1024 * N_MEGABYTE_BYTES)	// maximum memory used by the partial result grids of all threads
+
+//---------------------------------------------------------
+/**
+* Processes all observers in parallel. Each thread sweeps its
+* observers into its own partial result grid, the partial
+* results are merged into the visibility grid afterwards.
+* The number of threads is limited, so that the partial grids
+* fit into PARTIAL_BUDGET. If not even two of them fit, the
+* observers are processed one after the other.
+*/
+//---------------------------------------------------------
+bool CVisibility::Set_Visibility(CSG_Shapes *pPoints, int Field, double Height)
+{
+	int nThreads = pPoints->Get_Count() > 1 ? SG_OMP_Get_Max_Num_Threads() : 1;
+
+	if( nThreads > pPoints->Get_Count() )
+	{
+		nThreads = (int)pPoints->Get_Count();
+	}
+
+	sLong nPartials = PARTIAL_BUDGET / (m_pDEM->Get_NCells() * (sLong)sizeof(float));
+
+	if( nThreads > nPartials )
+	{
+		nThreads = nPartials > 1 ? (int)nPartials : 1;
+	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<m_pDEM->Get_NY() && SG_UI_Process_Set_Progress(y, m_pDEM->Get_NY()); y++)
+	CSG_Grid *Partial = nThreads > 1 ? new CSG_Grid[nThreads] : NULL;
+
+	for(int i=0; i<nThreads && Partial; i++)
 	{
-		#ifndef _DEBUG
-		#pragma omp parallel for
-		#endif
-		for(int x=0; x<m_pDEM->Get_NX(); x++)
+		if( !Partial[i].Create(m_pDEM->Get_System(), SG_DATATYPE_Float) )
 		{
-			if( m_pDEM->is_NoData(x, y) )
+			delete[](Partial); Partial = NULL; nThreads = 1; // not enough memory, fall back to one observer at a time
+		}
+		else
+		{
+			_Reset(&Partial[i]);
+		}
+	}
+
+	//-----------------------------------------------------
+	std::atomic<sLong> nProcessed(0); std::atomic<bool> bOkay(true);	// progress is reported by the main thread, all threads stop on cancel
+
+	#pragma omp parallel for schedule(dynamic) num_threads(nThreads) if(Partial != NULL)
+	for(sLong iPoint=0; iPoint<pPoints->Get_Count(); iPoint++)
+	{
+		if( bOkay )
+		{
+			CSG_Shape *pPoint = pPoints->Get_Shape(iPoint);
+
+			int x, y; m_pDEM->Get_System().Get_World_to_Grid(x, y, pPoint->Get_Point());
+
+			if( m_pDEM->is_InGrid(x, y) )
 			{
-				m_pVisibility->Set_NoData(x, y);
+				CSG_Grid *pVisibility = Partial ? &Partial[SG_OMP_Get_Thread_Num()] : m_pVisibility;
+
+				_Set_Viewshed(pVisibility, x, y, Field < 0 ? Height : pPoint->asDouble(Field), Partial == NULL);
 			}
-			else
+
+			sLong n = ++nProcessed;
+
+			if( SG_OMP_Get_Thread_Num() == 0 )
 			{
-				double dx = xOrigin - x;
-				double dy = yOrigin - y;
-				double dz = zOrigin - m_pDEM->asDouble(x, y);
+				SG_UI_Process_Set_Text(CSG_String::Format("%s %lld/%lld", _TL("processing observer"), n, pPoints->Get_Count()));
 
-				//-----------------------------------------
-				if( _Trace_Point(x, y, dx, dy, dz, xOrigin, yOrigin, zMax) )
+				if( !SG_UI_Process_Set_Progress(n, pPoints->Get_Count()) )
 				{
-					switch( m_Method )
-					{
-					default: { // Visibility
-						m_pVisibility->Set_Value(x, y, 1.);
-						break; }
-
-					case  1: { // Shade
-						double dec, azi; const double Exaggeration = 1.;
-
-						if( m_pDEM->Get_Gradient(x, y, dec, azi) )
-						{
-							dec	= M_PI_090 - atan(Exaggeration * tan(dec));
-
-							double decSrc = atan2(dz, sqrt(dx*dx + dy*dy));
-							double aziSrc = atan2(dx, dy);
-
-							double d = acos(sin(dec) * sin(decSrc) + cos(dec) * cos(decSrc) * cos(azi - aziSrc)); if( d > M_PI_090 ) { d = M_PI_090; }
-
-							if( m_pVisibility->asDouble(x, y) > d )
-							{
-								m_pVisibility->Set_Value(x, y, d);
-							}
-						}
-						break; }
-
-					case  2: { // Distance
-						double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
-
-						if( m_pVisibility->is_NoData(x, y) || m_pVisibility->asDouble(x, y) > d )
-						{
-							m_pVisibility->Set_Value(x, y, d);
-						}
-						break; }
-
-					case  3: { // Size
-						double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
-
-						if( d > 0. )
-						{
-							d = atan2(fabs(Height), d); if( m_bDegree ) { d *= M_RAD_TO_DEG; }
-
-							if( m_pVisibility->is_NoData(x, y) || (!m_bCumulative && m_pVisibility->asDouble(x, y) < d) )
-							{
-								m_pVisibility->Set_Value(x, y, d);
-							}
-							else if( m_bCumulative )
-							{
-								m_pVisibility->Add_Value(x, y, d);
-							}
-						}
-						break; }
-					}
+					bOkay = false;
 				}
 			}
 		}
 	}
 
-	return( true );
+	//-----------------------------------------------------
+	if( Partial )
+	{
+		for(int i=0; i<nThreads; i++)
+		{
+			#pragma omp parallel for
+			for(int y=0; y<m_pDEM->Get_NY(); y++) for(int x=0; x<m_pDEM->Get_NX(); x++)
+			{
+				if( !Partial[i].is_NoData(x, y) )
+				{
+					_Add_Value(m_pVisibility, x, y, Partial[i].asDouble(x, y));
+				}
+			}
+		}
+
+		delete[](Partial);
+	}
+
+	_Set_NoData();
+
+	return( bOkay );
 }
 
 //---------------------------------------------------------
-bool CVisibility::_Trace_Point(int x, int y, double dx, double dy, double dz, int xOrigin, int yOrigin, double zMax)
+void CVisibility::_Set_NoData(void)
 {
-	double d = fabs(dx) > fabs(dy) ? fabs(dx) : fabs(dy);
+	#pragma omp parallel for
+	for(int y=0; y<m_pDEM->Get_NY(); y++) for(int x=0; x<m_pDEM->Get_NX(); x++)
+	{
+		if( m_pDEM->is_NoData(x, y) )
+		{
+			m_pVisibility->Set_NoData(x, y);
+		}
+	}
+}
+
 
-	if( d > 0. )
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Cells with the same Chebyshev distance r from the observer
+// form a ring of 8 * r cells, which is indexed clockwise
+// starting at the corner (-r, -r).
+//---------------------------------------------------------
+inline int CVisibility::_Get_Ring_Index(int r, int dx, int dy)
+{
+	if( dy == -r && dx <  r ) { return(         dx + r ); }
+	if( dx ==  r && dy <  r ) { return( 2 * r + dy + r ); }
+	if( dy ==  r && dx > -r ) { return( 4 * r + r - dx ); }
+
+	return( 6 * r + r - dy );
+}
+
+//---------------------------------------------------------
+inline void CVisibility::_Get_Ring_Cell(int r, int i, int &dx, int &dy)
+{
+	switch( i / (2 * r) )
 	{
-		double dist = sqrt(dx*dx + dy*dy);
+	case  0: dx = i         - r; dy =    -r; break;
+	case  1: dx =    r; dy = i - 2 * r - r ; break;
+	case  2: dx = 5 * r - i    ; dy =     r; break;
+	default: dx =   -r; dy = 7 * r - i     ; break;
+	}
+}
+
+//---------------------------------------------------------
+// Finite markers for ring cells without a slope, either because
+// nothing has been seen yet along the line of sight (outside of
+// the grid, transparent no-data) or because no-data blocks it.
+//---------------------------------------------------------
+static const double	HORIZON_NONE	= -DBL_MAX;
+static const double	HORIZON_BLOCKED	=  DBL_MAX;
+
+#define is_Horizon(h)	((h) > HORIZON_NONE && (h) < HORIZON_BLOCKED)
 
-		dx /= d; dy /= d; dz /= d; d = dist / d;
+//---------------------------------------------------------
+// Returns the horizon, i.e. the steepest slope seen from the
+// observer, at the position where the line of sight to cell
+// (dx, dy) on ring r crosses the inner ring r - 1. The value
+// is linearly interpolated between the two adjacent cells of
+// the inner ring (XDraw). Markers are never interpolated, if
+// only one of both cells has a slope it is taken as it is,
+// so that single no-data cells do not widen with distance.
+//---------------------------------------------------------
+inline double CVisibility::_Get_Horizon(const double *Horizon, int r, int dx, int dy)
+{
+	int q = r - 1; double d = (double)q / (double)r;
+
+	if( abs(dx) == r && abs(dy) == r ) // diagonal
+	{
+		return( Horizon[_Get_Ring_Index(q, dx < 0 ? -q : q, dy < 0 ? -q : q)] );
+	}
 
-		double id = 0.;
-		double ix = 0.5 + x;
-		double iy = 0.5 + y;
-		double iz = m_pDEM->asDouble(x, y);
+	int i, j; double w;
 
-		while( id < dist )
+	if( abs(dx) == r )
+	{
+		double c = d * dy; int iy = (int)floor(c); w = c - iy; dx = dx < 0 ? -q : q;
+
+		i = _Get_Ring_Index(q, dx, iy); j = w > 0. ? _Get_Ring_Index(q, dx, iy + 1) : i;
+	}
+	else
+	{
+		double c = d * dx; int ix = (int)floor(c); w = c - ix; dy = dy < 0 ? -q : q;
+
+		i = _Get_Ring_Index(q, ix, dy); j = w > 0. ? _Get_Ring_Index(q, ix + 1, dy) : i;
+	}
+
+	if( i == j || Horizon[i] == Horizon[j] )
+	{
+		return( Horizon[i] );
+	}
+
+	if( !is_Horizon(Horizon[i]) || !is_Horizon(Horizon[j]) )
+	{
+		if( is_Horizon(Horizon[i]) ) { return( Horizon[i] ); }
+		if( is_Horizon(Horizon[j]) ) { return( Horizon[j] ); }
+
+		return( Horizon[w < 0.5 ? i : j] );	// both are markers, take the nearer one
+	}
+
+	return( Horizon[i] + w * (Horizon[j] - Horizon[i]) );
+}
+
+//---------------------------------------------------------
+/**
+* Viewshed for a single observer, computed by sweeping
+* concentric rings outwards from the observer's cell. For each
+* ring the horizon (the steepest slope seen so far along the
+* line of sight) is interpolated from the previous ring, so
+* only two rings have to be kept in memory and each cell is
+* visited once. The cells of one ring are independent from
+* each other and can be processed in parallel.
+*/
+//---------------------------------------------------------
+bool CVisibility::_Set_Viewshed(CSG_Grid *pVisibility, int xOrigin, int yOrigin, double Height, bool bParallel)
+{
+	double zOrigin = m_pDEM->asDouble(xOrigin, yOrigin) + Height;
+
+	int rMax = M_GET_MAX(M_GET_MAX(xOrigin, m_pDEM->Get_NX() - 1 - xOrigin), M_GET_MAX(yOrigin, m_pDEM->Get_NY() - 1 - yOrigin));
+
+	CSG_Vector Rings[2]; Rings[0].Create(8 * rMax + 8); Rings[1].Create(8 * rMax + 8);
+
+	_Set_Value(pVisibility, xOrigin, yOrigin, 0., 0., Height, Height);
+
+	//-----------------------------------------------------
+	for(int r=1; r<=rMax; r++)
+	{
+		if( bParallel && !SG_UI_Process_Set_Progress(r, rMax) )
 		{
-			id += d;
-			ix += dx;
-			iy += dy;
-			iz += dz;
+			return( false );
+		}
+
+		const double *Inner = Rings[(r - 1) % 2].Get_Data(); double *Outer = Rings[r % 2].Get_Data();
 
-			x   = (int)ix;
-			y   = (int)iy;
+		#pragma omp parallel for if(bParallel && r > 128)
+		for(int i=0; i<8*r; i++)
+		{
+			int dx, dy; _Get_Ring_Cell(r, i, dx, dy); int x = xOrigin + dx, y = yOrigin + dy;
 
-			if( !m_pDEM->is_InGrid(x, y) )
+			if( !m_pDEM->Get_System().is_InGrid(x, y) ) // never on the line of sight to a cell inside the grid
 			{
-				if( !m_bIgnoreNoData || !m_pDEM->Get_System().is_InGrid(x, y) )
-				{
-					return( false );
-				}
+				Outer[i] = HORIZON_NONE; continue;
+			}
+
+			double Horizon = r > 1 ? _Get_Horizon(Inner, r, dx, dy) : HORIZON_NONE;
+
+			if( m_pDEM->is_NoData(x, y) )
+			{
+				Outer[i] = m_bIgnoreNoData ? Horizon : HORIZON_BLOCKED; // no-data either is transparent or blocks the view
 			}
 			else
 			{
-				if( iz < m_pDEM->asDouble(x, y) )
+				double dz = zOrigin - m_pDEM->asDouble(x, y), Slope = -dz / sqrt((double)(dx*dx + dy*dy));
+
+				if( Slope >= Horizon )
 				{
-					return( false );
+					Outer[i] = Slope; _Set_Value(pVisibility, x, y, -dx, -dy, dz, Height);
 				}
-
-				if( iz > zMax )
+				else
 				{
-					return( true );
+					Outer[i] = Horizon;
 				}
 			}
+		}
+	}
 
-			if (x == xOrigin && y == yOrigin)
-			{
-				// because of floating point precision issues the check "id < dist" can fail on
-				// the observer cell and we move on into another cell, so check this explictly
+	return( true );
+}
 
-				break;
-			}
+//---------------------------------------------------------
+void CVisibility::_Set_Value(CSG_Grid *pVisibility, int x, int y, double dx, double dy, double dz, double Height)
+{
+	switch( m_Method )
+	{
+	default: { // Visibility
+		_Add_Value(pVisibility, x, y, 1.);
+		break; }
+
+	case  1: { // Shade
+		double dec, azi; const double Exaggeration = 1.;
+
+		if( m_pDEM->Get_Gradient(x, y, dec, azi) )
+		{
+			dec	= M_PI_090 - atan(Exaggeration * tan(dec));
+
+			double decSrc = atan2(dz, sqrt(dx*dx + dy*dy));
+			double aziSrc = atan2(dx, dy);
+
+			double d = acos(sin(dec) * sin(decSrc) + cos(dec) * cos(decSrc) * cos(azi - aziSrc)); if( d > M_PI_090 ) { d = M_PI_090; }
+
+			_Add_Value(pVisibility, x, y, d);
+		}
+		break; }
+
+	case  2: { // Distance
+		_Add_Value(pVisibility, x, y, m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy));
+		break; }
+
+	case  3: { // Size
+		double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
+
+		if( d > 0. )
+		{
+			d = atan2(fabs(Height), d); if( m_bDegree ) { d *= M_RAD_TO_DEG; }
+
+			_Add_Value(pVisibility, x, y, d);
 		}
+		break; }
 	}
+}
 
-	return( true );
+//---------------------------------------------------------
+void CVisibility::_Add_Value(CSG_Grid *pVisibility, int x, int y, double d)
+{
+	switch( m_Method )
+	{
+	default: // Visibility
+		if( d > 0. )
+		{
+			pVisibility->Set_Value(x, y, 1.);
+		}
+		break;
+
+	case  1: // Shade
+	case  2: // Distance
+		if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) > d )
+		{
+			pVisibility->Set_Value(x, y, d);
+		}
+		break;
+
+	case  3: // Size
+		if( pVisibility->is_NoData(x, y) || (!m_bCumulative && pVisibility->asDouble(x, y) < d) )
+		{
+			pVisibility->Set_Value(x, y, d);
+		}
+		else if( m_bCumulative )
+		{
+			pVisibility->Add_Value(x, y, d);
+		}
+		break;
+	}
 }
 
 
@@ -469,16 +690,7 @@ bool CVisibility_Points::On_Execute(void)
 	double Height = Parameters("HEIGHT")->asDouble();
 
 	//-----------------------------------------------------
-	for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Process_Get_Okay(); iPoint++)
-	{
-		Process_Set_Text("%s %lld...", _TL("processing observer"), 1 + iPoint);
-
-		CSG_Shape &Point = *pPoints->Get_Shape(iPoint);
-
-		int x, y; Get_System().Get_World_to_Grid(x, y, Point.Get_Point());
-
-		Set_Visibility(x, y, Field < 0 ? Height : Point.asDouble(Field), false);
-	}
+	Set_Visibility(pPoints, Field, Height);
 
 	//-----------------------------------------------------
 	Finalize(false);
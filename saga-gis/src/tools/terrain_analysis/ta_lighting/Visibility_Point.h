@@ -79,6 +79,7 @@ protected:
 	bool					Reset					(void);
 
 	bool					Set_Visibility			(int x, int y, double Height, bool bReset);
+	bool					Set_Visibility			(CSG_Shapes *pPoints, int Field, double Height);
 
 
 private:
@@ -90,7 +91,16 @@ private:
 	CSG_Grid				*m_pDEM, *m_pVisibility;
 
 
-	bool					_Trace_Point			(int x, int y, double dx, double dy, double dz, int xOrigin, int yOrigin, double zMax);
+	bool					_Reset					(CSG_Grid *pVisibility);
+	void					_Set_NoData				(void);
+
+	int						_Get_Ring_Index			(int r, int  dx, int  dy);
+	void					_Get_Ring_Cell			(int r, int i, int &dx, int &dy);
+	double					_Get_Horizon			(const double *Horizon, int r, int dx, int dy);
+
+	bool					_Set_Viewshed			(CSG_Grid *pVisibility, int xOrigin, int yOrigin, double Height, bool bParallel);
+	void					_Set_Value				(CSG_Grid *pVisibility, int x, int y, double dx, double dy, double dz, double Height);
+	void					_Add_Value				(CSG_Grid *pVisibility, int x, int y, double d);
 
 };
 
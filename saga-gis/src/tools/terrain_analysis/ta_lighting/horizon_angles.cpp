@@ -0,0 +1,262 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                      ta_lighting                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   horizon_angles.cpp                  //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "horizon_angles.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CHorizon_Angles::CHorizon_Angles(void)
+{
+	Set_Name		(_TL("Horizon Angles"));
+
+	Set_Author		("SAGA User Group Association (c) 2026");
+
+	Set_Description	(_TW(
+		"Calculates for each cell the elevation angle of the horizon in a given number "
+		"of evenly distributed azimuth sectors. The horizon of all cells in one direction "
+		"is found with a single sweep along parallel lines, maintaining the upper convex hull "
+		"of the terrain profile, so that each cell is visited only once per direction. "
+		"The resulting grid collection can be supplied to the insolation tools, which then "
+		"only need to look up the horizon for a sun position instead of tracing shadows. "
+		"Cells without terrain in a given direction, i.e. at the grid's border, are marked as no-data. "
+	));
+
+	Add_Reference("Dozier, J. / Frew, J.", "1990",
+		"Rapid calculation of terrain parameters for radiation modeling from digital elevation data",
+		"IEEE Transactions on Geoscience and Remote Sensing, 28(5), 963-969."
+	);
+
+	//-----------------------------------------------------
+	Parameters.Add_Grid("",
+		"DEM"		, _TL("Elevation"),
+		_TL(""),
+		PARAMETER_INPUT
+	);
+
+	Parameters.Add_Grids("",
+		"HORIZON"	, _TL("Horizon Angles"),
+		_TL("Horizon elevation angles [radians], one grid for each sector."),
+		PARAMETER_OUTPUT
+	);
+
+	Parameters.Add_Int("",
+		"NSECTORS"	, _TL("Number of Sectors"),
+		_TL("Number of azimuth sectors, the first one pointing to the North."),
+		36, 4, true
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CHorizon_Angles::On_Execute(void)
+{
+	CSG_Grid *pDEM = Parameters("DEM")->asGrid();
+
+	CSG_Grids *pHorizon = Parameters("HORIZON")->asGrids();
+
+	int nSectors = Parameters("NSECTORS")->asInt();
+
+	if( !pHorizon->Create(Get_System(), 0, 0., SG_DATATYPE_Float) )
+	{
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	pHorizon->Set_Name(CSG_String::Format("%s [%s]", pDEM->Get_Name(), _TL("Horizon")));
+	pHorizon->Set_Unit(_TL("radians"));
+
+	pHorizon->Get_Attributes_Ptr()->Set_Field_Name(0, _TL("Azimuth"));
+
+	//-----------------------------------------------------
+	for(int i=0; i<nSectors && Set_Progress(i, nSectors); i++)
+	{
+		if( !pHorizon->Add_Grid(360. * i / nSectors) )
+		{
+			Error_Set(_TL("failed to allocate memory"));
+
+			return( false );
+		}
+
+		Get_Horizon(pDEM, M_PI_360 * i / nSectors, pHorizon->Get_Grid_Ptr(i));
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Calculates the horizon angle in direction of Azimuth (radians,
+* clockwise from North) for all cells of pDEM. The grid is swept
+* with parallel lines running in azimuth direction, starting at
+* the far end of each line. The upper convex hull of the profile
+* seen so far is kept on a stack, the top of which is the horizon
+* of the current cell once hidden points have been popped. If
+* bLower is true, the lowest angle is returned instead.
+*/
+//---------------------------------------------------------
+bool CHorizon_Angles::Get_Horizon(CSG_Grid *pDEM, double Azimuth, CSG_Grid *pHorizon, bool bLower)
+{
+	if( !pDEM || !pHorizon || pHorizon->Get_NX() != pDEM->Get_NX() || pHorizon->Get_NY() != pDEM->Get_NY() )
+	{
+		return( false );
+	}
+
+	double dx = sin(Azimuth), dy = cos(Azimuth); bool bX = fabs(dx) >= fabs(dy);
+
+	int nMajor = bX ? pDEM->Get_NX() : pDEM->Get_NY();	// lines advance one cell per step along the major axis...
+	int nMinor = bX ? pDEM->Get_NY() : pDEM->Get_NX();
+	double   m = bX ? dy / dx : dx / dy;				// ...and m cells (|m| <= 1) along the minor axis
+	int   Step = (bX ? dx : dy) > 0. ? 1 : -1;
+	double  dt = Step * pDEM->Get_Cellsize() * sqrt(1. + m*m), zScale = bLower ? -1. : 1.;
+
+	int oMin = M_GET_MIN(0, (int)floor(m * (nMajor - 1) + 0.5));
+	int oMax = M_GET_MAX(0, (int)floor(m * (nMajor - 1) + 0.5));
+
+	//-----------------------------------------------------
+	#pragma omp parallel for schedule(dynamic, 16)
+	for(int c=-oMax; c<nMinor-oMin; c++)
+	{
+		CSG_Vector T(nMajor), Z(nMajor); int n = 0;
+
+		for(int k=0; k<nMajor; k++)
+		{
+			int i = Step > 0 ? nMajor - 1 - k : k, j = c + (int)floor(m * i + 0.5);
+
+			if( j < 0 || j >= nMinor )
+			{
+				continue;
+			}
+
+			int x = bX ? i : j, y = bX ? j : i;
+
+			if( pDEM->is_NoData(x, y) )
+			{
+				pHorizon->Set_NoData(x, y); continue;
+			}
+
+			double t = i * dt, z = zScale * pDEM->asDouble(x, y);
+
+			while( n >= 2 && (Z[n - 1] - z) / (T[n - 1] - t) <= (Z[n - 2] - z) / (T[n - 2] - t) )
+			{
+				n--;	// hidden behind the next point of the hull
+			}
+
+			if( n > 0 )
+			{
+				pHorizon->Set_Value(x, y, zScale * atan((Z[n - 1] - z) / (T[n - 1] - t)));
+			}
+			else
+			{
+				pHorizon->Set_NoData(x, y);
+			}
+
+			T[n] = t; Z[n] = z; n++;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Looks up the horizon angle for the given Azimuth (radians) by
+* linear interpolation between the two adjacent sectors of a
+* horizon collection created with this tool.
+*/
+//---------------------------------------------------------
+bool CHorizon_Angles::Get_Angle(const CSG_Grids *pHorizon, int x, int y, double Azimuth, double &Angle)
+{
+	int n = pHorizon->Get_NZ();
+
+	if( n < 1 || !pHorizon->Get_System().is_InGrid(x, y) )
+	{
+		return( false );
+	}
+
+	double d = fmod(Azimuth / M_PI_360, 1.); if( d < 0. ) { d += 1.; } d *= n;
+
+	int i = (int)d % n, j = (i + 1) % n; d -= floor(d);
+
+	CSG_Grid *pA = pHorizon->Get_Grid_Ptr(i), *pB = pHorizon->Get_Grid_Ptr(j);
+
+	if( pA->is_NoData(x, y) )
+	{
+		if( pB->is_NoData(x, y) )
+		{
+			return( false );
+		}
+
+		Angle = pB->asDouble(x, y);
+	}
+	else if( pB->is_NoData(x, y) )
+	{
+		Angle = pA->asDouble(x, y);
+	}
+	else
+	{
+		Angle = pA->asDouble(x, y) + d * (pB->asDouble(x, y) - pA->asDouble(x, y));
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
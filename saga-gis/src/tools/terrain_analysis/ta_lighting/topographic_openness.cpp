@@ -47,6 +47,7 @@
 
 //---------------------------------------------------------
 #include "topographic_openness.h"
+#include "horizon_angles.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -107,7 +108,7 @@ CTopographic_Openness::CTopographic_Openness(void)
 
 	Parameters.Add_Double("",
 		"RADIUS"	, _TL("Radial Limit"),
-		_TL("Maximum search distance [map units]."),
+		_TL("Maximum search distance [map units]. Not used by the horizon sweep method, which always takes the whole grid into account."),
 		10000., 0., true
 	);
 
@@ -135,9 +136,10 @@ CTopographic_Openness::CTopographic_Openness(void)
 	Parameters.Add_Choice("",
 		"METHOD"	, _TL("Method"),
 		_TL(""),
-		CSG_String::Format("%s|%s",
+		CSG_String::Format("%s|%s|%s",
 			_TL("multi scale"),
-			_TL("line tracing")
+			_TL("line tracing"),
+			_TL("horizon sweep")
 		), 1
 	);
 
@@ -237,7 +239,11 @@ bool CTopographic_Openness::On_Execute(void)
 	//-----------------------------------------------------
 	bool	bResult	= Initialise();
 
-	if( bResult )
+	if( bResult && m_Method == 2 )	// horizon sweep
+	{
+		bResult	= Get_Openness(pPos, pNeg);
+	}
+	else if( bResult )
 	{
 		for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 		{
@@ -317,6 +323,71 @@ bool CTopographic_Openness::Initialise(void)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+bool CTopographic_Openness::Get_Openness(CSG_Grid *pPos, CSG_Grid *pNeg)
+{
+	bool	bPlane	= Parameters("NADIR")->asBool() == false;
+	bool	bDegree	= Parameters("UNIT" )->asInt() == 1;
+
+	CSG_Grid	Pos(Get_System(), SG_DATATYPE_Float), Neg(Get_System(), SG_DATATYPE_Float), Horizon(Get_System(), SG_DATATYPE_Float);
+
+	Pos.Assign(0.);
+	Neg.Assign(0.);
+
+	//-----------------------------------------------------
+	for(sLong i=0; i<m_Direction.Get_Count() && Set_Progress(i, m_Direction.Get_Count()); i++)
+	{
+		CHorizon_Angles::Get_Horizon(m_pDEM, m_Direction[i].z, &Horizon, false);
+
+		#pragma omp parallel for	// no horizon means no terrain in this direction (grid edge), i.e. no obstruction
+		for(sLong n=0; n<Get_NCells(); n++)
+		{
+			if( !m_pDEM->is_NoData(n) )	Pos.Add_Value(n, M_PI_090 - (Horizon.is_NoData(n) ? 0. : Horizon.asDouble(n)));
+		}
+
+		CHorizon_Angles::Get_Horizon(m_pDEM, m_Direction[i].z, &Horizon, true);
+
+		#pragma omp parallel for
+		for(sLong n=0; n<Get_NCells(); n++)
+		{
+			if( !m_pDEM->is_NoData(n) )	Neg.Add_Value(n, M_PI_090 + (Horizon.is_NoData(n) ? 0. : Horizon.asDouble(n)));
+		}
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(sLong n=0; n<Get_NCells(); n++)
+	{
+		if( !m_pDEM->is_NoData(n) )
+		{
+			double	p	= Pos.asDouble(n) / m_Direction.Get_Count();
+			double	q	= Neg.asDouble(n) / m_Direction.Get_Count();
+
+			if( bPlane )
+			{
+				p	= M_PI_090 - p;
+				q	= M_PI_090 - q;
+			}
+
+			if( bDegree )
+			{
+				p	*= M_RAD_TO_DEG;
+				q	*= M_RAD_TO_DEG;
+			}
+
+			if( pPos )	pPos->Set_Value(n, p);
+			if( pNeg )	pNeg->Set_Value(n, q);
+		}
+		else
+		{
+			if( pPos )	pPos->Set_NoData(n);
+			if( pNeg )	pNeg->Set_NoData(n);
+		}
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool CTopographic_Openness::Get_Openness(int x, int y, double &Pos, double &Neg)
 {
@@ -95,6 +95,7 @@ private:
 
 	bool					Initialise				(void);
 
+	bool					Get_Openness			(CSG_Grid *pPos, CSG_Grid *pNeg);
 	bool					Get_Openness			(int x, int y, double &Pos, double &Neg);
 
 	bool					Get_Angles_Multi_Scale	(int x, int y, CSG_Vector &Max, CSG_Vector &Min);